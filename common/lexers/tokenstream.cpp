@@ -165,6 +165,18 @@ namespace embree
       cin->drop();
   }
 
+  std::string TokenStream::getWord(const std::string& terminators)
+  {
+    Token token;
+    skipSeparators();
+    if (tryString(token,cin->loc())) return token.String();
+
+    std::string str;
+    while (cin->peek() != EOF && !isSeparator(cin->peek()) && terminators.find((char)cin->peek()) == std::string::npos)
+      str += (char)cin->get();
+    return str;
+  }
+
   Token TokenStream::next()
   {
     Token token;
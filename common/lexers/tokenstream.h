@@ -132,6 +132,9 @@ namespace embree
     Token next();
     bool trySymbol(const std::string& symbol);
 
+    /*! reads a quoted string or all characters up to the next separator or terminator, e.g. to parse file names */
+    std::string getWord(const std::string& terminators);
+
   private:
     void skipSeparators();
     bool decDigits(std::string& str);
@@ -0,0 +1,148 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mapped_file.h"
+
+namespace embree
+{
+  MappedFile::MappedFile ()
+    : opened(false), ptr(nullptr), bytes(0), handle(nullptr) {}
+
+  MappedFile::MappedFile (const FileName& fileName)
+    : opened(false), ptr(nullptr), bytes(0), handle(nullptr)
+  {
+    if (!open(fileName))
+      THROW_RUNTIME_ERROR("cannot open file "+fileName.str());
+  }
+
+  MappedFile::~MappedFile () {
+    close();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Windows Platform
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__WIN32__)
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+namespace embree
+{
+  bool MappedFile::open (const FileName& fileName)
+  {
+    close();
+
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+      CloseHandle(file);
+      return false;
+    }
+    bytes = (size_t) fileSize.QuadPart;
+
+    /* empty files cannot get mapped */
+    if (bytes != 0)
+    {
+      HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping) {
+        ptr = (const char*) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+      }
+      if (!ptr) {
+        CloseHandle(file);
+        bytes = 0;
+        return false;
+      }
+    }
+
+    handle = (void*) file;
+    opened = true;
+    return true;
+  }
+
+  void MappedFile::close ()
+  {
+    if (ptr) UnmapViewOfFile(ptr);
+    if (handle) CloseHandle((HANDLE)handle);
+    opened = false;
+    ptr = nullptr;
+    bytes = 0;
+    handle = nullptr;
+  }
+
+  void MappedFile::prefetch (size_t ofs, size_t num) const {
+    /* pages get read on demand */
+  }
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unix Platform
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__UNIX__)
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace embree
+{
+  bool MappedFile::open (const FileName& fileName)
+  {
+    close();
+
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+      ::close(fd);
+      return false;
+    }
+    bytes = (size_t) st.st_size;
+
+    /* empty files cannot get mapped */
+    if (bytes != 0)
+    {
+      void* p = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        ::close(fd);
+        bytes = 0;
+        return false;
+      }
+      ptr = (const char*) p;
+    }
+
+    /* the mapping stays valid after closing the file descriptor */
+    ::close(fd);
+    opened = true;
+    return true;
+  }
+
+  void MappedFile::close ()
+  {
+    if (ptr) munmap((void*)ptr, bytes);
+    opened = false;
+    ptr = nullptr;
+    bytes = 0;
+  }
+
+  void MappedFile::prefetch (size_t ofs, size_t num) const
+  {
+    if (!ptr || ofs >= bytes) return;
+    num = std::min(num, bytes-ofs);
+
+    /* madvise requires a page aligned start address */
+    const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    const size_t begin = ofs & ~(pageSize-1);
+    madvise((void*)(ptr+begin), ofs+num-begin, MADV_WILLNEED);
+  }
+}
+#endif
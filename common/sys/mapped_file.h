@@ -0,0 +1,55 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "platform.h"
+#include "filename.h"
+
+namespace embree
+{
+  /*! read only memory mapping of a file */
+  class MappedFile
+  {
+  public:
+
+    /*! creates a closed mapping */
+    MappedFile ();
+
+    /*! maps the file, throws if the file cannot get opened */
+    MappedFile (const FileName& fileName);
+
+    /*! unmaps the file */
+    ~MappedFile ();
+
+  private:
+    MappedFile (const MappedFile& other) DELETED; // do not implement
+    MappedFile& operator= (const MappedFile& other) DELETED; // do not implement
+
+  public:
+
+    /*! maps the file, returns false if the file cannot get opened */
+    bool open (const FileName& fileName);
+
+    /*! unmaps the file */
+    void close ();
+
+    /*! returns true if a file is mapped */
+    __forceinline bool isOpen() const { return opened; }
+
+    /*! returns pointer to the mapped file content */
+    __forceinline const char* data() const { return ptr; }
+
+    /*! returns the size of the mapped file in bytes */
+    __forceinline size_t size() const { return bytes; }
+
+    /*! asks the operating system to asynchronously read the specified byte range from disk */
+    void prefetch (size_t ofs, size_t num) const;
+
+  private:
+    bool opened;
+    const char* ptr;
+    size_t bytes;
+    void* handle;
+  };
+}
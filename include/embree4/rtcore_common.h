@@ -303,6 +303,7 @@ enum RTCRayQueryFlags
   /* matching intel_ray_flags_t layout */
   RTC_RAY_QUERY_FLAG_NONE       = 0,
   RTC_RAY_QUERY_FLAG_INVOKE_ARGUMENT_FILTER = (1 << 1), // enable argument filter for each geometry
+  RTC_RAY_QUERY_FLAG_CULL_BACKFACES = (1 << 4), // back facing triangles and quads do not produce a hit
 
   /* embree specific flags */
   RTC_RAY_QUERY_FLAG_INCOHERENT = (0 << 16), // optimize for incoherent rays
@@ -473,6 +474,31 @@ struct RTC_ALIGN(16) RTCPointQueryFunctionArguments
 
 typedef bool (*RTCPointQueryFunction)(struct RTCPointQueryFunctionArguments* args);
 
+/*
+ * Offsets a hit point p along the geometry normal Ng to obtain the origin of
+ * a secondary ray that does not self intersect the hit surface. The offset
+ * is proportional to the floating point error of p, by shifting the integer
+ * representation of p for large coordinates and by a small absolute offset
+ * close to zero. The ray leaves on the side of the normal, thus to spawn a
+ * transmitted ray pass the negated normal.
+ */
+RTC_FORCEINLINE void rtcOffsetRayOrigin(const float p[3], const float Ng[3], float org[3])
+{
+  const float origin = 1.0f / 32.0f;
+  const float floatScale = 1.0f / 65536.0f;
+  const float intScale = 256.0f;
+  unsigned int k = 0;
+
+  for (; k < 3; k++)
+  {
+    union { float f; int i; } u;
+    const int ofi = (int)(intScale * Ng[k]);
+    u.f = p[k];
+    u.i += (p[k] < 0.0f) ? -ofi : ofi;
+    org[k] = (p[k] < origin && p[k] > -origin) ? p[k] + floatScale * Ng[k] : u.f;
+  }
+}
+
 #if defined(EMBREE_SYCL_SUPPORT) && defined(SYCL_LANGUAGE_VERSION)
 
 /* returns function pointer to be usable in SYCL kernel */
@@ -66,7 +66,14 @@ enum RTCDeviceProperty
 
   RTC_DEVICE_PROPERTY_TASKING_SYSTEM        = 128,
   RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED = 129,
-  RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED = 130
+  RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED = 130,
+
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE      = 160,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS      = 161,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES    = 162,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS = 163,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES   = 164,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_RESIZES   = 165
 };
 
 /* Gets a device property. */
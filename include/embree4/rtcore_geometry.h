@@ -164,6 +164,9 @@ RTC_API void rtcSetGeometryBuildQuality(RTCGeometry geometry, enum RTCBuildQuali
 /* Sets the maximal curve or point radius scale allowed by min-width feature. */
 RTC_API void rtcSetGeometryMaxRadiusScale(RTCGeometry geometry, float maxRadiusScale);
 
+/* Sets the maximal number of sub-segments the builder may split each curve segment into. */
+RTC_API void rtcSetGeometryMaxSubsegments(RTCGeometry geometry, unsigned int maxSubsegments);
+
 
 /* Sets a geometry buffer. */
 RTC_API void rtcSetGeometryBuffer(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot, enum RTCFormat format, RTCBuffer buffer, size_t byteOffset, size_t byteStride, size_t itemCount);
@@ -229,6 +232,9 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry geometry, unsigned int timeStep
 /* Sets the transformation quaternion of an instance for the specified time step. */
 RTC_API void rtcSetGeometryTransformQuaternion(RTCGeometry geometry, unsigned int timeStep, const struct RTCQuaternionDecomposition* qd);
 
+/* Sets a double precision world space origin of an instance that is added to the transformation of all time steps. */
+RTC_API void rtcSetGeometryTransformOrigin(RTCGeometry geometry, double x, double y, double z);
+
 /* Returns the interpolated transformation of an instance for the specified time. */
 RTC_API void rtcGetGeometryTransform(RTCGeometry geometry, float time, enum RTCFormat format, void* xfm);
 
@@ -242,6 +248,9 @@ RTC_API void rtcGetGeometryTransformEx(RTCGeometry geometry, unsigned int instPr
 /* Sets the uniform tessellation rate of the geometry. */
 RTC_API void rtcSetGeometryTessellationRate(RTCGeometry geometry, float tessellationRate);
 
+/* Sets a view to calculate the tessellation levels of a subdivision geometry from the projected edge length. */
+RTC_API void rtcSetGeometryTessellationView(RTCGeometry geometry, const float* xfm, float width, float height, float tessellationRate);
+
 /* Sets the number of topologies of a subdivision surface. */
 RTC_API void rtcSetGeometryTopologyCount(RTCGeometry geometry, unsigned int topologyCount);
 
@@ -254,6 +263,9 @@ RTC_API void rtcSetGeometryVertexAttributeTopology(RTCGeometry geometry, unsigne
 /* Sets the displacement callback function of a subdivision surface. */
 RTC_API void rtcSetGeometryDisplacementFunction(RTCGeometry geometry, RTCDisplacementFunctionN displacement);
 
+/* Sets a conservative bound of the displacement distance of a subdivision surface. */
+RTC_API void rtcSetGeometryMaxDisplacement(RTCGeometry geometry, float maxDisplacement);
+
 /* Returns the first half edge of a face. */
 RTC_API unsigned int rtcGetGeometryFirstHalfEdge(RTCGeometry geometry, unsigned int faceID);
 
@@ -23,6 +23,18 @@ enum RTCSceneFlags
   RTC_SCENE_FLAG_FILTER_FUNCTION_IN_ARGUMENTS = (1 << 3)
 };
 
+struct RTCSceneStatistics;
+struct RTCHit;
+
+/* Hits collected by a multi hit query, sorted front to back */
+struct RTCMultiHitBuffer
+{
+  unsigned int maxHits;                    // capacity of the tfar and hit arrays
+  unsigned int numHits;                    // number of collected hits, set by the query
+  float* tfar;                             // distance of each collected hit
+  struct RTCHit* hit;                      // hit data of each collected hit
+};
+
 /* Additional arguments for rtcIntersect1/4/8/16 calls */
 struct RTCIntersectArguments
 {
@@ -31,9 +43,14 @@ struct RTCIntersectArguments
   struct RTCRayQueryContext* context;     // optional pointer to ray query context
   RTCFilterFunctionN filter;               // filter function to execute
   RTCIntersectFunctionN intersect;         // user geometry intersection callback to execute
+  struct RTCSceneStatistics* stats;        // optional per query traversal statistics
+  unsigned int ignoreGeomID;               // geometry ID of primitive to ignore, RTC_INVALID_GEOMETRY_ID if none
+  unsigned int ignorePrimID;               // primitive ID of primitive to ignore
+  unsigned int ignoreInstID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance IDs of primitive to ignore
 #if RTC_MIN_WIDTH
   float minWidthDistanceFactor;            // curve radius is set to this factor times distance to ray origin
 #endif
+  struct RTCMultiHitBuffer* multiHit;      // optional buffer to collect the closest hits, only supported by rtcIntersect1
 };
 
 /* Initializes intersection arguments. */
@@ -44,6 +61,12 @@ RTC_FORCEINLINE void rtcInitIntersectArguments(struct RTCIntersectArguments* arg
   args->context = NULL;
   args->filter = NULL;
   args->intersect = NULL;
+  args->stats = NULL;
+  args->ignoreGeomID = RTC_INVALID_GEOMETRY_ID;
+  args->ignorePrimID = RTC_INVALID_GEOMETRY_ID;
+  for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+    args->ignoreInstID[l] = RTC_INVALID_GEOMETRY_ID;
+  args->multiHit = NULL;
 
 #if RTC_MIN_WIDTH
   args->minWidthDistanceFactor = 0.0f;
@@ -58,6 +81,10 @@ struct RTCOccludedArguments
   struct RTCRayQueryContext* context;     // optional pointer to ray query context
   RTCFilterFunctionN filter;               // filter function to execute
   RTCOccludedFunctionN occluded;           // user geometry occlusion callback to execute
+  struct RTCSceneStatistics* stats;        // optional per query traversal statistics
+  unsigned int ignoreGeomID;               // geometry ID of primitive to ignore, RTC_INVALID_GEOMETRY_ID if none
+  unsigned int ignorePrimID;               // primitive ID of primitive to ignore
+  unsigned int ignoreInstID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance IDs of primitive to ignore
 
 #if RTC_MIN_WIDTH
   float minWidthDistanceFactor;            // curve radius is set to this factor times distance to ray origin
@@ -72,6 +99,11 @@ RTC_FORCEINLINE void rtcInitOccludedArguments(struct RTCOccludedArguments* args)
   args->context = NULL;
   args->filter = NULL;
   args->occluded = NULL;
+  args->stats = NULL;
+  args->ignoreGeomID = RTC_INVALID_GEOMETRY_ID;
+  args->ignorePrimID = RTC_INVALID_GEOMETRY_ID;
+  for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+    args->ignoreInstID[l] = RTC_INVALID_GEOMETRY_ID;
 
 #if RTC_MIN_WIDTH
   args->minWidthDistanceFactor = 0.0f;
@@ -121,6 +153,26 @@ RTC_API void rtcCommitScene(RTCScene scene);
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
 
+/* Events passed to the callback of a deferred scene */
+enum RTCDeferredSceneEvent
+{
+  RTC_DEFERRED_SCENE_EVENT_BUILD = 0, // populate the scene, invoked before the first ray enters it
+  RTC_DEFERRED_SCENE_EVENT_EVICT = 1  // the acceleration structure of the scene got released
+};
+
+/* Callback function of a deferred scene */
+typedef void (*RTCDeferredSceneFunction)(void* userPtr, RTCScene scene, enum RTCDeferredSceneEvent event);
+
+/* Marks the scene as deferred, it gets populated and committed when the first ray enters an instance of it. */
+RTC_API void rtcSetSceneDeferred(RTCScene scene, const struct RTCBounds* bounds, RTCDeferredSceneFunction func, void* userPtr);
+
+/* Releases the acceleration structure of a deferred scene, it gets rebuilt on the next access. */
+RTC_API void rtcEvictScene(RTCScene scene);
+
+/* Returns if a ray or point query entered the deferred scene since the last call and resets that state. */
+RTC_API bool rtcGetSceneUsed(RTCScene scene);
+
+
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
 
@@ -142,6 +194,51 @@ RTC_API void rtcGetSceneBounds(RTCScene scene, struct RTCBounds* bounds_o);
 /* Returns the linear axis-aligned bounds of the scene. */
 RTC_API void rtcGetSceneLinearBounds(RTCScene scene, struct RTCLinearBounds* bounds_o);
 
+/* Traversal statistics of a scene */
+struct RTCSceneStatistics
+{
+  size_t numRays;        // number of rays that entered traversal of the scene
+  size_t numNodes;       // number of traversed inner nodes
+  size_t numLeaves;      // number of visited leaf nodes
+  size_t numFilterCalls; // number of filter function invocations
+};
+
+/* Build statistics of the last commit of a scene */
+struct RTCSceneBuildStatistics
+{
+  double commitTime;           // wall clock time of the commit in seconds
+  double primRefTime;          // time of primitive reference generation
+  double presplitTime;         // time of primitive reference generation with spatial presplits
+  double hierarchyTime;        // time of binning, splitting and leaf creation
+  double topLevelTime;         // time of top level builds of two level BVHs
+  double refitTime;            // time of refitting
+  size_t numBuilds;            // number of scene level BVHs built
+  size_t numPrimitives;        // number of primitives of these BVHs
+  size_t numNodes;             // number of inner nodes
+  size_t numLeaves;            // number of leaf nodes
+  size_t nodeBytesAABB;        // bytes of axis aligned inner nodes
+  size_t nodeBytesMotionBlur;  // bytes of motion blur inner nodes
+  size_t nodeBytesOBB;         // bytes of oriented inner nodes
+  size_t nodeBytesQuantized;   // bytes of quantized inner nodes
+  size_t leafBytes;            // bytes of leaves
+  size_t allocatorBytesUsed;   // bytes used in allocator blocks
+  size_t allocatorBytesFree;   // bytes reserved but unused in allocator blocks
+  size_t allocatorBytesWasted; // bytes lost to alignment and block ends
+  double sah;                  // summed SAH cost of the BVHs
+};
+
+/* Enables or disables gathering of traversal and build statistics for the scene. */
+RTC_API void rtcSetSceneEnableStatistics(RTCScene scene, bool enable);
+
+/* Returns the traversal statistics gathered for the scene. */
+RTC_API void rtcGetSceneStatistics(RTCScene scene, struct RTCSceneStatistics* stats_o);
+
+/* Resets the traversal statistics of the scene. */
+RTC_API void rtcResetSceneStatistics(RTCScene scene);
+
+/* Returns the build statistics of the last commit of the scene. */
+RTC_API void rtcGetSceneBuildStatistics(RTCScene scene, struct RTCSceneBuildStatistics* stats_o);
+
 
 /* Perform a closest point query of the scene. */
 RTC_API bool rtcPointQuery(RTCScene scene, struct RTCPointQuery* query, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void* userPtr);
@@ -6,6 +6,8 @@
 
 #include "../../common/algorithms/parallel_for_for.h"
 #include "../../common/algorithms/parallel_for_for_prefix_sum.h"
+#include "../../common/algorithms/parallel_prefix_sum.h"
+#include "../../common/algorithms/parallel_reduce.h"
 
 namespace embree
 {
@@ -55,6 +57,119 @@ namespace embree
       return pinfo;
     }
 
+#if defined(EMBREE_GEOMETRY_CURVE)
+
+    /* a curve segment is split if the oriented bounds of its sub-segments have less total surface area than this fraction of its own bounds */
+    static const float CURVE_SPLIT_AREA_RATIO = 0.8f;
+
+    /* splits a curve segment into sub-segments, returns a bit mask of the sub-segment codes to emit */
+    static unsigned int splitCurveSegment(const CurveGeometry* geom, const unsigned int primID, const unsigned int maxLevel)
+    {
+      if (maxLevel == 0) return 1;
+      
+      /* surface area of the oriented bounds of all sub-segments, indexed by sub-segment code */
+      float area[2*CurveGeometry::MAX_SUBSEGMENTS];
+      const unsigned int numCodes = 2u << maxLevel;
+      for (unsigned int code=1; code<numCodes; code++) {
+        const unsigned int id = CurveGeometry::encodeSegment(primID,code == 1 ? 0 : code);
+        area[code] = halfArea(geom->vbounds(geom->computeAlignedSpace(id),id));
+      }
+
+      /* find the cheapest cut through the tree of sub-segments bottom up */
+      bool split[2*CurveGeometry::MAX_SUBSEGMENTS];
+      float cost[2*CurveGeometry::MAX_SUBSEGMENTS];
+      for (unsigned int code=numCodes-1; code>=1; code--)
+      {
+        split[code] = false;
+        cost[code] = area[code];
+        if (2*code+1 < numCodes && cost[2*code]+cost[2*code+1] < CURVE_SPLIT_AREA_RATIO*area[code]) {
+          split[code] = true;
+          cost[code] = cost[2*code]+cost[2*code+1];
+        }
+      }
+
+      /* emit sub-segments of the cut top down */
+      unsigned int mask = 0;
+      unsigned int stack[CurveGeometry::MAX_SUBSEGMENTS_LOG+2];
+      size_t sptr = 0;
+      stack[sptr++] = 1;
+      while (sptr)
+      {
+        const unsigned int code = stack[--sptr];
+        if (split[code]) {
+          stack[sptr++] = 2*code+1;
+          stack[sptr++] = 2*code+0;
+          continue;
+        }
+        mask |= 1 << (code == 1 ? 0 : code);
+      }
+      return mask;
+    }
+
+    PrimInfo splitCurveSegments(Scene* scene, mvector<PrimRef>& prims, const PrimInfo& pinfo)
+    {
+      /* fast path if no curve geometry allows splitting */
+      bool split = false;
+      for (size_t geomID=0; geomID<scene->size(); geomID++) {
+        Geometry* geom = scene->get(geomID);
+        if (geom && (geom->getTypeMask() & Geometry::MTY_CURVE4) && ((CurveGeometry*)geom)->primIDMask != 0xFFFFFFFF)
+          split = true;
+      }
+      if (!split) return pinfo;
+
+      /* determine sub-segments of each curve segment */
+      const size_t N = pinfo.size();
+      mvector<unsigned short> splitMask(scene->device,N);
+      mvector<size_t> numSplits(scene->device,N);
+      parallel_for(size_t(0), N, size_t(1024), [&](const range<size_t>& r) {
+          for (size_t i=r.begin(); i<r.end(); i++)
+          {
+            unsigned int mask = 1;
+            Geometry* geom = scene->get(prims[i].geomID());
+            if ((geom->getTypeMask() & Geometry::MTY_CURVE4) && ((CurveGeometry*)geom)->primIDMask != 0xFFFFFFFF) {
+              const CurveGeometry* curves = (const CurveGeometry*) geom;
+              mask = splitCurveSegment(curves,prims[i].primID(),bsr(curves->maxSubsegments));
+            }
+            splitMask[i] = (unsigned short) mask;
+            numSplits[i] = 0;
+            for (unsigned int m=mask; m; m&=m-1) numSplits[i]++;
+          }
+        });
+
+      mvector<size_t> offsets(scene->device,N);
+      const size_t numSplitPrims = parallel_prefix_sum(numSplits,offsets,N,size_t(0),std::plus<size_t>());
+      if (numSplitPrims == N) return pinfo;
+
+      /* write sub-segment primrefs */
+      mvector<PrimRef> sprims(scene->device,numSplitPrims);
+      const PrimInfo sinfo = parallel_reduce(size_t(0), N, size_t(1024), PrimInfo(empty), [&](const range<size_t>& r) -> PrimInfo {
+          PrimInfo info(empty);
+          for (size_t i=r.begin(); i<r.end(); i++)
+          {
+            size_t k = offsets[i];
+            if (splitMask[i] == 1) {
+              info.add_center2(prims[i]);
+              sprims[k] = prims[i];
+              continue;
+            }
+            const CurveGeometry* geom = (const CurveGeometry*) scene->get(prims[i].geomID());
+            for (size_t mask=splitMask[i]; mask; ) {
+              const unsigned int code = (unsigned int) bscf(mask);
+              const unsigned int id = CurveGeometry::encodeSegment(prims[i].primID(),code);
+              const PrimRef prim(geom->vbounds(id),prims[i].geomID(),id);
+              info.add_center2(prim);
+              sprims[k++] = prim;
+            }
+          }
+          return info;
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+      prims = std::move(sprims);
+      return sinfo;
+    }
+
+#endif
+
     PrimInfo createPrimRefArray(Scene* scene, Geometry::GTypeMask types, bool mblur, const size_t numPrimRefs, mvector<PrimRef>& prims, mvector<SubGridBuildData>& sgrids, BuildProgressMonitor& progressMonitor)
     {
       ParallelForForPrefixSumState<PrimInfo> pstate;
@@ -78,6 +193,37 @@ namespace embree
       return pinfo;
     }
 
+    PrimInfo createTrianglePairPrimRefArray(Scene* scene, const size_t numPrimRefs, mvector<PrimRef>& prims, std::vector<std::vector<unsigned int>>& partners, BuildProgressMonitor& progressMonitor)
+    {
+      ParallelForForPrefixSumState<PrimInfo> pstate;
+      Scene::Iterator2 iter(scene,TriangleMesh::geom_type,false);
+
+      /* pair the triangles of each mesh */
+      progressMonitor(0);
+      partners.resize(iter.size());
+      parallel_for(iter.size(), [&](const size_t geomID) {
+          TriangleMesh* mesh = (TriangleMesh*) iter.at(geomID);
+          partners[geomID].resize(mesh ? mesh->size() : 0);
+          if (mesh) mesh->computeTrianglePairs(partners[geomID].data());
+        });
+      
+      /* first try */
+      pstate.init(iter,size_t(1024));
+      PrimInfo pinfo = parallel_for_for_prefix_sum0( pstate, iter, PrimInfo(empty), [&](Geometry* mesh, const range<size_t>& r, size_t k, size_t geomID) -> PrimInfo {
+          return ((TriangleMesh*)mesh)->createTrianglePairPrimRefArray(prims.data(),partners[geomID].data(),r,k,(unsigned)geomID);
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      
+      /* pairing triangles always reduces the number of primrefs, thus we have to compact */
+      if (pinfo.size() != numPrimRefs)
+      {
+        progressMonitor(0);
+        pinfo = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), [&](Geometry* mesh, const range<size_t>& r, size_t k, size_t geomID, const PrimInfo& base) -> PrimInfo {
+            return ((TriangleMesh*)mesh)->createTrianglePairPrimRefArray(prims.data(),partners[geomID].data(),r,base.size(),(unsigned)geomID);
+          }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      }
+      return pinfo;
+    }
+
     PrimInfo createPrimRefArrayMBlur(Scene* scene, Geometry::GTypeMask types, const size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor, size_t itime)
     {
       ParallelForForPrefixSumState<PrimInfo> pstate;
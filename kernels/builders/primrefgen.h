@@ -17,7 +17,13 @@ namespace embree
     PrimInfo createPrimRefArray(Scene* scene, Geometry::GTypeMask types, bool mblur, size_t numPrimitives, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
     PrimInfo createPrimRefArray(Scene* scene, Geometry::GTypeMask types, bool mblur, size_t numPrimitives, mvector<PrimRef>& prims, mvector<SubGridBuildData>& sgrids, BuildProgressMonitor& progressMonitor);
+
+    /* pairs adjacent triangles of all static triangle meshes and creates one primref per pair, partners[geomID][primID] returns the paired triangle, see TriangleMesh::computeTrianglePairs */
+    PrimInfo createTrianglePairPrimRefArray(Scene* scene, size_t numPrimitives, mvector<PrimRef>& prims, std::vector<std::vector<unsigned int>>& partners, BuildProgressMonitor& progressMonitor);
    
+    /* splits curve segments of geometries with sub-segment splitting enabled, the sub-segment is encoded into the upper primID bits */
+    PrimInfo splitCurveSegments(Scene* scene, mvector<PrimRef>& prims, const PrimInfo& pinfo);
+
     PrimInfo createPrimRefArrayMBlur(Scene* scene, Geometry::GTypeMask types, size_t numPrimitives, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor, size_t itime = 0);
 
     PrimInfoMB createPrimRefArrayMSMBlur(Scene* scene, Geometry::GTypeMask types, size_t numPrimitives, mvector<PrimRefMB>& prims, BuildProgressMonitor& progressMonitor, BBox1f t0t1 = BBox1f(0.0f,1.0f));
@@ -122,7 +122,7 @@ namespace embree
     }
 
     double t0 = 0.0;
-    if (device->benchmark || device->verbosity(2)) t0 = getSeconds();
+    if (device->benchmark || device->verbosity(2) || scene->build_stat.isGathering()) t0 = getSeconds();
     return t0;
   }
 
@@ -170,6 +170,26 @@ namespace embree
       std::cout << std::flush;
     }
 
+    /* build statistics of the commit */
+    if (scene->build_stat.isGathering())
+    {
+      if (!stat) stat.reset(new BVHNStatistics<N>(this));
+      BuildStat::Report report;
+      report.numBuilds = 1;
+      report.numPrimitives = numPrimitives;
+      stat->report(report);
+
+      FastAllocator::Statistics astat = alloc.getStatistics(FastAllocator::ANY_TYPE);
+      for (size_t i=0; i<objects.size(); i++)
+        if (objects[i])
+          astat = astat + objects[i]->alloc.getStatistics(FastAllocator::ANY_TYPE);
+
+      report.bytesUsed = astat.bytesUsed;
+      report.bytesFree = astat.bytesFree;
+      report.bytesWasted = astat.bytesWasted;
+      scene->build_stat.add(report);
+    }
+
     /* benchmark mode */
     if (device->benchmark)
     {
@@ -47,7 +47,12 @@ namespace embree
 
         /* create primref array */
         prims.resize(numPrimitives);
-        const PrimInfo pinfo = createPrimRefArray(scene,Geometry::MTY_CURVES,false,numPrimitives,prims,scene->progressInterface);
+        PrimInfo pinfo = createPrimRefArray(scene,Geometry::MTY_CURVES,false,numPrimitives,prims,scene->progressInterface);
+
+#if defined(EMBREE_GEOMETRY_CURVE)
+        /* split long, strongly bent curve segments into sub-segments with tighter bounds */
+        pinfo = splitCurveSegments(scene,prims,pinfo);
+#endif
 
         /* estimate acceleration structure size */
         const size_t node_bytes = pinfo.size()*sizeof(typename BVH::OBBNode)/(4*N);
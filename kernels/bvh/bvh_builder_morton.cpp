@@ -497,9 +497,12 @@ namespace embree
 
         /* create morton code array */
         BVHBuilderMorton::BuildPrim* dest = (BVHBuilderMorton::BuildPrim*) bvh->alloc.specialAlloc(bytesMortonCodes);
+        double t1 = bvh->scene->build_stat.startPhase();
         size_t numPrimitivesGen = createMortonCodeArray<Mesh>(mesh,morton,bvh->scene->progressInterface);
+        bvh->scene->build_stat.endPhase(BuildStat::PRIMREFS,t1);
 
         /* create BVH */
+        double t2 = bvh->scene->build_stat.startPhase();
         SetBVHNBounds<N> setBounds(bvh);
         CreateMortonLeaf<N,Primitive> createLeaf(mesh,geomID_,morton.data());
         CalculateMeshBounds<Mesh> calculateBounds(mesh);
@@ -508,6 +511,7 @@ namespace embree
           typename BVH::AABBNode::Create(),
           setBounds,createLeaf,calculateBounds,bvh->scene->progressInterface,
           morton.data(),dest,numPrimitivesGen,settings);
+        bvh->scene->build_stat.endPhase(BuildStat::HIERARCHY,t2);
         
         bvh->set(root.ref,LBBox3fa(root.bounds),numPrimitives);
         
@@ -13,6 +13,7 @@
 #include "../geometry/trianglei.h"
 #include "../geometry/quadv.h"
 #include "../geometry/quadi.h"
+#include "../geometry/trianglepairv.h"
 #include "../geometry/object.h"
 #include "../geometry/instance.h"
 #include "../geometry/instance_array.h"
@@ -78,6 +79,31 @@ namespace embree
       BVH* bvh;
     };
 
+    template<int N, typename Primitive>
+    struct CreateLeafTrianglePairs
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+
+      __forceinline CreateLeafTrianglePairs (BVH* bvh, const std::vector<std::vector<unsigned int>>& partners) : bvh(bvh), partners(partners) {}
+
+      __forceinline NodeRef operator() (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) const
+      {
+        size_t n = set.size();
+        size_t items = Primitive::blocks(n);
+        size_t start = set.begin();
+        Primitive* accel = (Primitive*) alloc.malloc1(items*sizeof(Primitive),BVH::byteAlignment);
+        typename BVH::NodeRef node = BVH::encodeLeaf((char*)accel,items);
+        for (size_t i=0; i<items; i++) {
+          accel[i].fill(prims,start,set.end(),bvh->scene,partners);
+        }
+        return node;
+      }
+
+      BVH* bvh;
+      const std::vector<std::vector<unsigned int>>& partners;
+    };
+
     /************************************************************************************/
     /************************************************************************************/
     /************************************************************************************/
@@ -153,9 +179,11 @@ namespace embree
             settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
             prims.resize(numPrimitives);
 
+            double t1 = bvh->scene->build_stat.startPhase();
             PrimInfo pinfo = mesh ?
               createPrimRefArray(mesh,geomID_,numPrimitives,prims,bvh->scene->progressInterface) :
               createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+            bvh->scene->build_stat.endPhase(BuildStat::PRIMREFS,t1);
 
             /* pinfo might has zero size due to invalid geometry */
             if (unlikely(pinfo.size() == 0))
@@ -166,7 +194,9 @@ namespace embree
             }
 
             /* call BVH builder */
+            double t2 = bvh->scene->build_stat.startPhase();
             NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+            bvh->scene->build_stat.endPhase(BuildStat::HIERARCHY,t2);
             bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
             bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
@@ -196,6 +226,84 @@ namespace embree
     /************************************************************************************/
     /************************************************************************************/
 
+    /* builds a BVH over pairs of triangles sharing an edge, optionally with quantized nodes */
+    template<int N, typename Primitive, bool quantized = false>
+    struct BVHNBuilderTrianglePairsSAH : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVHN<N>::NodeRef NodeRef;
+
+      BVH* bvh;
+      Scene* scene;
+      mvector<PrimRef> prims;
+      std::vector<std::vector<unsigned int>> partners; //!< paired triangle for each triangle of each mesh
+      GeneralBVHBuilder::Settings settings;
+
+      BVHNBuilderTrianglePairsSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize)
+        : bvh(bvh), scene(scene), prims(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD) {}
+
+      void build()
+      {
+	/* skip build for empty scene */
+        const size_t numPrimitives = scene->getNumPrimitives(TriangleMesh::geom_type,false);
+        if (numPrimitives == 0) {
+          bvh->clear();
+          prims.clear();
+          partners.clear();
+          return;
+        }
+
+        double t0 = bvh->preBuild(TOSTRING(isa) + std::string(quantized ? "::QBVH" : "::BVH") + toString(N) + "BuilderTrianglePairsSAH");
+
+        /* initialize allocator */
+        const size_t node_bytes = numPrimitives*(quantized ? sizeof(typename BVH::QuantizedNode) : sizeof(typename BVH::AABBNodeMB))/(4*N);
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+        bvh->alloc.init_estimate(node_bytes+leaf_bytes);
+        settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+        prims.resize(numPrimitives);
+
+        /* create primref array with one primref per triangle pair */
+        double t1 = bvh->scene->build_stat.startPhase();
+        PrimInfo pinfo = createTrianglePairPrimRefArray(scene,numPrimitives,prims,partners,bvh->scene->progressInterface);
+        bvh->scene->build_stat.endPhase(BuildStat::PRIMREFS,t1);
+
+        /* pinfo might has zero size due to invalid geometry */
+        if (unlikely(pinfo.size() == 0))
+        {
+          bvh->clear();
+          prims.clear();
+          partners.clear();
+          return;
+        }
+
+        /* call BVH builder */
+        double t2 = bvh->scene->build_stat.startPhase();
+        NodeRef root = quantized ?
+          BVHNBuilderQuantizedVirtual<N>::build(&bvh->alloc,CreateLeafTrianglePairs<N,Primitive>(bvh,partners),bvh->scene->progressInterface,prims.data(),pinfo,settings) :
+          BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafTrianglePairs<N,Primitive>(bvh,partners),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+        bvh->scene->build_stat.endPhase(BuildStat::HIERARCHY,t2);
+        bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+        if (!quantized) bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+        partners.clear();
+
+        /* for static geometries we can do some cleanups */
+        if (scene->isStaticAccel())
+          prims.clear();
+	bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+        partners.clear();
+      }
+    };
+
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+
     template<int N, typename Primitive>
     struct BVHNBuilderSAHQuantized : public Builder
     {
@@ -242,9 +350,11 @@ namespace embree
 #endif
             /* create primref array */
             prims.resize(numPrimitives);
+            double t1 = bvh->scene->build_stat.startPhase();
             PrimInfo pinfo = mesh ?
               createPrimRefArray(mesh,geomID_,numPrimitives,prims,bvh->scene->progressInterface) :
 	      createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+            bvh->scene->build_stat.endPhase(BuildStat::PRIMREFS,t1);
 
             /* enable os_malloc for two level build */
             if (mesh)
@@ -255,7 +365,9 @@ namespace embree
             const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
             bvh->alloc.init_estimate(node_bytes+leaf_bytes);
             settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+            double t2 = bvh->scene->build_stat.startPhase();
             NodeRef root = BVHNBuilderQuantizedVirtual<N>::build(&bvh->alloc,CreateLeafQuantized<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+            bvh->scene->build_stat.endPhase(BuildStat::HIERARCHY,t2);
             bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
             //bvh->layoutLargeNodes(pinfo.size()*0.005f); // FIXME: COPY LAYOUT FOR LARGE NODES !!!
 #if PROFILE
@@ -381,7 +493,9 @@ namespace embree
         numPreviousPrimitives = numGridPrimitives;
 
 
+        double t1 = bvh->scene->build_stat.startPhase();
         PrimInfo pinfo = mesh ? createPrimRefArrayGrids(mesh,prims,sgrids) : createPrimRefArrayGrids(scene,prims,sgrids);
+        bvh->scene->build_stat.endPhase(BuildStat::PRIMREFS,t1);
         const size_t numPrimitives = pinfo.size();
         /* no primitives */
         if (numPrimitives == 0) {
@@ -419,7 +533,9 @@ namespace embree
         }
 
         /* call BVH builder */
+        double t2 = bvh->scene->build_stat.startPhase();
         NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafGrid<N,SubGridQBVHN<N>>(bvh,sgrids.data()),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+        bvh->scene->build_stat.endPhase(BuildStat::HIERARCHY,t2);
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
@@ -459,6 +575,9 @@ namespace embree
     Builder* BVH4Triangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type,true); }
 
     Builder* BVH4QuantizedTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH4QuantizedTriangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,Triangle4>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH4TrianglePair4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderTrianglePairsSAH<4,TrianglePair4v>((BVH4*)bvh,scene,4,1.0f,4,inf); }
+    Builder* BVH4QuantizedTrianglePair4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderTrianglePairsSAH<4,TrianglePair4v,true>((BVH4*)bvh,scene,4,1.0f,4,inf); }
 #if defined(__AVX__)
     Builder* BVH8Triangle4MeshBuilderSAH  (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderSAH<8,Triangle4>((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH8Triangle4vMeshBuilderSAH (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderSAH<8,Triangle4v>((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
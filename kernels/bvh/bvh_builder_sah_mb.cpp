@@ -176,7 +176,9 @@ namespace embree
       {
         /* create primref array */
         mvector<PrimRefMB> prims(scene->device,numPrimitives);
+        double t1 = bvh->scene->build_stat.startPhase();
 	PrimInfoMB pinfo = createPrimRefArrayMSMBlur(scene,gtype_,numPrimitives,prims,bvh->scene->progressInterface);
+        bvh->scene->build_stat.endPhase(BuildStat::PRIMREFS,t1);
 
         /* early out if no valid primitives */
         if (pinfo.size() == 0) { bvh->clear(); return; }
@@ -199,6 +201,7 @@ namespace embree
         settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
         
         /* build hierarchy */
+        double t2 = bvh->scene->build_stat.startPhase();
         auto root =
           BVHBuilderMSMBlur::build<NodeRef>(prims,pinfo,scene->device,
                                             RecalculatePrimRef<Mesh>(scene),
@@ -208,6 +211,7 @@ namespace embree
                                             CreateMSMBlurLeaf<N,Mesh,Primitive>(bvh),
                                             bvh->scene->progressInterface,
                                             settings);
+        bvh->scene->build_stat.endPhase(BuildStat::HIERARCHY,t2);
 
         bvh->set(root.ref,root.lbounds,pinfo.num_time_segments);
       }
@@ -607,7 +611,9 @@ namespace embree
       {
         /* create primref array */
         mvector<PrimRefMB> prims(scene->device,numPrimitives);
+        double t1 = bvh->scene->build_stat.startPhase();
         PrimInfoMB pinfo = createPrimRefArrayMSMBlurGrid(scene,prims,bvh->scene->progressInterface);
+        bvh->scene->build_stat.endPhase(BuildStat::PRIMREFS,t1);
 
         /* early out if no valid primitives */
         if (pinfo.size() == 0) { bvh->clear(); return; }
@@ -637,6 +643,7 @@ namespace embree
         settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
         
         /* build hierarchy */
+        double t2 = bvh->scene->build_stat.startPhase();
         auto root =
           BVHBuilderMSMBlur::build<NodeRef>(prims,pinfo,scene->device,
                                             recalculatePrimRef,
@@ -646,6 +653,7 @@ namespace embree
                                             CreateMSMBlurLeafGrid<N>(scene,bvh,sgrids.data()),
                                             bvh->scene->progressInterface,
                                             settings);
+        bvh->scene->build_stat.endPhase(BuildStat::HIERARCHY,t2);
         bvh->set(root.ref,root.lbounds,pinfo.num_time_segments);
       }
 
@@ -108,9 +108,11 @@ namespace embree
         if (likely(usePreSplits))
 	  {		     
             /* spatial presplit SAH BVH builder */
+            double t1 = bvh->scene->build_stat.startPhase();
 	    pinfo = mesh ?
 	      createPrimRefArray_presplit<Mesh,Splitter>(mesh,maxGeomID,numOriginalPrimitives,prims0,bvh->scene->progressInterface) :
 	      createPrimRefArray_presplit<Mesh,Splitter>(scene,Mesh::geom_type,false,numOriginalPrimitives,prims0,bvh->scene->progressInterface);
+            bvh->scene->build_stat.endPhase(BuildStat::PRESPLITS,t1);
 
 	    const size_t node_bytes = pinfo.size()*sizeof(typename BVH::AABBNode)/(4*N);
 	    const size_t leaf_bytes = size_t(1.2*Primitive::blocks(pinfo.size())*sizeof(Primitive));
@@ -121,14 +123,18 @@ namespace embree
 	    settings.maxDepth = BVH::maxBuildDepthLeaf;
 
 	    /* call BVH builder */
+            double t2 = bvh->scene->build_stat.startPhase();
 	    root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafSpatial<N,Primitive>(bvh),bvh->scene->progressInterface,prims0.data(),pinfo,settings);
+            bvh->scene->build_stat.endPhase(BuildStat::HIERARCHY,t2);
 	  }
 	else
 	  {
             /* standard spatial split SAH BVH builder */
+            double t1 = bvh->scene->build_stat.startPhase();
 	    pinfo = mesh ?
 	      createPrimRefArray(mesh,geomID_,numSplitPrimitives,prims0,bvh->scene->progressInterface) :
 	      createPrimRefArray(scene,Mesh::geom_type,false,numSplitPrimitives,prims0,bvh->scene->progressInterface);
+            bvh->scene->build_stat.endPhase(BuildStat::PRIMREFS,t1);
 	
 	    Splitter splitter(scene);
 
@@ -141,6 +147,7 @@ namespace embree
 	    settings.maxDepth = BVH::maxBuildDepthLeaf;
 
 	    /* call BVH builder */
+            double t2 = bvh->scene->build_stat.startPhase();
 	    root = BVHBuilderBinnedFastSpatialSAH::build<NodeRef>(
 								  typename BVH::CreateAlloc(bvh),
 								  typename BVH::AABBNode::Create2(),
@@ -151,6 +158,7 @@ namespace embree
 								  prims0.data(),
 								  numSplitPrimitives,
 								  pinfo,settings);
+            bvh->scene->build_stat.endPhase(BuildStat::HIERARCHY,t2);
 
 	    /* ==================== */
 	  }
@@ -74,6 +74,16 @@ namespace embree
         return NN;
       }
 
+      /* creates a single leaf with conservative bounds, the displaced grid is created during traversal */
+      __forceinline static unsigned createLazy(SubdivPatch1Lazy* patch, SubdivMesh* mesh, PrimRef* prims)
+      {
+        const unsigned x1 = patch->grid_u_res-1, y1 = patch->grid_v_res-1;
+        BBox3fa bounds = evalGridBounds(*patch,0,x1,0,y1,patch->grid_u_res,patch->grid_v_res,mesh,false);
+        bounds = enlarge(bounds,Vec3fa(mesh->maxDisplacement));
+        *prims = PrimRef(bounds,BVH4::encodeTypedLeaf(patch,2));
+        return 1;
+      }
+
       void build() 
       {
         /* skip build for empty scene */
@@ -108,7 +118,7 @@ namespace embree
             {
               float level[4]; SubdivPatch1Base::computeEdgeLevels(edge_level,subdiv,level);
               Vec2i grid = SubdivPatch1Base::computeGridSize(level);
-              size_t num = getNumEagerLeaves(grid.x,grid.y);
+              size_t num = mesh->hasDisplacementBound() ? 1 : getNumEagerLeaves(grid.x,grid.y);
               g+=num;
               p++;
             });
@@ -137,9 +147,16 @@ namespace embree
             
             patch_eval_subdivision(mesh->getHalfEdge(0,f),[&](const Vec2f uv[4], const int subdiv[4], const float edge_level[4], int subPatch)
             {
-              SubdivPatch1Base patch(unsigned(geomID),unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
-              size_t num = createEager(patch,scene,mesh,unsigned(f),alloc,&prims[base.end+s.end]);
-              assert(num == getNumEagerLeaves(patch.grid_u_res,patch.grid_v_res));
+              size_t num = 0;
+              if (mesh->hasDisplacementBound()) {
+                void* ptr = alloc.malloc1(sizeof(SubdivPatch1Lazy),64);
+                SubdivPatch1Lazy* patch = new (ptr) SubdivPatch1Lazy(unsigned(geomID),unsigned(f),subPatch,mesh,uv,edge_level,subdiv,VSIZEX,&bvh->alloc);
+                num = createLazy(patch,mesh,&prims[base.end+s.end]);
+              } else {
+                SubdivPatch1Base patch(unsigned(geomID),unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
+                num = createEager(patch,scene,mesh,unsigned(f),alloc,&prims[base.end+s.end]);
+                assert(num == getNumEagerLeaves(patch.grid_u_res,patch.grid_v_res));
+              }
               for (size_t i=0; i<num; i++)
                 s.add_center2(prims[base.end+s.end]);
               s.begin++;
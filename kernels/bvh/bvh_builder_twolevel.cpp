@@ -111,6 +111,8 @@ namespace embree
 #if PROFILE
       double d0 = getSeconds();
 #endif
+      double t1 = bvh->scene->build_stat.startPhase();
+
       /* fast path for single geometry scenes */
       if (nextRef == 1) { 
         bvh->set(refs[0].node,LBBox3fa(refs[0].bounds()),numPrimitives);
@@ -212,6 +214,7 @@ namespace embree
           }
         }
       }  
+      bvh->scene->build_stat.endPhase(BuildStat::TOPLEVEL,t1);
         
       bvh->alloc.cleanup();
       bvh->postBuild(t0);
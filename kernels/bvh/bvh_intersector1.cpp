@@ -11,6 +11,7 @@
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
 #include "../geometry/quadv_intersector.h"
+#include "../geometry/trianglepairv_intersector.h"
 #include "../geometry/quadi_intersector.h"
 #include "../geometry/curveNv_intersector.h"
 #include "../geometry/curveNi_intersector.h"
@@ -55,6 +56,9 @@ namespace embree
       /* filter out invalid rays */
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
       if (!ray.valid()) return;
+#endif
+#if defined(EMBREE_RAY_MASK)
+      if (unlikely((ray.mask & bvh->scene->getGeometryMask()) == 0)) return;
 #endif
       /* verify correct input */
       assert(ray.valid());
@@ -67,6 +71,10 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, types> nodeTraverser;
 
+      /* traversal statistics */
+      TraversalStat::Query tstat(context->scene->traversal_stat,context->args->stats);
+      tstat.rays = 1;
+
       /* pop loop */
       while (true) pop:
       {
@@ -87,6 +95,7 @@ namespace embree
           STAT3(normal.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          tstat.nodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -99,6 +108,7 @@ namespace embree
         /* this is a leaf node */
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves,1,1,1);
+        tstat.leaves++;
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
         size_t lazy_node = 0;
         PrimitiveIntersector1::intersect(This, pre, ray, context, prim, num, tray, lazy_node);
@@ -141,6 +151,9 @@ namespace embree
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
       if (!ray.valid()) return;
 #endif
+#if defined(EMBREE_RAY_MASK)
+      if (unlikely((ray.mask & bvh->scene->getGeometryMask()) == 0)) return;
+#endif
 
       /* verify correct input */
       assert(ray.valid());
@@ -153,6 +166,10 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, types> nodeTraverser;
 
+      /* traversal statistics */
+      TraversalStat::Query tstat(context->scene->traversal_stat,context->args->stats);
+      tstat.rays = 1;
+
       /* pop loop */
       while (true) pop:
       {
@@ -169,6 +186,7 @@ namespace embree
           STAT3(shadow.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+          tstat.nodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -181,6 +199,7 @@ namespace embree
         /* this is a leaf node */
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
+        tstat.leaves++;
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(This, pre, ray, context, prim, num, tray, lazy_node)) {
@@ -12,6 +12,7 @@
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
 #include "../geometry/quadv_intersector.h"
+#include "../geometry/trianglepairv_intersector.h"
 #include "../geometry/quadi_intersector.h"
 #include "../geometry/curveNv_intersector.h"
 #include "../geometry/curveNi_intersector.h"
@@ -55,6 +56,9 @@ namespace embree
       TravRay<N,robust> tray1;
       tray1.template init<K>(k, tray.org, tray.dir, tray.rdir, tray.nearXYZ, tray.tnear[k], tray.tfar[k]);
 
+      /* traversal statistics, the ray got already counted by the packet traversal */
+      TraversalStat::Query tstat(context->scene->traversal_stat,context->args->stats);
+
       /* pop loop */
       while (true) pop:
       {
@@ -75,6 +79,7 @@ namespace embree
           STAT3(normal.trav_nodes, 1, 1, 1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray1, ray.time()[k], tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          tstat.nodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -87,6 +92,7 @@ namespace embree
         /* this is a leaf node */
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves, 1, 1, 1);
+        tstat.leaves++;
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
 
         size_t lazy_node = 0;
@@ -128,6 +134,9 @@ namespace embree
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
       valid &= ray.valid();
 #endif
+#if defined(EMBREE_RAY_MASK)
+      valid &= (ray.mask & int(bvh->scene->getGeometryMask())) != 0;
+#endif
 
       /* return if there are no valid rays */
       size_t valid_bits = movemask(valid);
@@ -138,6 +147,10 @@ namespace embree
 
       if (unlikely(valid_bits == 0)) return;
 
+      /* traversal statistics */
+      TraversalStat::Query tstat(context->scene->traversal_stat,context->args->stats);
+      tstat.rays = popcnt(valid);
+
       /* verify correct input */
       assert(all(valid, ray.valid()));
       assert(all(valid, ray.tnear() >= 0.0f));
@@ -255,6 +268,7 @@ namespace embree
             /* process nodes */
             const vbool<K> valid_node = tray.tfar > curDist;
             STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            tstat.nodes++;
             const NodeRef nodeRef = cur;
             const BaseNode* __restrict__ const node = nodeRef.baseNode();
 
@@ -354,6 +368,7 @@ namespace embree
           assert(cur != BVH::emptyNode);
           const vbool<K> valid_leaf = tray.tfar > curDist;
           STAT3(normal.trav_leaves, 1, popcnt(valid_leaf), K);
+          tstat.leaves++;
           if (unlikely(none(valid_leaf))) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
 
@@ -383,11 +398,18 @@ namespace embree
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
       valid &= ray.valid();
 #endif
+#if defined(EMBREE_RAY_MASK)
+      valid &= (ray.mask & int(bvh->scene->getGeometryMask())) != 0;
+#endif
 
       /* return if there are no valid rays */
       size_t valid_bits = movemask(valid);
       if (unlikely(valid_bits == 0)) return;
 
+      /* traversal statistics */
+      TraversalStat::Query tstat(context->scene->traversal_stat,context->args->stats);
+      tstat.rays = popcnt(valid);
+
       /* verify correct input */
       assert(all(valid, ray.valid()));
       assert(all(valid, ray.tnear() >= 0.0f));
@@ -436,6 +458,7 @@ namespace embree
           {
             /* process nodes */
             //STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            tstat.nodes++;
             const NodeRef nodeRef = cur;
             const AABBNode* __restrict__ const node = nodeRef.getAABBNode();
 
@@ -505,6 +528,7 @@ namespace embree
           assert(cur != BVH::emptyNode);
           const vbool<K> valid_leaf = tray.tfar > curDist;
           STAT3(normal.trav_leaves, 1, popcnt(valid_leaf), K);
+          tstat.leaves++;
           if (unlikely(none(valid_leaf))) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
 
@@ -552,6 +576,9 @@ namespace embree
         TravRay<N,robust> tray1;
         tray1.template init<K>(k, tray.org, tray.dir, tray.rdir, tray.nearXYZ, tray.tnear[k], tray.tfar[k]);
 
+        /* traversal statistics, the ray got already counted by the packet traversal */
+        TraversalStat::Query tstat(context->scene->traversal_stat,context->args->stats);
+
 	/* pop loop */
 	while (true) pop:
 	{
@@ -568,6 +595,7 @@ namespace embree
             STAT3(shadow.trav_nodes, 1, 1, 1);
             bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray1, ray.time()[k], tNear, mask);
             if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+            tstat.nodes++;
 
             /* if no child is hit, pop next node */
             if (unlikely(mask == 0))
@@ -580,6 +608,7 @@ namespace embree
           /* this is a leaf node */
           assert(cur != BVH::emptyNode);
           STAT3(shadow.trav_leaves, 1, 1, 1);
+          tstat.leaves++;
           size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
 
           size_t lazy_node = 0;
@@ -622,11 +651,18 @@ namespace embree
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
       valid &= ray.valid();
 #endif
+#if defined(EMBREE_RAY_MASK)
+      valid &= (ray.mask & int(bvh->scene->getGeometryMask())) != 0;
+#endif
 
       /* return if there are no valid rays */
       const size_t valid_bits = movemask(valid);
       if (unlikely(valid_bits == 0)) return;
 
+      /* traversal statistics */
+      TraversalStat::Query tstat(context->scene->traversal_stat,context->args->stats);
+      tstat.rays = popcnt(valid);
+
       /* verify correct input */
       assert(all(valid, ray.valid()));
       assert(all(valid, ray.tnear() >= 0.0f));
@@ -704,6 +740,7 @@ namespace embree
           /* process nodes */
           const vbool<K> valid_node = tray.tfar > curDist;
           STAT3(shadow.trav_nodes, 1, popcnt(valid_node), K);
+          tstat.nodes++;
           const NodeRef nodeRef = cur;
           const BaseNode* __restrict__ const node = nodeRef.baseNode();
 
@@ -763,6 +800,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         const vbool<K> valid_leaf = tray.tfar > curDist;
         STAT3(shadow.trav_leaves, 1, popcnt(valid_leaf), K);
+        tstat.leaves++;
         if (unlikely(none(valid_leaf))) continue;
         size_t items; const Primitive* prim = (Primitive*) cur.leaf(items);
 
@@ -794,11 +832,18 @@ namespace embree
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
       valid &= ray.valid();
 #endif
+#if defined(EMBREE_RAY_MASK)
+      valid &= (ray.mask & int(bvh->scene->getGeometryMask())) != 0;
+#endif
 
       /* return if there are no valid rays */
       size_t valid_bits = movemask(valid);
       if (unlikely(valid_bits == 0)) return;
 
+      /* traversal statistics */
+      TraversalStat::Query tstat(context->scene->traversal_stat,context->args->stats);
+      tstat.rays = popcnt(valid);
+
       /* verify correct input */
       assert(all(valid, ray.valid()));
       assert(all(valid, ray.tnear() >= 0.0f));
@@ -849,6 +894,7 @@ namespace embree
           {
             /* process nodes */
             //STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            tstat.nodes++;
             const NodeRef nodeRef = cur;
             const AABBNode* __restrict__ const node = nodeRef.getAABBNode();
 
@@ -895,6 +941,7 @@ namespace embree
 #if defined(__AVX__)
           STAT3(normal.trav_leaves, 1, popcnt(m_active), K);
 #endif
+          tstat.leaves++;
           if (unlikely(!m_active)) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
 
@@ -188,7 +188,11 @@ namespace embree
         builder->build();
       }
       else
+      {
+        double t0 = bvh->scene->build_stat.startPhase();
         refitter->refit();
+        bvh->scene->build_stat.endPhase(BuildStat::REFIT,t0);
+      }
     }
 
     template class BVHNRefitter<4>;
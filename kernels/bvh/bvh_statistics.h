@@ -272,6 +272,19 @@ namespace embree
       return stat.bytes(bvh);
     }
 
+    /*! Adds node and leaf statistics to a build report */
+    void report(BuildStat::Report& r) const
+    {
+      r.sah += sah();
+      r.numNodes += stat.statAABBNodes.size() + stat.statOBBNodes.size() + stat.statAABBNodesMB.size() + stat.statAABBNodesMB4D.size() + stat.statOBBNodesMB.size() + stat.statQuantizedNodes.size();
+      r.numLeaves += stat.statLeaf.size();
+      r.nodeBytes[BuildStat::AABB_NODES] += stat.statAABBNodes.bytes();
+      r.nodeBytes[BuildStat::AABB_MB_NODES] += stat.statAABBNodesMB.bytes() + stat.statAABBNodesMB4D.bytes();
+      r.nodeBytes[BuildStat::OBB_NODES] += stat.statOBBNodes.bytes() + stat.statOBBNodesMB.bytes();
+      r.nodeBytes[BuildStat::QUANTIZED_NODES] += stat.statQuantizedNodes.bytes();
+      r.leafBytes += stat.statLeaf.bytes(bvh);
+    }
+
   private:
     Statistics statistics(NodeRef node, const double A, const BBox1f dt);
 
@@ -208,10 +208,10 @@ namespace embree
     struct Intersectors 
     {
       Intersectors() 
-      : ptr(nullptr), leafIntersector(nullptr), collider(nullptr), intersector1(nullptr), intersector4(nullptr), intersector8(nullptr), intersector16(nullptr) {}
+      : ptr(nullptr), leafIntersector(nullptr), collider(nullptr), intersector1(nullptr), intersector4(nullptr), intersector8(nullptr), intersector16(nullptr), nofilter_query(false) {}
 
       Intersectors (ErrorFunc error) 
-      : ptr(nullptr), leafIntersector(nullptr), collider(error), intersector1(error), intersector4(error), intersector8(error), intersector16(error) {}
+      : ptr(nullptr), leafIntersector(nullptr), collider(error), intersector1(error), intersector4(error), intersector8(error), intersector16(error), nofilter_query(false) {}
 
       void print(size_t ident) 
       {
@@ -237,8 +237,16 @@ namespace embree
         }
       }
 
-      void select(bool filter)
+      /*! Selects the intersectors to use. The nofilter variants skip
+       *  filter functions and per-hit ray mask tests, thus they are only
+       *  valid if all geometries share the same mask. */
+      void select(bool filter_, bool mask)
       {
+        const bool filter = filter_ || mask;
+        if (intersector1_filter) {
+          if (filter) intersector1 = intersector1_filter;
+          else        intersector1 = intersector1_nofilter;
+        }
         if (intersector4_filter) {
           if (filter) intersector4 = intersector4_filter;
           else        intersector4 = intersector4_nofilter;
@@ -251,6 +259,36 @@ namespace embree
           if (filter) intersector16 = intersector16_filter;
           else         intersector16 = intersector16_nofilter;
         }
+
+        /* queries that disable filter functions through their feature
+           mask can still use the nofilter variants if masks permit */
+        nofilter_query = filter_ && !mask;
+      }
+
+      /* queries with RTC_RAY_QUERY_FLAG_CULL_BACKFACES use the cull
+         variants, accels without such variants ignore the flag */
+      __forceinline const Intersector1& getIntersector1(RayQueryContext* context) const {
+        if (unlikely(context->cullBackfaces()) && intersector1_cull) return intersector1_cull;
+        if (unlikely(nofilter_query) && intersector1_nofilter && !context->enableFilterFunction()) return intersector1_nofilter;
+        return intersector1;
+      }
+
+      __forceinline const Intersector4& getIntersector4(RayQueryContext* context) const {
+        if (unlikely(context->cullBackfaces()) && intersector4_cull) return intersector4_cull;
+        if (unlikely(nofilter_query) && intersector4_nofilter && !context->enableFilterFunction()) return intersector4_nofilter;
+        return intersector4;
+      }
+
+      __forceinline const Intersector8& getIntersector8(RayQueryContext* context) const {
+        if (unlikely(context->cullBackfaces()) && intersector8_cull) return intersector8_cull;
+        if (unlikely(nofilter_query) && intersector8_nofilter && !context->enableFilterFunction()) return intersector8_nofilter;
+        return intersector8;
+      }
+
+      __forceinline const Intersector16& getIntersector16(RayQueryContext* context) const {
+        if (unlikely(context->cullBackfaces()) && intersector16_cull) return intersector16_cull;
+        if (unlikely(nofilter_query) && intersector16_nofilter && !context->enableFilterFunction()) return intersector16_nofilter;
+        return intersector16;
       }
 
       __forceinline bool pointQuery (PointQuery* query, PointQueryContext* context) {
@@ -267,43 +305,43 @@ namespace embree
       /*! Intersects a single ray with the scene. */
       __forceinline void intersect (RTCRayHit& ray, RayQueryContext* context) {
         assert(intersector1.intersect);
-        intersector1.intersect(this,ray,context);
+        getIntersector1(context).intersect(this,ray,context);
       }
 
       /*! Intersects a packet of 4 rays with the scene. */
       __forceinline void intersect4 (const void* valid, RTCRayHit4& ray, RayQueryContext* context) {
         assert(intersector4.intersect);
-        intersector4.intersect(valid,this,ray,context);
+        getIntersector4(context).intersect(valid,this,ray,context);
       }
       
       /*! Intersects a packet of 8 rays with the scene. */
       __forceinline void intersect8 (const void* valid, RTCRayHit8& ray, RayQueryContext* context) {
         assert(intersector8.intersect);
-        intersector8.intersect(valid,this,ray,context);
+        getIntersector8(context).intersect(valid,this,ray,context);
       }
       
       /*! Intersects a packet of 16 rays with the scene. */
       __forceinline void intersect16 (const void* valid, RTCRayHit16& ray, RayQueryContext* context) {
         assert(intersector16.intersect);
-        intersector16.intersect(valid,this,ray,context);
+        getIntersector16(context).intersect(valid,this,ray,context);
       }
 
       /*! Intersects a packet of 4 rays with the scene. */
       __forceinline void intersect (const void* valid, RTCRayHit4& ray, RayQueryContext* context) {
         assert(intersector4.intersect);
-        intersector4.intersect(valid,this,ray,context);
+        getIntersector4(context).intersect(valid,this,ray,context);
       }
       
       /*! Intersects a packet of 8 rays with the scene. */
       __forceinline void intersect (const void* valid, RTCRayHit8& ray, RayQueryContext* context) {
         assert(intersector8.intersect);
-        intersector8.intersect(valid,this,ray,context);
+        getIntersector8(context).intersect(valid,this,ray,context);
       }
       
       /*! Intersects a packet of 16 rays with the scene. */
       __forceinline void intersect (const void* valid, RTCRayHit16& ray, RayQueryContext* context) {
         assert(intersector16.intersect);
-        intersector16.intersect(valid,this,ray,context);
+        getIntersector16(context).intersect(valid,this,ray,context);
       }
       
 #if defined(__SSE__) || defined(__ARM_NEON)
@@ -328,43 +366,43 @@ namespace embree
       /*! Tests if single ray is occluded by the scene. */
       __forceinline void occluded (RTCRay& ray, RayQueryContext* context) {
         assert(intersector1.occluded);
-        intersector1.occluded(this,ray,context);
+        getIntersector1(context).occluded(this,ray,context);
       }
       
       /*! Tests if a packet of 4 rays is occluded by the scene. */
       __forceinline void occluded4 (const void* valid, RTCRay4& ray, RayQueryContext* context) {
         assert(intersector4.occluded);
-        intersector4.occluded(valid,this,ray,context);
+        getIntersector4(context).occluded(valid,this,ray,context);
       }
       
       /*! Tests if a packet of 8 rays is occluded by the scene. */
       __forceinline void occluded8 (const void* valid, RTCRay8& ray, RayQueryContext* context) {
         assert(intersector8.occluded);
-        intersector8.occluded(valid,this,ray,context);
+        getIntersector8(context).occluded(valid,this,ray,context);
       }
       
       /*! Tests if a packet of 16 rays is occluded by the scene. */
       __forceinline void occluded16 (const void* valid, RTCRay16& ray, RayQueryContext* context) {
         assert(intersector16.occluded);
-        intersector16.occluded(valid,this,ray,context);
+        getIntersector16(context).occluded(valid,this,ray,context);
       }
 
       /*! Tests if a packet of 4 rays is occluded by the scene. */
       __forceinline void occluded (const void* valid, RTCRay4& ray, RayQueryContext* context) {
         assert(intersector4.occluded);
-        intersector4.occluded(valid,this,ray,context);
+        getIntersector4(context).occluded(valid,this,ray,context);
       }
       
       /*! Tests if a packet of 8 rays is occluded by the scene. */
       __forceinline void occluded (const void* valid, RTCRay8& ray, RayQueryContext* context) {
         assert(intersector8.occluded);
-        intersector8.occluded(valid,this,ray,context);
+        getIntersector8(context).occluded(valid,this,ray,context);
       }
       
       /*! Tests if a packet of 16 rays is occluded by the scene. */
       __forceinline void occluded (const void* valid, RTCRay16& ray, RayQueryContext* context) {
         assert(intersector16.occluded);
-        intersector16.occluded(valid,this,ray,context);
+        getIntersector16(context).occluded(valid,this,ray,context);
       }
       
 #if defined(__SSE__) || defined(__ARM_NEON)
@@ -403,15 +441,22 @@ namespace embree
       void* leafIntersector;
       Collider collider;
       Intersector1 intersector1;
+      Intersector1 intersector1_filter;
+      Intersector1 intersector1_nofilter;
+      Intersector1 intersector1_cull;
       Intersector4 intersector4;
       Intersector4 intersector4_filter;
       Intersector4 intersector4_nofilter;
+      Intersector4 intersector4_cull;
       Intersector8 intersector8;
       Intersector8 intersector8_filter;
       Intersector8 intersector8_nofilter;
+      Intersector8 intersector8_cull;
       Intersector16 intersector16;
       Intersector16 intersector16_filter;
       Intersector16 intersector16_nofilter;
+      Intersector16 intersector16_cull;
+      bool nofilter_query;
     };
   
   public:
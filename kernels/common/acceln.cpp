@@ -192,10 +192,10 @@ namespace embree
     }
   }
 
-  void AccelN::accels_select(bool filter)
+  void AccelN::accels_select(bool filter, bool mask)
   {
     for (size_t i=0; i<accels.size(); i++) 
-      accels[i]->intersectors.select(filter);
+      accels[i]->intersectors.select(filter,mask);
   }
 
   void AccelN::accels_deleteGeometry(size_t geomID) 
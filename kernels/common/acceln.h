@@ -37,7 +37,7 @@ namespace embree
     void accels_print(size_t ident);
     void accels_immutable();
     void accels_build ();
-    void accels_select(bool filter);
+    void accels_select(bool filter, bool mask);
     void accels_deleteGeometry(size_t geomID);
     void accels_clear ();
 
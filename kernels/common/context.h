@@ -45,10 +45,48 @@ namespace embree
       return embree::isIncoherent(args->flags);
     }
 
+    __forceinline bool enableFilterFunction() const {
+      return args->feature_mask & RTC_FEATURE_FLAG_FILTER_FUNCTION;
+    }
+
     __forceinline bool enforceArgumentFilterFunction() const {
       return args->flags & RTC_RAY_QUERY_FLAG_INVOKE_ARGUMENT_FILTER;
     }
 
+    __forceinline bool cullBackfaces() const {
+      return args->flags & RTC_RAY_QUERY_FLAG_CULL_BACKFACES;
+    }
+
+    /* returns true if a primitive to ignore got specified and the current instance stack matches its instance IDs */
+    __forceinline bool hasIgnoredPrimitive() const
+    {
+      if (likely(args->ignoreGeomID == RTC_INVALID_GEOMETRY_ID))
+        return false;
+
+      for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        if (user->instID[l] != args->ignoreInstID[l])
+          return false;
+
+      return true;
+    }
+
+    /* returns true if the primitive got ignored for the ray query */
+    __forceinline bool isIgnored(const unsigned int geomID, const unsigned int primID) const {
+      return hasIgnoredPrimitive() && geomID == args->ignoreGeomID && primID == args->ignorePrimID;
+    }
+
+    template<int M>
+    __forceinline vbool<M> isIgnored(const vuint<M>& geomIDs, const vuint<M>& primIDs) const
+    {
+      if (likely(!hasIgnoredPrimitive())) return false;
+      return (geomIDs == vuint<M>(args->ignoreGeomID)) & (primIDs == vuint<M>(args->ignorePrimID));
+    }
+
+    /* returns the multi hit buffer, only valid for intersection queries as the occluded arguments do not have this member */
+    __forceinline RTCMultiHitBuffer* getMultiHitBuffer() const {
+      return args->multiHit;
+    }
+
 #if RTC_MIN_WIDTH
     __forceinline float getMinWidthDistanceFactor() const {
       return args->minWidthDistanceFactor;
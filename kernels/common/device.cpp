@@ -22,6 +22,8 @@
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
 
+#include "ray_dump.h"
+
 #include "../../common/sys/alloc.h"
 
 #if defined(EMBREE_SYCL_SUPPORT)
@@ -38,6 +40,7 @@ namespace embree
 
   static MutexSys g_mutex;
   static std::map<Device*,size_t> g_cache_size_map;
+  static std::map<Device*,std::pair<size_t,size_t>> g_cache_limits_map;
   static std::map<Device*,size_t> g_num_threads_map;
   
   struct TaskArena
@@ -131,6 +134,10 @@ namespace embree
     bvh8_factory = make_unique(new BVH8Factory(enabled_builder_cpu_features, enabled_cpu_features));
 #endif
 
+    /* record all ray queries to a file */
+    if (State::ray_dump != "")
+      ray_dump = make_unique(new RayDump(State::ray_dump));
+
     /* setup tasking system */
     initTaskingSystem(numThreads);
   }
@@ -352,9 +359,22 @@ namespace embree
     Lock<MutexSys> lock(g_mutex);
     if (bytes == 0) g_cache_size_map.erase(this);
     else            g_cache_size_map[this] = bytes;
+
+    /* the cache adapts its size only if some device configured a size range */
+    const size_t minBytes = State::tessellation_cache_min_size ? State::tessellation_cache_min_size : bytes;
+    const size_t maxBytes = State::tessellation_cache_max_size ? State::tessellation_cache_max_size : bytes;
+    if (bytes == 0) g_cache_limits_map.erase(this);
+    else            g_cache_limits_map[this] = std::make_pair(min(minBytes,bytes),max(maxBytes,bytes));
     
     size_t maxCacheSize = getMaxCacheSize();
     resizeTessellationCache(maxCacheSize);
+
+    size_t minCacheLimit = maxCacheSize, maxCacheLimit = maxCacheSize;
+    for (auto& i : g_cache_limits_map) {
+      minCacheLimit = min(minCacheLimit, i.second.first);
+      maxCacheLimit = max(maxCacheLimit, i.second.second);
+    }
+    setTessellationCacheLimits(minCacheLimit,maxCacheLimit);
 #endif
   }
 
@@ -419,6 +439,21 @@ namespace embree
     case 1000003: debug_int3 = val; return;
     }
 
+    switch (prop)
+    {
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS:
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES:
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS:
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES:
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_RESIZES:
+      if (val != 0) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "tessellation cache statistics can only get reset to 0");
+      clearTessellationCacheStats();
+      return;
+#endif
+    default: break;
+    }
+
     throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown writable property");
   }
 
@@ -572,6 +607,22 @@ namespace embree
     case RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED: return 0;
 #endif
 
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE     : return SharedLazyTessellationCache::sharedLazyTessellationCache.getSize();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS     : return getTessellationCacheStats().hits;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES   : return getTessellationCacheStats().misses;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS: return getTessellationCacheStats().evictions;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES  : return getTessellationCacheStats().flushes;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_RESIZES  : return getTessellationCacheStats().resizes;
+#else
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE     : return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS     : return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES   : return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS: return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES  : return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_RESIZES  : return 0;
+#endif
+
     default: throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown readable property"); break;
     };
   }
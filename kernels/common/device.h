@@ -11,6 +11,7 @@ namespace embree
 {
   class BVH4Factory;
   class BVH8Factory;
+  class RayDump;
   struct TaskArena;
 
   class Device : public State, public MemoryMonitorInterface
@@ -140,6 +141,9 @@ namespace embree
 #if defined(EMBREE_TARGET_SIMD8)
     std::unique_ptr<BVH8Factory> bvh8_factory;
 #endif
+
+    /*! records all ray queries if ray_dump is set */
+    std::unique_ptr<RayDump> ray_dump;
   };
 
 #if defined(EMBREE_SYCL_SUPPORT)
@@ -19,6 +19,7 @@ namespace embree
   {
     __forceinline GeometryCounts()
       : numFilterFunctions(0),
+        geometryMaskAnd(0xFFFFFFFF), geometryMaskOr(0),
         numTriangles(0), numMBTriangles(0), 
         numQuads(0), numMBQuads(0), 
         numBezierCurves(0), numMBBezierCurves(0), 
@@ -70,6 +71,8 @@ namespace embree
     {
       GeometryCounts ret;
       ret.numFilterFunctions = numFilterFunctions + rhs.numFilterFunctions;
+      ret.geometryMaskAnd = geometryMaskAnd & rhs.geometryMaskAnd;
+      ret.geometryMaskOr = geometryMaskOr | rhs.geometryMaskOr;
       ret.numTriangles = numTriangles + rhs.numTriangles;
       ret.numMBTriangles = numMBTriangles + rhs.numMBTriangles;
       ret.numQuads = numQuads + rhs.numQuads;
@@ -99,6 +102,8 @@ namespace embree
     }
 
     size_t numFilterFunctions;       //!< number of geometries with filter functions enabled
+    unsigned int geometryMaskAnd;    //!< bitwise and of the masks of all enabled geometries
+    unsigned int geometryMaskOr;     //!< bitwise or of the masks of all enabled geometries
     size_t numTriangles;             //!< number of enabled triangles
     size_t numMBTriangles;           //!< number of enabled motion blurred triangles
     size_t numQuads;                 //!< number of enabled quads
@@ -385,11 +390,21 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! sets view to derive tessellation levels from the projected edge length */
+    virtual void setTessellationView(const float* xfm, float width, float height, float rate) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Sets the maximal curve radius scale allowed by min-width feature. */
     virtual void setMaxRadiusScale(float s) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Sets the maximal number of sub-segments the builder may split each curve segment into. */
+    virtual void setMaxSubsegments(unsigned int N) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Set user data pointer. */
     virtual void setUserData(void* ptr);
       
@@ -424,6 +439,11 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Set conservative bound of the displacement. */
+    virtual void setMaxDisplacement (float maxDisplacement) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     virtual unsigned int getFirstHalfEdge(unsigned int faceID) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
@@ -507,6 +527,11 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Sets the double precision origin of the instance */
+    virtual void setTransformOrigin(const Vec3<double>& origin) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Returns the transformation of the instance */
     virtual AffineSpace3fa getTransform(float time) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
@@ -162,6 +162,20 @@ RTC_FORCEINLINE void copy_UU(const RTCRayQueryContext* context, const unsigned*
 
 #endif
 }
+
+/*
+ * Compares two instance id stacks up to the first invalid element.
+ */
+RTC_FORCEINLINE bool equal_UU(const unsigned* a, const unsigned* b)
+{
+  for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l) {
+    if (a[l] != b[l])
+      return false;
+    if (a[l] == RTC_INVALID_GEOMETRY_ID)
+      break;
+  }
+  return true;
+}
   
 template <int K>
 RTC_FORCEINLINE void copy_UV(const unsigned* src, vuint<K>* tgt)
@@ -0,0 +1,93 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ray_dump.h"
+
+namespace embree
+{
+  std::atomic<size_t> RayDump::next_id(1);
+  __thread size_t RayDump::thread_dump_id = 0;
+  __thread RayDump::ThreadBuffer* RayDump::thread_buffer = nullptr;
+
+  RayDump::RayDump (const std::string& fileName)
+    : fileName(fileName), id(next_id++)
+  {
+    file.open(fileName.c_str(), std::ios::out | std::ios::binary);
+    if (!file.is_open())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"cannot open ray dump file " + fileName);
+
+    RayDumpFormat::Header header;
+    memset(&header,0,sizeof(header));
+    header.magic = RayDumpFormat::MAGIC;
+    header.version = RayDumpFormat::VERSION;
+    header.rayBytes = sizeof(RayDumpFormat::Ray);
+    file.write((const char*)&header,sizeof(header));
+  }
+
+  RayDump::~RayDump ()
+  {
+    Lock<MutexSys> lock(mutex);
+    for (auto& buffer : buffers) {
+      file.write((const char*)buffer->rays.data(),buffer->rays.size()*sizeof(RayDumpFormat::Ray));
+      buffer->rays.clear();
+    }
+    file.close();
+  }
+
+  RayDump::ThreadBuffer* RayDump::threadBuffer()
+  {
+    if (likely(thread_dump_id == id))
+      return thread_buffer;
+
+    /* a thread may alternate between multiple devices, thus search for its buffer first */
+    Lock<MutexSys> lock(mutex);
+    const std::thread::id threadID = std::this_thread::get_id();
+    ThreadBuffer* buffer = nullptr;
+    for (auto& b : buffers)
+      if (b->threadID == threadID) buffer = b.get();
+
+    if (buffer == nullptr) {
+      buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer(threadID)));
+      buffer = buffers.back().get();
+    }
+    thread_dump_id = id;
+    thread_buffer = buffer;
+    return buffer;
+  }
+
+  void RayDump::flush(ThreadBuffer* buffer)
+  {
+    Lock<MutexSys> lock(mutex);
+    file.write((const char*)buffer->rays.data(),buffer->rays.size()*sizeof(RayDumpFormat::Ray));
+    if (!file.good())
+      throw_RTCError(RTC_ERROR_UNKNOWN,"cannot write ray dump file " + fileName);
+    buffer->rays.clear();
+  }
+
+  void RayDump::record(RayDumpFormat::Query query, unsigned int K, const int* valid, const void* rays,
+                       unsigned int query_flags, unsigned int feature_mask)
+  {
+    ThreadBuffer* buffer = threadBuffer();
+    const uint32_t* src = (const uint32_t*) rays;
+
+    for (unsigned int i=0; i<K; i++)
+    {
+      if (valid && valid[i] == 0) continue;
+
+      /* RTCRay and RTCRayN store the same 12 fields, field f of lane i is at f*K+i */
+      RayDumpFormat::Ray ray;
+      uint32_t* dst = (uint32_t*) &ray;
+      for (unsigned int f=0; f<12; f++)
+        dst[f] = src[f*K+i];
+
+      ray.query = query;
+      ray.width = K;
+      ray.query_flags = query_flags;
+      ray.feature_mask = feature_mask;
+      buffer->rays.push_back(ray);
+    }
+
+    if (buffer->rays.size() >= CHUNK_SIZE)
+      flush(buffer);
+  }
+}
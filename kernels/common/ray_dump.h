@@ -0,0 +1,59 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+#include "ray_dump_format.h"
+#include <thread>
+
+namespace embree
+{
+  /*! Records all rays passed to rtcIntersect1/4/8/16 and
+      rtcOccluded1/4/8/16 of a device to a file, to replay them later
+      with the ray_replay tutorial. Enabled with the ray_dump=<file>
+      device configuration. */
+  class RayDump
+  {
+    /* number of rays a thread buffers before appending them to the file */
+    static const size_t CHUNK_SIZE = 4096;
+
+    struct ThreadBuffer
+    {
+      ThreadBuffer (std::thread::id threadID)
+        : threadID(threadID) { rays.reserve(CHUNK_SIZE); }
+
+      std::thread::id threadID;
+      std::vector<RayDumpFormat::Ray> rays;
+    };
+
+  public:
+
+    /*! creates the file and writes the header */
+    RayDump (const std::string& fileName);
+
+    /*! appends all buffered rays to the file */
+    ~RayDump ();
+
+    /*! records the active rays of a ray packet of width K in SOA
+        layout, valid is nullptr for single rays */
+    void record(RayDumpFormat::Query query, unsigned int K, const int* valid, const void* rays,
+                unsigned int query_flags, unsigned int feature_mask);
+
+  private:
+    ThreadBuffer* threadBuffer();
+    void flush(ThreadBuffer* buffer);
+
+  private:
+    std::string fileName;
+    std::ofstream file;
+    MutexSys mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    size_t id;
+
+    /* the thread local buffer is only valid for the ray dump with matching ID */
+    static std::atomic<size_t> next_id;
+    static __thread size_t thread_dump_id;
+    static __thread ThreadBuffer* thread_buffer;
+  };
+}
@@ -0,0 +1,53 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+
+namespace embree
+{
+  /*! Layout of ray dump files recorded with the ray_dump=<file>
+      device configuration.
+
+      The file starts with a header, followed by one record for each
+      active ray of each rtcIntersect1/4/8/16 and rtcOccluded1/4/8/16
+      call. Each thread buffers its records and appends them in
+      chunks, thus rays traced by the same thread stay in order. The
+      file uses the byte order of the recording machine. */
+
+  namespace RayDumpFormat
+  {
+    static const uint32_t MAGIC = 0x59415252; // "RRAY"
+    static const uint32_t VERSION = 1;
+
+    enum Query
+    {
+      QUERY_INTERSECT = 0,    // rtcIntersect1/4/8/16
+      QUERY_OCCLUDED  = 1,    // rtcOccluded1/4/8/16
+    };
+
+    struct Header
+    {
+      uint32_t magic;         //!< MAGIC, also detects wrong endianness
+      uint32_t version;       //!< VERSION
+      uint32_t rayBytes;      //!< sizeof(Ray)
+      uint32_t reserved[5];
+    };
+
+    struct Ray
+    {
+      /* ray as passed to the query, same layout as RTCRay */
+      float org_x, org_y, org_z, tnear;
+      float dir_x, dir_y, dir_z, time;
+      float tfar;
+      uint32_t mask, id, flags;
+
+      /* query arguments */
+      uint32_t query;         //!< Query
+      uint32_t width;         //!< width of the ray packet of the query (1, 4, 8, or 16)
+      uint32_t query_flags;   //!< RTCRayQueryFlags of the query arguments
+      uint32_t feature_mask;  //!< RTCFeatureFlags of the query arguments
+    };
+  }
+}
@@ -6,6 +6,7 @@
 #include "default.h"
 #include "device.h"
 #include "scene.h"
+#include "ray_dump.h"
 #include "context.h"
 #include "../geometry/filter.h"
 #include "../../include/embree4/rtcore_ray.h"
@@ -310,6 +311,51 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcSetSceneDeferred(RTCScene hscene, const RTCBounds* bounds, RTCDeferredSceneFunction func, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneDeferred);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+#if defined(EMBREE_SYCL_SUPPORT)
+    if (dynamic_cast<DeviceGPU*>(scene->device))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"deferred scenes are not supported on GPU devices");
+#endif
+    if (bounds == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid bounds");
+    if (func == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid callback function");
+    const BBox3fa box(Vec3fa(bounds->lower_x,bounds->lower_y,bounds->lower_z),
+                      Vec3fa(bounds->upper_x,bounds->upper_y,bounds->upper_z));
+    if (!isvalid_non_empty(box))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid bounds");
+    scene->setDeferred(box,func,userPtr);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcEvictScene(RTCScene hscene)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcEvictScene);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+    scene->evictDeferred();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API bool rtcGetSceneUsed(RTCScene hscene)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneUsed);
+    RTC_VERIFY_HANDLE(hscene);
+    return scene->getAndResetUsed();
+    RTC_CATCH_END2(scene);
+    return false;
+  }
+
   RTC_API void rtcGetSceneBounds(RTCScene hscene, RTCBounds* bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -361,6 +407,80 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcSetSceneEnableStatistics (RTCScene hscene, bool enable)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneEnableStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+    scene->traversal_stat.setEnabled(enable);
+    scene->build_stat.setEnabled(enable);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcGetSceneStatistics (RTCScene hscene, RTCSceneStatistics* stats_o)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+    if (stats_o == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid destination pointer");
+
+    const TraversalStat::Counters cntrs = scene->traversal_stat.get();
+    stats_o->numRays        = cntrs.rays;
+    stats_o->numNodes       = cntrs.nodes;
+    stats_o->numLeaves      = cntrs.leaves;
+    stats_o->numFilterCalls = cntrs.filters;
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcResetSceneStatistics (RTCScene hscene)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcResetSceneStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+    scene->traversal_stat.reset();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcGetSceneBuildStatistics (RTCScene hscene, RTCSceneBuildStatistics* stats_o)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneBuildStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+    if (stats_o == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid destination pointer");
+
+    const BuildStat::Report report = scene->build_stat.get();
+    stats_o->commitTime           = report.commitTime;
+    stats_o->primRefTime          = report.phaseTime[BuildStat::PRIMREFS];
+    stats_o->presplitTime         = report.phaseTime[BuildStat::PRESPLITS];
+    stats_o->hierarchyTime        = report.phaseTime[BuildStat::HIERARCHY];
+    stats_o->topLevelTime         = report.phaseTime[BuildStat::TOPLEVEL];
+    stats_o->refitTime            = report.phaseTime[BuildStat::REFIT];
+    stats_o->numBuilds            = report.numBuilds;
+    stats_o->numPrimitives        = report.numPrimitives;
+    stats_o->numNodes             = report.numNodes;
+    stats_o->numLeaves            = report.numLeaves;
+    stats_o->nodeBytesAABB        = report.nodeBytes[BuildStat::AABB_NODES];
+    stats_o->nodeBytesMotionBlur  = report.nodeBytes[BuildStat::AABB_MB_NODES];
+    stats_o->nodeBytesOBB         = report.nodeBytes[BuildStat::OBB_NODES];
+    stats_o->nodeBytesQuantized   = report.nodeBytes[BuildStat::QUANTIZED_NODES];
+    stats_o->leafBytes            = report.leafBytes;
+    stats_o->allocatorBytesUsed   = report.bytesUsed;
+    stats_o->allocatorBytesFree   = report.bytesFree;
+    stats_o->allocatorBytesWasted = report.bytesWasted;
+    stats_o->sah                  = report.sah;
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcCollide (RTCScene hscene0, RTCScene hscene1, RTCCollideFunc callback, void* userPtr)
   {
     Scene* scene0 = (Scene*) hscene0;
@@ -529,6 +649,8 @@ RTC_NAMESPACE_BEGIN;
       rtcInitIntersectArguments(&defaultArgs);
       args = &defaultArgs;
     }
+    if (unlikely(scene->device->ray_dump))
+      scene->device->ray_dump->record(RayDumpFormat::QUERY_INTERSECT,1,nullptr,rayhit,args->flags,args->feature_mask);
     RTCRayQueryContext* user_context = args->context;
     
     RTCRayQueryContext defaultContext;
@@ -537,8 +659,17 @@ RTC_NAMESPACE_BEGIN;
       user_context = &defaultContext;
     }
     RayQueryContext context(scene,user_context,args);
+
+    RTCMultiHitBuffer* multiHit = args->multiHit;
+    if (unlikely(multiHit)) multiHit->numHits = 0;
     
     scene->intersectors.intersect(*rayhit,&context);
+
+    /* the ray reports the closest collected hit, unless a user geometry reported a closer hit */
+    if (unlikely(multiHit && multiHit->numHits && multiHit->tfar[0] <= rayhit->ray.tfar)) {
+      rayhit->ray.tfar = multiHit->tfar[0];
+      rayhit->hit = multiHit->hit[0];
+    }
 #if defined(DEBUG)
     ((RayHit*)rayhit)->verifyHit();
 #endif
@@ -603,6 +734,10 @@ RTC_NAMESPACE_BEGIN;
       rtcInitIntersectArguments(&defaultArgs);
       args = &defaultArgs;
     }
+    if (unlikely(scene->device->ray_dump))
+      scene->device->ray_dump->record(RayDumpFormat::QUERY_INTERSECT,4,valid,rayhit,args->flags,args->feature_mask);
+    if (unlikely(args->multiHit != nullptr))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"multi hit queries are only supported by rtcIntersect1");
     RTCRayQueryContext* user_context = args->context;
     
     RTCRayQueryContext defaultContext;
@@ -730,6 +865,10 @@ RTC_NAMESPACE_BEGIN;
       rtcInitIntersectArguments(&defaultArgs);
       args = &defaultArgs;
     }
+    if (unlikely(scene->device->ray_dump))
+      scene->device->ray_dump->record(RayDumpFormat::QUERY_INTERSECT,8,valid,rayhit,args->flags,args->feature_mask);
+    if (unlikely(args->multiHit != nullptr))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"multi hit queries are only supported by rtcIntersect1");
     RTCRayQueryContext* user_context = args->context;
     
     RTCRayQueryContext defaultContext;
@@ -791,6 +930,10 @@ RTC_NAMESPACE_BEGIN;
       rtcInitIntersectArguments(&defaultArgs);
       args = &defaultArgs;
     }
+    if (unlikely(scene->device->ray_dump))
+      scene->device->ray_dump->record(RayDumpFormat::QUERY_INTERSECT,16,valid,rayhit,args->flags,args->feature_mask);
+    if (unlikely(args->multiHit != nullptr))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"multi hit queries are only supported by rtcIntersect1");
     RTCRayQueryContext* user_context = args->context;
     
     RTCRayQueryContext defaultContext;
@@ -848,6 +991,8 @@ RTC_NAMESPACE_BEGIN;
       rtcInitOccludedArguments(&defaultArgs);
       args = &defaultArgs;
     }
+    if (unlikely(scene->device->ray_dump))
+      scene->device->ray_dump->record(RayDumpFormat::QUERY_OCCLUDED,1,nullptr,ray,args->flags,args->feature_mask);
     RTCRayQueryContext* user_context = args->context;
     
     RTCRayQueryContext defaultContext;
@@ -920,6 +1065,8 @@ RTC_NAMESPACE_BEGIN;
       rtcInitOccludedArguments(&defaultArgs);
       args = &defaultArgs;
     }
+    if (unlikely(scene->device->ray_dump))
+      scene->device->ray_dump->record(RayDumpFormat::QUERY_OCCLUDED,4,valid,ray,args->flags,args->feature_mask);
     RTCRayQueryContext* user_context = args->context;
     
     RTCRayQueryContext defaultContext;
@@ -1026,6 +1173,8 @@ RTC_NAMESPACE_BEGIN;
       rtcInitOccludedArguments(&defaultArgs);
       args = &defaultArgs;
     }
+    if (unlikely(scene->device->ray_dump))
+      scene->device->ray_dump->record(RayDumpFormat::QUERY_OCCLUDED,8,valid,ray,args->flags,args->feature_mask);
     RTCRayQueryContext* user_context = args->context;
     
     RTCRayQueryContext defaultContext;
@@ -1086,6 +1235,8 @@ RTC_NAMESPACE_BEGIN;
       rtcInitOccludedArguments(&defaultArgs);
       args = &defaultArgs;
     }
+    if (unlikely(scene->device->ray_dump))
+      scene->device->ray_dump->record(RayDumpFormat::QUERY_OCCLUDED,16,valid,ray,args->flags,args->feature_mask);
     RTCRayQueryContext* user_context = args->context;
     
     RTCRayQueryContext defaultContext;
@@ -1254,6 +1405,19 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryTransformOrigin(RTCGeometry hgeometry, double x, double y, double z)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTransformOrigin);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid origin");
+    geometry->setTransformOrigin(Vec3<double>(x,y,z));
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcGetGeometryTransform(RTCGeometry hgeometry, float time, RTCFormat format, void* xfm)
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1586,6 +1750,17 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
 #endif
     RTC_CATCH_END2(geometry);
   }
+
+  RTC_API void rtcSetGeometryMaxSubsegments(RTCGeometry hgeometry, unsigned int maxSubsegments)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryMaxSubsegments);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->setMaxSubsegments(maxSubsegments);
+    RTC_CATCH_END2(geometry);
+  }
   
   RTC_API void rtcSetGeometryMask (RTCGeometry hgeometry, unsigned int mask) 
   {
@@ -1735,6 +1910,17 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryTessellationView (RTCGeometry hgeometry, const float* xfm, float width, float height, float tessellationRate)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTessellationView);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->setTessellationView(xfm,width,height,tessellationRate);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryUserData (RTCGeometry hgeometry, void* ptr) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1795,6 +1981,17 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryMaxDisplacement (RTCGeometry hgeometry, float maxDisplacement)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryMaxDisplacement);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->setMaxDisplacement(maxDisplacement);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryIntersectFunction (RTCGeometry hgeometry, RTCIntersectFunctionN intersect) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
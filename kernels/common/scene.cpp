@@ -45,6 +45,8 @@ namespace embree
       flags_modified(true), enabled_geometry_types(0),
       scene_flags(RTC_SCENE_FLAG_NONE),
       quality_flags(RTC_BUILD_QUALITY_MEDIUM),
+      deferred(false), deferredPopulated(false), deferredBounds(empty), deferredFunc(nullptr), deferredUserPtr(nullptr),
+      deferredBuilt(false), deferredUsed(false),
       modified(true),
       taskGroup(new TaskGroup()),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0)
@@ -188,7 +190,10 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4")       accels_add(device->bvh4_factory->BVH4Triangle4 (this));
     else if (device->tri_accel == "bvh4.triangle4v")      accels_add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels_add(device->bvh4_factory->BVH4Triangle4i(this));
+    else if (device->tri_accel == "qbvh4.triangle4")      accels_add(device->bvh4_factory->BVH4QuantizedTriangle4(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels_add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh4.triangle_pairs4v") accels_add(device->bvh4_factory->BVH4TrianglePair4v(this));
+    else if (device->tri_accel == "qbvh4.triangle_pairs4v") accels_add(device->bvh4_factory->BVH4QuantizedTrianglePair4v(this));
 
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->tri_accel == "bvh8.triangle4")       accels_add(device->bvh8_factory->BVH8Triangle4 (this));
@@ -765,8 +770,13 @@ namespace embree
       enabled_geometry_types = new_enabled_geometry_types;
     }
     
-    /* select fast code path if no filter function is present */
-    accels_select(hasFilterFunction());
+    /* select fast code path if no filter function is present and all
+       geometries share the same mask */
+#if defined(EMBREE_RAY_MASK)
+    accels_select(hasFilterFunction(), !hasUniformGeometryMask());
+#else
+    accels_select(hasFilterFunction(), false);
+#endif
   
     /* build all hierarchies of this scene */
     accels_build();
@@ -798,6 +808,9 @@ namespace embree
   {
     checkIfModifiedAndSet();
     if (!isModified()) return;
+
+    build_stat.reset();
+    const double t0 = build_stat.startPhase();
     
     /* print scene statistics */
     if (device->verbosity(2))
@@ -818,6 +831,8 @@ namespace embree
             geometries[i]->addElementsToCount (c);
             c.numFilterFunctions += (int) geometries[i]->hasArgumentFilterFunctions();
             c.numFilterFunctions += (int) geometries[i]->hasGeometryFilterFunctions();
+            c.geometryMaskAnd &= geometries[i]->mask;
+            c.geometryMaskOr  |= geometries[i]->mask;
           }
         }
         return c;
@@ -832,6 +847,12 @@ namespace embree
 #endif
       build_cpu_accels();
 
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    /* give the tessellation cache a chance to shrink if the working set got smaller */
+    if (world.numSubdivPatches || world.numMBSubdivPatches)
+      adaptTessellationCache();
+#endif
+
     /* call postCommit function of each geometry */
     parallel_for(geometries.size(), [&] ( const size_t i ) {
         if (geometries[i] && geometries[i]->isEnabled()) {
@@ -841,6 +862,9 @@ namespace embree
         }
       });
 
+    if (build_stat.isGathering())
+      build_stat.setCommitTime(getSeconds()-t0);
+
     setModified(false);
   }
 
@@ -1014,6 +1038,64 @@ namespace embree
   }
 #endif
 
+  void Scene::setDeferred(const BBox3fa& bounds, RTCDeferredSceneFunction func, void* userPtr)
+  {
+    Lock<MutexSys> lock(deferredMutex);
+    deferred = true;
+    deferredBounds = bounds;
+    deferredFunc = func;
+    deferredUserPtr = userPtr;
+
+    /* the instance bounds of parent scenes are computed from the user provided bounds until the scene got built */
+    if (!deferredBuilt)
+      this->bounds = LBBox3fa(bounds);
+  }
+
+  void Scene::buildDeferred()
+  {
+    DeviceEnterLeave enterleave((RTCScene)this);
+
+    /* the first thread populates the scene */
+    {
+      Lock<MutexSys> lock(deferredMutex);
+      if (deferredBuilt) return;
+      if (!deferredPopulated) {
+        deferredFunc(deferredUserPtr,(RTCScene)this,RTC_DEFERRED_SCENE_EVENT_BUILD);
+        deferredPopulated = true;
+      }
+    }
+
+    /* all threads entering the scene concurrently cooperate on the build */
+    commit(true);
+    deferredBuilt.store(true, std::memory_order_release);
+  }
+
+  void Scene::evictDeferred()
+  {
+    if (!deferred)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene is not deferred");
+
+    {
+      Lock<MutexSys> buildLock(buildMutex);
+      Lock<MutexSys> lock(deferredMutex);
+      if (!deferredBuilt) return;
+
+      accels_init();
+      intersectors = Accel::Intersectors(missing_rtcCommit);
+      flags_modified = true;
+      setModified(true);
+      this->bounds = LBBox3fa(deferredBounds);
+      deferredPopulated = false;
+      deferredBuilt.store(false, std::memory_order_release);
+    }
+
+    deferredFunc(deferredUserPtr,(RTCScene)this,RTC_DEFERRED_SCENE_EVENT_EVICT);
+  }
+
+  bool Scene::getAndResetUsed() {
+    return deferredUsed.exchange(false);
+  }
+
   void Scene::setProgressMonitorFunction(RTCProgressMonitorFunction func, void* ptr) 
   {
     progress_monitor_function = func;
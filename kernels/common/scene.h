@@ -192,6 +192,28 @@ namespace embree
     void commit_task ();
     void build () {}
 
+    /* deferred scenes get populated and committed on first access */
+    void setDeferred(const BBox3fa& bounds, RTCDeferredSceneFunction func, void* userPtr);
+    void buildDeferred();
+    void evictDeferred();
+    bool getAndResetUsed();
+
+    /* determines if scene is deferred */
+    __forceinline bool isDeferred() const { return deferred; }
+
+    /* builds a deferred scene before a ray or point query enters it */
+    __forceinline void buildOnDemand()
+    {
+      if (likely(!deferred)) return;
+
+      /* only write the used flag when not set yet, to not invalidate the cache line for each ray */
+      if (!deferredUsed.load(std::memory_order_relaxed))
+        deferredUsed.store(true, std::memory_order_relaxed);
+
+      if (unlikely(!deferredBuilt.load(std::memory_order_acquire)))
+        buildDeferred();
+    }
+
     /* return number of geometries */
     __forceinline size_t size() const { return geometries.size(); }
     
@@ -268,6 +290,16 @@ namespace embree
     __forceinline bool hasFilterFunction() {
       return hasArgumentFilterFunction() || hasGeometryFilterFunction();
     }
+
+    /* rays whose mask does not overlap this value cannot hit any geometry of the scene */
+    __forceinline unsigned int getGeometryMask() const {
+      return world.geometryMaskOr;
+    }
+
+    /* if all geometries share the same mask, the per-hit mask test reduces to a per-ray test */
+    __forceinline bool hasUniformGeometryMask() const {
+      return world.geometryMaskAnd == world.geometryMaskOr;
+    }
     
     void* createQBVH6Accel();
 
@@ -290,6 +322,17 @@ namespace embree
     MutexSys buildMutex;
     MutexSys geometriesMutex;
 
+  private:
+    /* state of deferred scenes */
+    bool deferred;
+    bool deferredPopulated;
+    BBox3fa deferredBounds;
+    RTCDeferredSceneFunction deferredFunc;
+    void* deferredUserPtr;
+    std::atomic<bool> deferredBuilt;
+    std::atomic<bool> deferredUsed;
+    MutexSys deferredMutex;
+
 #if defined(EMBREE_SYCL_SUPPORT)
   public:
     BBox3f hwaccel_bounds = empty;
@@ -318,6 +361,10 @@ namespace embree
     void progressMonitor(double nprims);
     void setProgressMonitorFunction(RTCProgressMonitorFunction func, void* ptr);
 
+  public:
+    TraversalStat traversal_stat;       //!< runtime traversal statistics
+    BuildStat build_stat;               //!< build statistics of the last commit
+
   private:
     GeometryCounts world;               //!< counts for geometry
 
@@ -251,6 +251,15 @@ namespace embree
     maxRadiusScale = s;
   }
 
+  void CurveGeometry::setMaxSubsegments(unsigned int N)
+  {
+    if (N < 1 || N > MAX_SUBSEGMENTS)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"maximal number of sub-segments has to be in the range [1,8]");
+    
+    maxSubsegments = N;
+    Geometry::update();
+  }
+
   void CurveGeometry::addElementsToCount (GeometryCounts & counts) const 
   {
     if (numTimeSteps == 1) counts.numBezierCurves += numPrimitives; 
@@ -367,6 +376,10 @@ namespace embree
     if (getCurveBasis() == GTY_BASIS_HERMITE)
       tangents0 = tangents[0];
 
+    /* sub-segment codes are only stored for static curves that leave the upper primID bits unused */
+    const bool split = maxSubsegments > 1 && numTimeSteps == 1 && size_t(numPrimitives) < (size_t(1) << SUBSEGMENT_SHIFT);
+    primIDMask = split ? (1u << SUBSEGMENT_SHIFT)-1 : 0xFFFFFFFF;
+
     Geometry::commit();
   }
 
@@ -392,6 +405,7 @@ namespace embree
       using CurveInterfaceT<Curve>::fnumTimeSegments;
       using CurveInterfaceT<Curve>::numTimeSegments;
       using CurveInterfaceT<Curve>::tessellationRate;
+      using CurveInterfaceT<Curve>::clampedSegmentRange;
 
       using CurveInterfaceT<Curve>::valid;
       using CurveInterfaceT<Curve>::numVertices;
@@ -406,15 +420,22 @@ namespace embree
       CurveGeometryISA (Device* device, Geometry::GType gtype)
         : CurveInterfaceT<Curve>(device,gtype) {}
 
-      LinearSpace3fa computeAlignedSpace(const size_t primID) const
+      LinearSpace3fa computeAlignedSpace(const size_t id) const
       {
         Vec3fa axisz(0,0,1);
         Vec3fa axisy(0,1,0);
         
-        const Curve3ff curve = getCurveScaledRadius(primID);
-        const Vec3fa p0 = curve.begin();
-        const Vec3fa p3 = curve.end();
-        const Vec3fa d0 = curve.eval_du(0.0f);
+        const unsigned int code = this->segmentCode(unsigned(id));
+        const Curve3ff curve = getCurveScaledRadius(this->segmentID(unsigned(id)));
+        Vec3fa p0 = curve.begin();
+        Vec3fa p3 = curve.end();
+        Vec3fa d0 = curve.eval_du(0.0f);
+        if (unlikely(code)) {
+          const BBox1f u = clampedSegmentRange(code);
+          p0 = curve.eval(u.lower);
+          p3 = curve.eval(u.upper);
+          d0 = curve.eval_du(u.lower);
+        }
         //const Vec3fa d1 = curve.eval_du(1.0f);
         const Vec3fa axisz_ = normalize(p3 - p0);
         const Vec3fa axisy_ = cross(axisz_,d0);
@@ -460,9 +481,14 @@ namespace embree
         return frame(axisz);
       }
       
-      Vec3fa computeDirection(unsigned int primID) const
+      Vec3fa computeDirection(unsigned int id) const
       {
-        const Curve3ff c = getCurveScaledRadius(primID);
+        const unsigned int code = this->segmentCode(id);
+        const Curve3ff c = getCurveScaledRadius(this->segmentID(id));
+        if (unlikely(code)) {
+          const BBox1f u = clampedSegmentRange(code);
+          return Vec3fa(c.eval(u.upper)) - Vec3fa(c.eval(u.lower));
+        }
         const Vec3fa p0 = c.begin();
         const Vec3fa p3 = c.end();
         const Vec3fa axis1 = p3 - p0;
@@ -511,6 +537,57 @@ namespace embree
         }
       }
 
+      /*! calculates bounding box of the [u.lower,u.upper] part of a curve, the
+       *  intersectors clip the curve to that range and intersect the result */
+      __forceinline BBox3fa segmentBounds(const Curve3ff& curve, const BBox1f& u) const
+      {
+        const Curve3ff segment = clipCurve(curve,u);
+        if (ctype == Geometry::GTY_SUBTYPE_FLAT_CURVE)
+          return enlarge_bounds(segment.accurateFlatBounds(tessellationRate));
+        return enlarge_bounds(segment.accurateRoundBounds());
+      }
+
+      /*! calculates the oriented curve of the [u.lower,u.upper] part of a curve */
+      __forceinline TensorLinearCubicBezierSurface3fa getOrientedSegmentScaledRadius(size_t i, const BBox1f& u, size_t itime = 0) const
+      {
+        const Curve3ff center = clipCurve(getCurveScaledRadius(i,itime),u);
+        const Curve3fa normal = clipCurve(this->getNormalCurve(i,itime),u);
+        return TensorLinearCubicBezierSurface3fa::fromCenterAndNormalCurve(center,normal);
+      }
+
+      /*! calculates bounding box of the i'th curve or its encoded sub-segment */
+      __forceinline BBox3fa segmentBounds(size_t id) const
+      {
+        const unsigned int code = this->segmentCode(unsigned(id));
+        const unsigned int i = this->segmentID(unsigned(id));
+        if (likely(code == 0)) return bounds(i);
+        if (ctype == Geometry::GTY_SUBTYPE_ORIENTED_CURVE)
+          return enlarge_bounds(getOrientedSegmentScaledRadius(i,clampedSegmentRange(code)).accurateBounds());
+        return segmentBounds(getCurveScaledRadius(i),clampedSegmentRange(code));
+      }
+
+      /*! calculates bounding box of the i'th curve or its encoded sub-segment */
+      __forceinline BBox3fa segmentBounds(const LinearSpace3fa& space, size_t id) const
+      {
+        const unsigned int code = this->segmentCode(unsigned(id));
+        const unsigned int i = this->segmentID(unsigned(id));
+        if (likely(code == 0)) return bounds(space,i);
+        if (ctype == Geometry::GTY_SUBTYPE_ORIENTED_CURVE)
+          return enlarge_bounds(getOrientedSegmentScaledRadius(i,clampedSegmentRange(code)).xfm(space).accurateBounds());
+        return segmentBounds(getCurveScaledRadius(space,i),clampedSegmentRange(code));
+      }
+
+      /*! calculates bounding box of the i'th curve or its encoded sub-segment */
+      __forceinline BBox3fa segmentBounds(const Vec3fa& ofs, const float scale, const float r_scale0, const LinearSpace3fa& space, size_t id, size_t itime) const
+      {
+        const unsigned int code = this->segmentCode(unsigned(id));
+        const unsigned int i = this->segmentID(unsigned(id));
+        if (likely(code == 0)) return bounds(ofs,scale,r_scale0,space,i,itime);
+        if (ctype == Geometry::GTY_SUBTYPE_ORIENTED_CURVE)
+          return enlarge_bounds(getOrientedSegmentScaledRadius(i,clampedSegmentRange(code),itime).xfm(space,ofs,scale).accurateBounds());
+        return segmentBounds(getCurveScaledRadius(ofs,scale,r_scale0,space,i,itime),clampedSegmentRange(code));
+      }
+
       /*! calculates the linear bounds of the i'th primitive for the specified time range */
       __forceinline LBBox3fa linearBounds(size_t primID, const BBox1f& dt) const {
         return LBBox3fa([&] (size_t itime) { return bounds(primID, itime); }, dt, this->time_range, fnumTimeSegments);
@@ -573,15 +650,15 @@ namespace embree
       }
      
       BBox3fa vbounds(size_t i) const {
-        return bounds(i);
+        return segmentBounds(i);
       }
       
       BBox3fa vbounds(const LinearSpace3fa& space, size_t i) const {
-        return bounds(space,i);
+        return segmentBounds(space,i);
       }
 
       BBox3fa vbounds(const Vec3fa& ofs, const float scale, const float r_scale0, const LinearSpace3fa& space, size_t i, size_t itime = 0) const {
-        return bounds(ofs,scale,r_scale0,space,i,itime);
+        return segmentBounds(ofs,scale,r_scale0,space,i,itime);
       }
 
       LBBox3fa vlinearBounds(size_t primID, const BBox1f& time_range) const {
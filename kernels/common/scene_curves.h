@@ -15,6 +15,15 @@
 
 namespace embree
 {
+  /*! returns the [u.lower,u.upper] part of a curve in the basis of the curve */
+  template<template<typename Ty> class Curve, typename Vertex>
+  __forceinline Curve<Vertex> clipCurve(const Curve<Vertex>& curve, const BBox1f& u)
+  {
+    BezierCurveT<Vertex> bezier; convert(curve,bezier);
+    Curve<Vertex> ocurve; convert(bezier.clip(Interval1f(u.lower,u.upper)),ocurve);
+    return ocurve;
+  }
+
   /*! represents an array of bicubic bezier curves */
   struct CurveGeometry : public Geometry
   {
@@ -37,6 +46,7 @@ namespace embree
     bool verify();
     void setTessellationRate(float N);
     void setMaxRadiusScale(float s);
+    void setMaxSubsegments(unsigned int N);
     void addElementsToCount (GeometryCounts & counts) const;
 
   public:
@@ -51,6 +61,58 @@ namespace embree
       return curves[i];
     }
 
+    /*! returns the curve index of an encoded sub-segment ID */
+    __forceinline unsigned int segmentID(unsigned int primID) const {
+      return primID & primIDMask;
+    }
+
+    /*! returns the sub-segment code (heap index, 0 for unsplit curves) of an encoded sub-segment ID */
+    __forceinline unsigned int segmentCode(unsigned int primID) const {
+      return (primID & ~primIDMask) >> SUBSEGMENT_SHIFT;
+    }
+
+    /*! encodes sub-segment code into the ID of a curve */
+    static __forceinline unsigned int encodeSegment(unsigned int primID, unsigned int code) {
+      return primID | (code << SUBSEGMENT_SHIFT);
+    }
+
+    /*! returns the parametric range of a sub-segment code, the first
+     *  and last sub-segment are open towards the curve ends */
+    static __forceinline BBox1f segmentRange(unsigned int code)
+    {
+      if (likely(code == 0)) return BBox1f(neg_inf,pos_inf);
+      const unsigned int level = bsr(code);
+      const unsigned int index = code - (1 << level);
+      const float scale = 1.0f/float(1 << level);
+      const float u0 = index == 0 ? float(neg_inf) : float(index+0)*scale;
+      const float u1 = index+1 == (1u << level) ? float(pos_inf) : float(index+1)*scale;
+      return BBox1f(u0,u1);
+    }
+
+    /*! returns the parametric range of a sub-segment code clamped to the curve */
+    static __forceinline BBox1f clampedSegmentRange(unsigned int code)
+    {
+      const BBox1f u = segmentRange(code);
+      return BBox1f(max(u.lower,0.0f),min(u.upper,1.0f));
+    }
+
+    /*! clips the control points of a curve of the given basis to the range of a sub-segment code */
+    template<typename Curve, typename Vertex>
+    static __forceinline void clipSegment(unsigned int code, Vertex& v0, Vertex& v1, Vertex& v2, Vertex& v3)
+    {
+      const Curve curve = clipCurve(Curve(v0,v1,v2,v3),clampedSegmentRange(code));
+      v0 = curve.v0; v1 = curve.v1; v2 = curve.v2; v3 = curve.v3;
+    }
+
+    /*! clips the end points and tangents of a hermite curve to the range of a sub-segment code */
+    template<typename Vertex>
+    static __forceinline void clipHermiteSegment(unsigned int code, Vertex& p0, Vertex& t0, Vertex& p1, Vertex& t1)
+    {
+      const HermiteCurveT<Vertex> curve = clipCurve(HermiteCurveT<Vertex>(p0,t0,p1,t1),clampedSegmentRange(code));
+      p0 = curve.v0; t0 = 3.0f*(curve.v1-curve.v0);
+      p1 = curve.v3; t1 = 3.0f*(curve.v3-curve.v2);
+    }
+
     /*! returns i'th vertex of the first time step */
     __forceinline Vec3ff vertex(size_t i) const {
       return vertices0[i];
@@ -409,6 +471,12 @@ namespace embree
     Device::vector<BufferView<char>> vertexAttribs = device; //!< user buffers
     int tessellationRate;                   //!< tessellation rate for flat curve
     float maxRadiusScale = 1.0;             //!< maximal min-width scaling of curve radii
+    unsigned int maxSubsegments = 1;        //!< maximal number of sub-segments the builder may split a curve into
+    unsigned int primIDMask = 0xFFFFFFFF;   //!< masks out the sub-segment code of primIDs stored in the BVH
+
+    static const unsigned int SUBSEGMENT_SHIFT = 28;          //!< primIDs of split curves store the sub-segment code in the upper bits
+    static const unsigned int MAX_SUBSEGMENTS_LOG = 3;        //!< sub-segment codes are heap indices of a binary tree of this depth
+    static const unsigned int MAX_SUBSEGMENTS = 1 << MAX_SUBSEGMENTS_LOG;
   };
 
   namespace isa
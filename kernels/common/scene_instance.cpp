@@ -12,6 +12,8 @@ namespace embree
     : Geometry(device,Geometry::GTY_INSTANCE_CHEAP,1,numTimeSteps)
     , object(object)
     , local2world(nullptr)
+    , origin(zero)
+    , hasOrigin(false)
   {
     if (object) object->refInc();
     gsubtype = GTY_SUBTYPE_INSTANCE_LINEAR;
@@ -117,12 +119,18 @@ namespace embree
     Geometry::update();
   }
 
+  void Instance::setTransformOrigin(const Vec3<double>& origin_in)
+  {
+    origin = origin_in;
+    hasOrigin = origin.x != 0.0 || origin.y != 0.0 || origin.z != 0.0;
+    Geometry::update();
+  }
+
   AffineSpace3fa Instance::getTransform(float time)
   {
-    if (likely(numTimeSteps <= 1))
-      return getLocal2World();
-    else
-      return getLocal2World(time);
+    AffineSpace3fa xfm = numTimeSteps <= 1 ? getLocal2World() : getLocal2World(time);
+    if (unlikely(hasOrigin)) xfm.p += Vec3fa(float(origin.x),float(origin.y),float(origin.z));
+    return xfm;
   }
 
   AffineSpace3fa Instance::getTransform(size_t i, float time)
@@ -130,10 +138,7 @@ namespace embree
     if (i != 0)
       throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "instance has only primitive 0.");
 
-    if (likely(numTimeSteps <= 1))
-      return getLocal2World();
-    else
-      return getLocal2World(time);
+    return getTransform(time);
   }
 
   void Instance::setMask (unsigned mask)
@@ -356,7 +361,7 @@ namespace embree
       {
         const float f = (float(i) / geom_time_segments - time_range.lower) / time_range.size();
         const BBox3fa bt = lerp(b0, b1, f);
-        const BBox3fa bi = bounds(0, i);
+        const BBox3fa bi = localBounds(i);
         const Vec3fa dlower = min(bi.lower-bt.lower, Vec3fa(zero));
         const Vec3fa dupper = max(bi.upper-bt.upper, Vec3fa(zero));
         b0.lower += dlower; b1.lower += dlower;
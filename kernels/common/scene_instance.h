@@ -49,6 +49,7 @@ namespace embree
     virtual void setInstancedScene(const Ref<Scene>& scene) override;
     virtual void setTransform(const AffineSpace3fa& local2world, unsigned int timeStep) override;
     virtual void setQuaternionDecomposition(const AffineSpace3ff& qd, unsigned int timeStep) override;
+    virtual void setTransformOrigin(const Vec3<double>& origin) override;
     virtual AffineSpace3fa getTransform(float time) override;
     virtual AffineSpace3fa getTransform(size_t, float time) override;
     virtual void setMask (unsigned mask) override;
@@ -62,8 +63,8 @@ namespace embree
     __forceinline BBox3fa bounds(size_t i) const {
       assert(i == 0);
       if (unlikely(gsubtype == GTY_SUBTYPE_INSTANCE_QUATERNION))
-        return xfmBounds(quaternionDecompositionToAffineSpace(local2world[0]),object->bounds.bounds());
-      return xfmBounds(local2world[0],object->bounds.bounds());
+        return addOrigin(xfmBounds(quaternionDecompositionToAffineSpace(local2world[0]),object->bounds.bounds()));
+      return addOrigin(xfmBounds(local2world[0],object->bounds.bounds()));
     }
 
     /*! gets the bounds of the instanced scene */
@@ -71,19 +72,24 @@ namespace embree
       return object->getBounds(timeStep(itime));
     }
 
-     /*! calculates the bounds of instance */
-    __forceinline BBox3fa bounds(size_t i, size_t itime) const {
-      assert(i == 0);
+    /*! calculates the bounds of instance at the itime'th time step, without the origin */
+    __forceinline BBox3fa localBounds(size_t itime) const {
       if (unlikely(gsubtype == GTY_SUBTYPE_INSTANCE_QUATERNION))
         return xfmBounds(quaternionDecompositionToAffineSpace(local2world[itime]),getObjectBounds(itime));
       return xfmBounds(local2world[itime],getObjectBounds(itime));
     }
 
+     /*! calculates the bounds of instance */
+    __forceinline BBox3fa bounds(size_t i, size_t itime) const {
+      assert(i == 0);
+      return addOrigin(localBounds(itime));
+    }
+
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
     __forceinline LBBox3fa linearBounds(size_t i, const BBox1f& dt) const {
       assert(i == 0);
       LBBox3fa lbbox = nonlinearBounds(dt, time_range, fnumTimeSegments);
-      return lbbox;
+      return LBBox3fa(addOrigin(lbbox.bounds0),addOrigin(lbbox.bounds1));
     }
 
     /*! calculates the build bounds of the i'th item, if it's valid */
@@ -160,6 +166,50 @@ namespace embree
       return getWorld2LocalLerp<K>(valid, t);
     }
 
+    /*! rebases a world space point relative to the origin of the instance, the subtraction is performed in double precision */
+    template<typename V>
+    __forceinline V rebase(const V& p) const
+    {
+      if (likely(!hasOrigin)) return p;
+      return V(float(double(p.x)-origin.x),float(double(p.y)-origin.y),float(double(p.z)-origin.z));
+    }
+
+    template<int K>
+    __forceinline Vec3vf<K> rebase(const vbool<K>& valid, const Vec3vf<K>& p) const
+    {
+      if (likely(!hasOrigin)) return p;
+      Vec3vf<K> r = p;
+      for (size_t bits=movemask(valid); bits!=0; ) {
+        const size_t k = bscf(bits);
+        r.x[k] = float(double(p.x[k])-origin.x);
+        r.y[k] = float(double(p.y[k])-origin.y);
+        r.z[k] = float(double(p.z[k])-origin.z);
+      }
+      return r;
+    }
+
+    /*! translates local space bounds of the instance by its origin, rounding outwards */
+    __forceinline BBox3fa addOrigin(const BBox3fa& b) const
+    {
+      if (likely(!hasOrigin) || !isvalid(b)) return b;
+      const Vec3fa lower(nextafterf(float(double(b.lower.x)+origin.x),neg_inf),
+                         nextafterf(float(double(b.lower.y)+origin.y),neg_inf),
+                         nextafterf(float(double(b.lower.z)+origin.z),neg_inf));
+      const Vec3fa upper(nextafterf(float(double(b.upper.x)+origin.x),pos_inf),
+                         nextafterf(float(double(b.upper.y)+origin.y),pos_inf),
+                         nextafterf(float(double(b.upper.z)+origin.z),pos_inf));
+      return BBox3fa(lower,upper);
+    }
+
+    /*! adds the origin to the transformations as reported to the user, in single precision */
+    __forceinline void addOrigin(AffineSpace3fa& local2world, AffineSpace3fa& world2local) const
+    {
+      if (likely(!hasOrigin)) return;
+      const Vec3fa o(float(origin.x),float(origin.y),float(origin.z));
+      local2world.p += o;
+      world2local.p -= xfmVector(world2local,o);
+    }
+
     __forceinline float projectedPrimitiveArea(const size_t i) const {
       return area(bounds(i));
     }
@@ -221,6 +271,8 @@ namespace embree
     Accel* object;                 //!< pointer to instanced acceleration structure
     AffineSpace3ff* local2world;   //!< transformation from local space to world space for each timestep (either normal matrix or quaternion decomposition)
     AffineSpace3fa world2local0;   //!< transformation from world space to local space for timestep 0
+    Vec3<double> origin;           //!< double precision world space translation applied after local2world
+    bool hasOrigin;                //!< true if origin is not zero
   };
 
   namespace isa
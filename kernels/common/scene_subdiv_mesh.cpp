@@ -32,6 +32,7 @@ namespace embree
   SubdivMesh::SubdivMesh (Device* device)
     : Geometry(device,GTY_SUBDIV_MESH,0,1), 
       displFunc(nullptr),
+      maxDisplacement(inf),
       tessellationRate(2.0f),
       numHalfEdges(0),
       faceStartEdge(device,0),
@@ -370,12 +371,39 @@ namespace embree
     this->displFunc = func;
   }
 
+  void SubdivMesh::setMaxDisplacement (float maxDisplacement) 
+  {
+    if (!(maxDisplacement >= 0.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid maximal displacement");
+    
+    this->maxDisplacement = maxDisplacement;
+    Geometry::update();
+  }
+
   void SubdivMesh::setTessellationRate(float N)
   {
     tessellationRate = N;
     levels.setModified();
   }
 
+  void SubdivMesh::setTessellationView(const float* xfm, float width, float height, float rate)
+  {
+    if (xfm == nullptr) {
+      tessellationView.enabled = false;
+      levels.setModified();
+      return;
+    }
+
+    if (!(width > 0.0f && height > 0.0f && rate > 0.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid tessellation view");
+
+    tessellationView.enabled = true;
+    for (size_t i=0; i<4; i++)
+      tessellationView.xfm[i] = Vec4f(xfm[4*i+0],xfm[4*i+1],xfm[4*i+2],xfm[4*i+3]);
+    tessellationView.scale = Vec2f(0.5f*width*rate,0.5f*height*rate);
+    levels.setModified();
+  }
+
   __forceinline uint64_t pair64(unsigned int x, unsigned int y) 
   {
     if (x<y) std::swap(x,y);
@@ -457,7 +485,7 @@ namespace embree
 	  edge->opposite_half_edge_ofs = 0;
 	  edge->edge_crease_weight     = mesh->edgeCreaseMap->edgeCreaseMap.lookup(key0,0.0f);
 	  edge->vertex_crease_weight   = mesh->vertexCreaseMap->vertexCreaseMap.lookup(startVertex0,0.0f);
-	  edge->edge_level             = mesh->getEdgeLevel(e+de);
+	  edge->edge_level             = mesh->getEdgeLevel(e+de,startVertex0,endVertex0);
           edge->patch_type             = HalfEdge::COMPLEX_PATCH; // type gets updated below
           edge->vertex_type            = HalfEdge::REGULAR_VERTEX;
 
@@ -579,7 +607,7 @@ namespace embree
     /* calculate which data to update */
     const bool updateEdgeCreases   = mesh->topology[0].vertexIndices.isLocalModified() || mesh->edge_creases.isLocalModified()   || mesh->edge_crease_weights.isLocalModified();
     const bool updateVertexCreases = mesh->topology[0].vertexIndices.isLocalModified() || mesh->vertex_creases.isLocalModified() || mesh->vertex_crease_weights.isLocalModified(); 
-    const bool updateLevels = mesh->levels.isLocalModified();
+    const bool updateLevels = mesh->edgeLevelsModified();
 
     /* parallel loop over all half edges */
     parallel_for( size_t(0), mesh->numHalfEdges, size_t(4096), [&](const range<size_t>& r) 
@@ -589,7 +617,7 @@ namespace embree
 	HalfEdge& edge = halfEdges[i];
 
 	if (updateLevels)
-	  edge.edge_level = mesh->getEdgeLevel(i); 
+	  edge.edge_level = mesh->getEdgeLevel(i,halfEdgesGeom[i].vtx_index,halfEdgesGeom[i].next()->vtx_index); 
         
 	if (updateEdgeCreases) {
 	  if (edge.hasOpposite()) // leave weight at inf for borders
@@ -646,7 +674,7 @@ namespace embree
     update |= mesh->edge_crease_weights.isLocalModified();
     update |= mesh->vertex_creases.isLocalModified();
     update |= mesh->vertex_crease_weights.isLocalModified(); 
-    update |= mesh->levels.isLocalModified();
+    update |= mesh->edgeLevelsModified();
 
     /* now either recalculate or update the half edges */
     if (recalculate) calculateHalfEdges();
@@ -953,33 +981,73 @@ namespace embree
       }
       
       const int* valid = (const int*) valid_i;
-      
-      for (size_t i=0; i<N; i+=4) 
+
+      typedef isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4> PatchEvalBatch;
+      static const size_t B = PatchEvalBatch::MAX_BATCH_SIZE;
+      __aligned(16) float uu[B], vv[B];
+      __aligned(16) float P_t[4*B], dPdu_t[4*B], dPdv_t[4*B], ddPdudu_t[4*B], ddPdvdv_t[4*B], ddPdudv_t[4*B];
+
+      /* the queries are processed in chunks, thus the order buffer lives on the stack */
+      static const unsigned int C = 4*B;
+      unsigned int order[C];
+
+      for (unsigned int c=0; c<N; c+=C)
       {
-        vbool4 valid1 = vint4(int(i))+vint4(step) < vint4(int(N));
-        if (valid) valid1 &= vint4::loadu(&valid[i]) == vint4(-1);
-        if (none(valid1)) continue;
-        
-        const vuint4 primID = vuint4::loadu(&primIDs[i]);
-        const vfloat4 uu = vfloat4::loadu(&u[i]);
-        const vfloat4 vv = vfloat4::loadu(&v[i]);
-        
-        foreach_unique(valid1,primID,[&](const vbool4& valid1, const unsigned int primID)
-                       {
-                         for (unsigned int j=0; j<valueCount; j+=4) 
-                         {
-                           const size_t M = min(4u,valueCount-j);
-                           isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,j/4,stride)),commitCounter,
-                                                                            topo->getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
-                                                                            P ? P+j*N+i : nullptr,
-                                                                            dPdu ? dPdu+j*N+i : nullptr,
-                                                                            dPdv ? dPdv+j*N+i : nullptr,
-                                                                            ddPdudu ? ddPdudu+j*N+i : nullptr,
-                                                                            ddPdvdv ? ddPdvdv+j*N+i : nullptr,
-                                                                            ddPdudv ? ddPdudv+j*N+i : nullptr,
-                                                                            N,M);
-                         }
-                       });
+        /* sort valid queries of the chunk by primitive to look up each patch only once per batch, skipping the sort for already ordered queries */
+        size_t numQueries = 0;
+        bool ordered = true;
+        for (unsigned int i=c; i<min(c+C,N); i++) {
+          if (valid && valid[i] != -1) continue;
+          ordered &= numQueries == 0 || primIDs[order[numQueries-1]] <= primIDs[i];
+          order[numQueries++] = i;
+        }
+
+        if (!ordered) {
+          std::sort(order,order+numQueries,[&] (const unsigned int a, const unsigned int b) {
+              return primIDs[a] < primIDs[b] || (primIDs[a] == primIDs[b] && a < b);
+            });
+        }
+
+        for (size_t b=0; b<numQueries; )
+        {
+          /* gather the (u,v) pairs of up to B queries on the same patch */
+          const unsigned int primID = primIDs[order[b]];
+          size_t n = 0;
+          for (; b+n<numQueries && n<B && primIDs[order[b+n]] == primID; n++) {
+            uu[n] = u[order[b+n]];
+            vv[n] = v[order[b+n]];
+          }
+          for (size_t q=n; q<((n+3)&~size_t(3)); q++)
+            uu[q] = vv[q] = 0.0f;
+
+          /* evaluate all queries of the batch in SIMD and scatter the results */
+          auto scatter = [&] (float* dst, const float* src, const unsigned int j, const size_t M) {
+            for (size_t m=0; m<M; m++)
+              for (size_t q=0; q<n; q++)
+                dst[(j+m)*N+order[b+q]] = src[m*B+q];
+          };
+
+          for (unsigned int j=0; j<valueCount; j+=4)
+          {
+            const size_t M = min(4u,valueCount-j);
+            PatchEvalBatch(baseEntry->at(interpolationSlot(primID,j/4,stride)),commitCounter,
+                           topo->getHalfEdge(primID),src+j*sizeof(float),stride,uu,vv,n,
+                           P ? P_t : nullptr,
+                           dPdu ? dPdu_t : nullptr,
+                           dPdv ? dPdv_t : nullptr,
+                           ddPdudu ? ddPdudu_t : nullptr,
+                           ddPdvdv ? ddPdvdv_t : nullptr,
+                           ddPdudv ? ddPdudv_t : nullptr,
+                           B,M);
+            if (P)       scatter(P,P_t,j,M);
+            if (dPdu)    scatter(dPdu,dPdu_t,j,M);
+            if (dPdv)    scatter(dPdv,dPdv_t,j,M);
+            if (ddPdudu) scatter(ddPdudu,ddPdudu_t,j,M);
+            if (ddPdvdv) scatter(ddPdvdv,ddPdvdv_t,j,M);
+            if (ddPdudv) scatter(ddPdudv,ddPdudv_t,j,M);
+          }
+          b += n;
+        }
       }
     }
   }
@@ -64,10 +64,12 @@ namespace embree
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
     void setTessellationRate(float N);
+    void setTessellationView(const float* xfm, float width, float height, float rate);
     bool verify();
     void commit();
     void addElementsToCount (GeometryCounts & counts) const;
     void setDisplacementFunction (RTCDisplacementFunctionN func);
+    void setMaxDisplacement (float maxDisplacement);
     unsigned int getFirstHalfEdge(unsigned int faceID);
     unsigned int getFace(unsigned int edgeID);
     unsigned int getNextHalfEdge(unsigned int edgeID);
@@ -119,15 +121,48 @@ namespace embree
       return vertices[t];
     }
 
-    /* returns tessellation level of edge */
-    __forceinline float getEdgeLevel(const size_t i) const
+    /* returns tessellation level of edge i from vertex v0 to vertex v1 */
+    __forceinline float getEdgeLevel(const size_t i, const unsigned int v0, const unsigned int v1) const
     {
+      if (tessellationView.enabled) return getViewEdgeLevel(v0,v1);
       if (levels) return clamp(levels[i],1.0f,4096.0f); // FIXME: do we want to limit edge level?
       else return clamp(tessellationRate,1.0f,4096.0f); // FIXME: do we want to limit edge level?
     }
 
+    /* returns tessellation level of edge from projected edge length, symmetric in v0 and v1 to avoid cracks */
+    __forceinline float getViewEdgeLevel(const unsigned int v0, const unsigned int v1) const
+    {
+      const Vec4f c0 = tessellationView.project(vertices[0][v0]);
+      const Vec4f c1 = tessellationView.project(vertices[0][v1]);
+
+      /* edges outside the view frustum get minimal tessellation */
+      if ((c0.x < -c0.w && c1.x < -c1.w) || (c0.x > c0.w && c1.x > c1.w) ||
+          (c0.y < -c0.w && c1.y < -c1.w) || (c0.y > c0.w && c1.y > c1.w) ||
+          (c0.w <= 0.0f && c1.w <= 0.0f))
+        return 1.0f;
+
+      /* edges crossing the camera plane cannot get projected */
+      if (c0.w <= 0.0f || c1.w <= 0.0f)
+        return clamp(tessellationRate,1.0f,4096.0f);
+
+      const float dx = tessellationView.scale.x*(c0.x/c0.w - c1.x/c1.w);
+      const float dy = tessellationView.scale.y*(c0.y/c0.w - c1.y/c1.w);
+      return clamp(sqrtf(dx*dx+dy*dy),1.0f,4096.0f);
+    }
+
+    /* checks if edge levels have to get recalculated */
+    __forceinline bool edgeLevelsModified() const {
+      return levels.isLocalModified() || (tessellationView.enabled && vertices[0].isLocalModified());
+    }
+
+    /* checks if patches can get bounded without invoking the displacement function */
+    __forceinline bool hasDisplacementBound() const {
+      return displFunc && maxDisplacement < float(inf) && numTimeSteps == 1;
+    }
+
   public:
     RTCDisplacementFunctionN displFunc;    //!< displacement function
+    float maxDisplacement;                 //!< conservative bound of the displacement distance, inf if unknown
 
     /*! all buffers in this section are provided by the application */
   public:
@@ -259,6 +294,22 @@ namespace embree
     BufferView<float> levels;
     float tessellationRate;  // constant rate that is used when levels is not set
 
+    /*! view to calculate edge levels from, has precedence over levels and tessellationRate */
+    struct TessellationView
+    {
+      TessellationView ()
+        : enabled(false), scale(zero) {}
+
+      __forceinline Vec4f project(const Vec3fa& p) const {
+        return Vec4f(madd(Vec4f(p.x),xfm[0],madd(Vec4f(p.y),xfm[1],madd(Vec4f(p.z),xfm[2],xfm[3]))));
+      }
+
+      bool enabled;
+      Vec4f xfm[4];  //!< columns of world to clip space transformation
+      Vec2f scale;   //!< half viewport size in pixels times tessellation rate
+    };
+    TessellationView tessellationView;
+
     /*! buffer that marks specific faces as holes */
     BufferView<unsigned> holes;
 
@@ -179,6 +179,45 @@ namespace embree
     return true;
   }
 
+  void TriangleMesh::computeTrianglePairs(unsigned int* partners) const
+  {
+    /* edge map of all directed edges of valid triangles, sorted by their vertices */
+    std::vector<bool> valid(size());
+    std::vector<std::pair<uint64_t,unsigned int>> edges;
+    edges.reserve(3*size());
+    for (unsigned int i=0; i<size(); i++)
+    {
+      partners[i] = i;
+      valid[i] = buildBounds(i);
+      if (!valid[i]) continue;
+      const Triangle& tri = triangle(i);
+      for (unsigned int k=0; k<3; k++)
+        edges.push_back(std::make_pair((uint64_t(tri.v[k]) << 32) | uint64_t(tri.v[(k+1)%3]),i));
+    }
+    std::sort(edges.begin(),edges.end());
+
+    /* greedily pair each triangle with the first unpaired triangle containing one of its edges in opposite direction */
+    for (unsigned int i=0; i<size(); i++)
+    {
+      if (!valid[i] || partners[i] != i) continue;
+      const Triangle& a = triangle(i);
+      for (unsigned int k=0; k<3 && partners[i] == i; k++)
+      {
+        const uint64_t key = (uint64_t(a.v[(k+1)%3]) << 32) | uint64_t(a.v[k]);
+        for (auto e = std::lower_bound(edges.begin(),edges.end(),std::make_pair(key,0u)); e != edges.end() && e->first == key; e++)
+        {
+          const unsigned int j = e->second;
+          unsigned int rot0, rot1;
+          if (j == i || partners[j] != j) continue;
+          if (!pairTriangles(a,triangle(j),rot0,rot1)) continue;
+          partners[i] = j;
+          partners[j] = i;
+          break;
+        }
+      }
+    }
+  }
+
   void TriangleMesh::interpolate(const RTCInterpolateArguments* const args) {
     interpolate_impl<4>(args);
   }
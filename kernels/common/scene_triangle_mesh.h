@@ -269,6 +269,51 @@ namespace embree
       return areaProjectedTriangle(v0,v1,v2);
     }
 
+    /*! Checks if triangles a and b can get paired into a quad (q0,q1,q2,q3)
+     *  with a as (q0,q1,q3) and b as (q2,q3,q1). Both triangles have to
+     *  share an edge with consistent orientation. rot0 and rot1 return the
+     *  vertex of each triangle that got placed at q0 and q2 respectively. */
+    static __forceinline bool pairTriangles(const Triangle& a, const Triangle& b, unsigned int& rot0, unsigned int& rot1)
+    {
+      for (unsigned int i=0; i<3; i++)
+      {
+        /* edge a[i] -> a[i+1] has to appear as b[j+1] -> b[j+2] in the second triangle */
+        const unsigned int a0 = a.v[i], a1 = a.v[(i+1)%3], a2 = a.v[(i+2)%3];
+        for (unsigned int j=0; j<3; j++)
+        {
+          if (b.v[(j+1)%3] != a1 || b.v[(j+2)%3] != a0) continue;
+          if (b.v[j] == a2) return false;
+          rot0 = (i+2)%3;
+          rot1 = j;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /*! Pairs triangles sharing an edge using an edge map of the mesh.
+     *  partners[i] returns the triangle paired with triangle i, or i if
+     *  the triangle stays unpaired. */
+    void computeTrianglePairs(unsigned int* partners) const;
+
+    /*! creates one primref per triangle pair with the primID of its smaller
+     *  triangle, and one primref for each unpaired triangle */
+    PrimInfo createTrianglePairPrimRefArray(PrimRef* prims, const unsigned int* partners, const range<size_t>& r, size_t k, unsigned int geomID) const
+    {
+      PrimInfo pinfo(empty);
+      for (size_t j=r.begin(); j<r.end(); j++)
+      {
+        BBox3fa bounds = empty;
+        if (!buildBounds(j,&bounds)) continue;
+        if (partners[j] < j) continue;
+        if (partners[j] != j) bounds.extend(this->bounds(partners[j]));
+        const PrimRef prim(bounds,geomID,unsigned(j));
+        pinfo.add_center2(prim);
+        prims[k++] = prim;
+      }
+      return pinfo;
+    }
+
   public:
     BufferView<Triangle> triangles;      //!< array of triangles
     BufferView<Vec3fa> vertices0;        //!< fast access to first vertex buffer
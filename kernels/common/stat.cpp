@@ -125,4 +125,98 @@ namespace embree
     cout << "#user7/user3 " << 100.0f*float(cntrs.user[7])/float(cntrs.user[3]) << "%" << std::endl;
     cout << std::endl;
   }
+
+  TraversalStat::Shard& TraversalStat::shard()
+  {
+    /* threads get assigned to shards round robin on first use */
+    static std::atomic<size_t> next_shard(0);
+    static __thread size_t thread_shard = -1;
+    if (unlikely(thread_shard == size_t(-1)))
+      thread_shard = next_shard++ % NUM_SHARDS;
+    return shards[thread_shard];
+  }
+
+  void TraversalStat::add(const Counters& cntrs)
+  {
+    Shard& s = shard();
+    s.rays   .fetch_add(cntrs.rays   ,std::memory_order_relaxed);
+    s.nodes  .fetch_add(cntrs.nodes  ,std::memory_order_relaxed);
+    s.leaves .fetch_add(cntrs.leaves ,std::memory_order_relaxed);
+    s.filters.fetch_add(cntrs.filters,std::memory_order_relaxed);
+  }
+
+  void TraversalStat::addFilter() {
+    shard().filters.fetch_add(1,std::memory_order_relaxed);
+  }
+
+  TraversalStat::Counters TraversalStat::get() const
+  {
+    Counters cntrs;
+    for (size_t i=0; i<NUM_SHARDS; i++) {
+      cntrs.rays    += shards[i].rays;
+      cntrs.nodes   += shards[i].nodes;
+      cntrs.leaves  += shards[i].leaves;
+      cntrs.filters += shards[i].filters;
+    }
+    return cntrs;
+  }
+
+  void TraversalStat::reset()
+  {
+    for (size_t i=0; i<NUM_SHARDS; i++) {
+      shards[i].rays.store(0);
+      shards[i].nodes.store(0);
+      shards[i].leaves.store(0);
+      shards[i].filters.store(0);
+    }
+  }
+
+  void BuildStat::Report::add(const Report& other)
+  {
+    commitTime += other.commitTime;
+    for (size_t i=0; i<NUM_PHASES; i++)
+      phaseTime[i] += other.phaseTime[i];
+    numBuilds     += other.numBuilds;
+    numPrimitives += other.numPrimitives;
+    numNodes      += other.numNodes;
+    numLeaves     += other.numLeaves;
+    for (size_t i=0; i<NUM_NODE_TYPES; i++)
+      nodeBytes[i] += other.nodeBytes[i];
+    leafBytes     += other.leafBytes;
+    bytesUsed     += other.bytesUsed;
+    bytesFree     += other.bytesFree;
+    bytesWasted   += other.bytesWasted;
+    sah           += other.sah;
+  }
+
+  void BuildStat::addPhaseTime(Phase phase, double dt)
+  {
+    Lock<MutexSys> lock(mutex);
+    report.phaseTime[phase] += dt;
+  }
+
+  void BuildStat::add(const Report& other)
+  {
+    Lock<MutexSys> lock(mutex);
+    report.add(other);
+  }
+
+  void BuildStat::setCommitTime(double dt)
+  {
+    Lock<MutexSys> lock(mutex);
+    report.commitTime = dt;
+  }
+
+  BuildStat::Report BuildStat::get() const
+  {
+    Lock<MutexSys> lock(mutex);
+    return report;
+  }
+
+  void BuildStat::reset()
+  {
+    Lock<MutexSys> lock(mutex);
+    report = Report();
+    gathering = isEnabled();
+  }
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "default.h"
+#include "rtcore.h"
 
 /* Macros to gather statistics */
 #ifdef EMBREE_STAT_COUNTERS
@@ -113,4 +114,198 @@ namespace embree
   private:
     static Stat instance;
   };
+
+  /*! Traversal statistics of a scene that are compiled in always but
+   *  only gathered when enabled at runtime. Traversal kernels count
+   *  into local variables and add these once per query to one of
+   *  several cache line sized shards, which avoids contention between
+   *  threads. The shards get summed up when the statistics are read. */
+  class TraversalStat
+  {
+  public:
+
+    static const size_t NUM_SHARDS = 32;
+
+    struct Counters
+    {
+      __forceinline Counters ()
+        : rays(0), nodes(0), leaves(0), filters(0) {}
+
+    public:
+      size_t rays;     //!< number of rays entering traversal
+      size_t nodes;    //!< number of traversed inner nodes
+      size_t leaves;   //!< number of visited leaf nodes
+      size_t filters;  //!< number of filter function invocations
+    };
+
+  public:
+
+    TraversalStat ()
+      : enabled(false) { reset(); }
+
+    __forceinline bool isEnabled() const {
+      return enabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enable) {
+      enabled.store(enable,std::memory_order_relaxed);
+    }
+
+    /*! Counters of a single query, they get added to the statistics
+     *  when going out of scope if gathering is enabled. The counters
+     *  are additionally added to the optional per query statistics
+     *  passed through the intersect or occluded arguments. */
+    struct Query : public Counters
+    {
+      __forceinline Query (TraversalStat& stat, RTCSceneStatistics* user = nullptr)
+        : stat(stat), user(user) {}
+
+      __forceinline ~Query ()
+      {
+        if (unlikely(stat.isEnabled())) stat.add(*this);
+        if (unlikely(user != nullptr)) {
+          user->numRays   += rays;
+          user->numNodes  += nodes;
+          user->numLeaves += leaves;
+        }
+      }
+
+    private:
+      TraversalStat& stat;
+      RTCSceneStatistics* user;
+    };
+
+    /*! adds counters to the shard of the calling thread */
+    void add(const Counters& cntrs);
+
+    /*! counts a single filter function invocation */
+    void addFilter();
+
+    /*! returns the sum over all shards */
+    Counters get() const;
+
+    /*! clears all shards */
+    void reset();
+
+  private:
+    struct __aligned(64) Shard
+    {
+      std::atomic<size_t> rays;
+      std::atomic<size_t> nodes;
+      std::atomic<size_t> leaves;
+      std::atomic<size_t> filters;
+    };
+
+    Shard& shard();
+
+  private:
+    std::atomic<bool> enabled;
+    Shard shards[NUM_SHARDS];
+  };
+
+  /*! Build statistics of the last commit of a scene, only gathered
+   *  when enabled at runtime. Builders report the time spent in the
+   *  individual build phases, and each scene level BVH reports its node,
+   *  leaf and allocator statistics after its build finished. */
+  class BuildStat
+  {
+  public:
+
+    enum Phase
+    {
+      PRIMREFS  = 0,  //!< primitive reference generation
+      PRESPLITS = 1,  //!< spatial presplits
+      HIERARCHY = 2,  //!< binning, splitting and leaf creation
+      TOPLEVEL  = 3,  //!< top level build of two level BVHs
+      REFIT     = 4,  //!< refitting of BVHs
+      NUM_PHASES
+    };
+
+    enum NodeType
+    {
+      AABB_NODES      = 0,
+      AABB_MB_NODES   = 1,  //!< linear and 4D motion blur nodes
+      OBB_NODES       = 2,  //!< static and motion blur oriented nodes
+      QUANTIZED_NODES = 3,
+      NUM_NODE_TYPES
+    };
+
+    struct Report
+    {
+      Report ()
+        : commitTime(0.0), numBuilds(0), numPrimitives(0), numNodes(0), numLeaves(0), leafBytes(0),
+          bytesUsed(0), bytesFree(0), bytesWasted(0), sah(0.0)
+      {
+        for (size_t i=0; i<NUM_PHASES; i++) phaseTime[i] = 0.0;
+        for (size_t i=0; i<NUM_NODE_TYPES; i++) nodeBytes[i] = 0;
+      }
+
+      void add(const Report& other);
+
+    public:
+      double commitTime;                   //!< wall clock time of the commit in seconds
+      double phaseTime[NUM_PHASES];        //!< time per build phase in seconds, summed over all builds
+      size_t numBuilds;                    //!< number of scene level BVHs built
+      size_t numPrimitives;                //!< number of primitives in these BVHs
+      size_t numNodes;                     //!< number of inner nodes
+      size_t numLeaves;                    //!< number of leaf nodes
+      size_t nodeBytes[NUM_NODE_TYPES];    //!< bytes used per inner node type
+      size_t leafBytes;                    //!< bytes used by leaves
+      size_t bytesUsed;                    //!< bytes used in allocator blocks
+      size_t bytesFree;                    //!< bytes reserved but not used in allocator blocks
+      size_t bytesWasted;                  //!< bytes lost to alignment and block ends
+      double sah;                          //!< summed SAH cost of the BVHs
+    };
+
+  public:
+
+    BuildStat ()
+      : enabled(false), gathering(false) {}
+
+    __forceinline bool isEnabled() const {
+      return enabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enable) {
+      enabled.store(enable,std::memory_order_relaxed);
+    }
+
+    /*! returns if the current commit gathers statistics, this is
+     *  fixed at the start of the commit, thus enabling statistics
+     *  during a build takes effect with the next commit */
+    __forceinline bool isGathering() const {
+      return gathering;
+    }
+
+    /*! returns the start time of a phase, or 0 if gathering is disabled */
+    __forceinline double startPhase() const {
+      return unlikely(isGathering()) ? getSeconds() : 0.0;
+    }
+
+    /*! adds the time since t0 to a phase if gathering is enabled */
+    __forceinline void endPhase(Phase phase, double t0) {
+      if (unlikely(isGathering())) addPhaseTime(phase,getSeconds()-t0);
+    }
+
+    /*! adds the time of a phase, can be called from parallel builds */
+    void addPhaseTime(Phase phase, double dt);
+
+    /*! adds the statistics of a finished BVH build */
+    void add(const Report& report);
+
+    /*! sets the total time of the commit */
+    void setCommitTime(double dt);
+
+    /*! returns the report of the last commit */
+    Report get() const;
+
+    /*! clears the report and latches the enabled flag at the start of a commit */
+    void reset();
+
+  private:
+    std::atomic<bool> enabled;
+    bool gathering;                      //!< enabled flag of the current commit
+    mutable MutexSys mutex;
+    Report report;
+  };
 }
@@ -85,6 +85,8 @@ namespace embree
     useSpatialPreSplits = false;
 
     tessellation_cache_size = 128*1024*1024;
+    tessellation_cache_min_size = 0;
+    tessellation_cache_max_size = 0;
 
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
@@ -105,6 +107,7 @@ namespace embree
     scene_flags = -1;
     verbose = 0;
     benchmark = 0;
+    ray_dump = "";
 
     numThreads = 0;
     numUserThreads = 0;
@@ -403,6 +406,15 @@ namespace embree
         verbose = cin->get().Int();
       else if (tok == Token::Id("benchmark") && cin->trySymbol("="))
         benchmark = cin->get().Int();
+      else if (tok == Token::Id("ray_dump") && cin->trySymbol("=")) {
+        try {
+          ray_dump = cin->getWord(",");
+        } catch (std::runtime_error& e) {
+          throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,std::string("invalid ray_dump file name: ")+e.what());
+        }
+        if (ray_dump.empty())
+          throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"ray_dump requires a file name");
+      }
       
       else if (tok == Token::Id("quality")) {
         if (cin->trySymbol("=")) {
@@ -435,6 +447,10 @@ namespace embree
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("tessellation_cache_min_size") && cin->trySymbol("="))
+        tessellation_cache_min_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("tessellation_cache_max_size") && cin->trySymbol("="))
+        tessellation_cache_max_size = size_t(cin->get().Float()*1024.0f*1024.0f);
 
       else if (tok == Token::Id("alloc_main_block_size") && cin->trySymbol("="))
         alloc_main_block_size = cin->get().Int();
@@ -475,6 +491,10 @@ namespace embree
 
     std::cout << "  verbosity          = " << verbose << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    if (tessellation_cache_min_size || tessellation_cache_max_size) {
+      std::cout << "  cache_min_size     = " << float(tessellation_cache_min_size)*1E-6 << " MB" << std::endl;
+      std::cout << "  cache_max_size     = " << float(tessellation_cache_max_size)*1E-6 << " MB" << std::endl;
+    }
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
     
     std::cout << "triangles:" << std::endl;
@@ -109,6 +109,8 @@ namespace embree
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     bool useSpatialPreSplits;              //!< use spatial pre-splits instead of the full spatial split builder
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    size_t tessellation_cache_min_size;    //!< minimal size the tessellation cache may shrink to
+    size_t tessellation_cache_max_size;    //!< maximal size the tessellation cache may grow to
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -123,6 +125,7 @@ namespace embree
     int scene_flags;
     size_t verbose;                        //!< verbosity of output
     size_t benchmark;                      //!< true
+    std::string ray_dump;                  //!< file to record all ray queries to
     
   public:
     size_t numThreads;                     //!< number of threads to use in builders
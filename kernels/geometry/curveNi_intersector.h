@@ -73,23 +73,26 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(normal.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,geom->curve(primID));
+          if (unlikely(code)) CurveGeometry::clipSegment<typename Intersector::NativeCurve3ff>(code,a0,a1,a2,a3);
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
             const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            geom->prefetchL1_vertices(geom->curve(geom->segmentID(primID1)));
             if (mask1) {
               const size_t i2 = bsf(mask1);
               const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              geom->prefetchL2_vertices(geom->curve(geom->segmentID(primID2)));
             }
           }
           
-          Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,Epilog(ray,context,geomID,primID));
+          Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,CurveSegmentEpilog<Epilog>(Epilog(ray,context,geomID,primID),geom->segmentRange(code)));
           mask &= movemask(tNear <= vfloat<M>(ray.tfar));
         }
       }
@@ -107,23 +110,26 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(shadow.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,geom->curve(primID));
+          if (unlikely(code)) CurveGeometry::clipSegment<typename Intersector::NativeCurve3ff>(code,a0,a1,a2,a3);
          
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
             const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            geom->prefetchL1_vertices(geom->curve(geom->segmentID(primID1)));
             if (mask1) {
               const size_t i2 = bsf(mask1);
               const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              geom->prefetchL2_vertices(geom->curve(geom->segmentID(primID2)));
             }
           }
 
-          if (Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,Epilog(ray,context,geomID,primID)))
+          if (Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,CurveSegmentEpilog<Epilog>(Epilog(ray,context,geomID,primID),geom->segmentRange(code))))
             return true;
           
           mask &= movemask(tNear <= vfloat<M>(ray.tfar));
@@ -144,25 +150,31 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(normal.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           
           unsigned int vertexID = geom->curve(primID);
           Vec3ff a0,a1,a2,a3; Vec3fa n0,n1,n2,n3; geom->gather(a0,a1,a2,a3,n0,n1,n2,n3,vertexID);
+          if (unlikely(code)) {
+            CurveGeometry::clipSegment<typename Intersector::SourceCurve3ff>(code,a0,a1,a2,a3);
+            CurveGeometry::clipSegment<typename Intersector::SourceCurve3fa>(code,n0,n1,n2,n3);
+          }
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
             const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            geom->prefetchL1_vertices(geom->curve(geom->segmentID(primID1)));
             if (mask1) {
               const size_t i2 = bsf(mask1);
               const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              geom->prefetchL2_vertices(geom->curve(geom->segmentID(primID2)));
             }
           }
           
-          Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,n0,n1,n2,n3,Epilog(ray,context,geomID,primID));
+          Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,n0,n1,n2,n3,CurveSegmentEpilog<Epilog>(Epilog(ray,context,geomID,primID),geom->segmentRange(code)));
           mask &= movemask(tNear <= vfloat<M>(ray.tfar));
         }
       }
@@ -180,25 +192,31 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(shadow.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
 
           unsigned int vertexID = geom->curve(primID);
           Vec3ff a0,a1,a2,a3; Vec3fa n0,n1,n2,n3; geom->gather(a0,a1,a2,a3,n0,n1,n2,n3,vertexID);
+          if (unlikely(code)) {
+            CurveGeometry::clipSegment<typename Intersector::SourceCurve3ff>(code,a0,a1,a2,a3);
+            CurveGeometry::clipSegment<typename Intersector::SourceCurve3fa>(code,n0,n1,n2,n3);
+          }
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
             const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            geom->prefetchL1_vertices(geom->curve(geom->segmentID(primID1)));
             if (mask1) {
               const size_t i2 = bsf(mask1);
               const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              geom->prefetchL2_vertices(geom->curve(geom->segmentID(primID2)));
             }
           }
 
-          if (Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,n0,n1,n2,n3,Epilog(ray,context,geomID,primID)))
+          if (Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,n0,n1,n2,n3,CurveSegmentEpilog<Epilog>(Epilog(ray,context,geomID,primID),geom->segmentRange(code))))
             return true;
           
           mask &= movemask(tNear <= vfloat<M>(ray.tfar));
@@ -219,10 +237,13 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(normal.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff p0,t0,p1,t1; geom->gather_hermite(p0,t0,p1,t1,geom->curve(primID));
-          Intersector().intersect(pre,ray,context,geom,primID,p0,t0,p1,t1,Epilog(ray,context,geomID,primID));
+          if (unlikely(code)) CurveGeometry::clipHermiteSegment(code,p0,t0,p1,t1);
+          Intersector().intersect(pre,ray,context,geom,primID,p0,t0,p1,t1,CurveSegmentEpilog<Epilog>(Epilog(ray,context,geomID,primID),geom->segmentRange(code)));
           mask &= movemask(tNear <= vfloat<M>(ray.tfar));
         }
       }
@@ -240,10 +261,13 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(shadow.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff p0,t0,p1,t1; geom->gather_hermite(p0,t0,p1,t1,geom->curve(primID));
-          if (Intersector().intersect(pre,ray,context,geom,primID,p0,t0,p1,t1,Epilog(ray,context,geomID,primID)))
+          if (unlikely(code)) CurveGeometry::clipHermiteSegment(code,p0,t0,p1,t1);
+          if (Intersector().intersect(pre,ray,context,geom,primID,p0,t0,p1,t1,CurveSegmentEpilog<Epilog>(Epilog(ray,context,geomID,primID),geom->segmentRange(code))))
             return true;
           
           mask &= movemask(tNear <= vfloat<M>(ray.tfar));
@@ -264,10 +288,16 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(normal.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff p0,t0,p1,t1; Vec3fa n0,dn0,n1,dn1; geom->gather_hermite(p0,t0,n0,dn0,p1,t1,n1,dn1,geom->curve(primID));
-          Intersector().intersect(pre,ray,context,geom,primID,p0,t0,p1,t1,n0,dn0,n1,dn1,Epilog(ray,context,geomID,primID));
+          if (unlikely(code)) {
+            CurveGeometry::clipHermiteSegment(code,p0,t0,p1,t1);
+            CurveGeometry::clipHermiteSegment(code,n0,dn0,n1,dn1);
+          }
+          Intersector().intersect(pre,ray,context,geom,primID,p0,t0,p1,t1,n0,dn0,n1,dn1,CurveSegmentEpilog<Epilog>(Epilog(ray,context,geomID,primID),geom->segmentRange(code)));
           mask &= movemask(tNear <= vfloat<M>(ray.tfar));
         }
       }
@@ -285,10 +315,16 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(shadow.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff p0,t0,p1,t1; Vec3fa n0,dn0,n1,dn1; geom->gather_hermite(p0,t0,n0,dn0,p1,t1,n1,dn1,geom->curve(primID));
-          if (Intersector().intersect(pre,ray,context,geom,primID,p0,t0,p1,t1,n0,dn0,n1,dn1,Epilog(ray,context,geomID,primID)))
+          if (unlikely(code)) {
+            CurveGeometry::clipHermiteSegment(code,p0,t0,p1,t1);
+            CurveGeometry::clipHermiteSegment(code,n0,dn0,n1,dn1);
+          }
+          if (Intersector().intersect(pre,ray,context,geom,primID,p0,t0,p1,t1,n0,dn0,n1,dn1,CurveSegmentEpilog<Epilog>(Epilog(ray,context,geomID,primID),geom->segmentRange(code))))
             return true;
           
           mask &= movemask(tNear <= vfloat<M>(ray.tfar));
@@ -357,23 +393,26 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(normal.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,geom->curve(primID));
+          if (unlikely(code)) CurveGeometry::clipSegment<typename Intersector::NativeCurve3ff>(code,a0,a1,a2,a3);
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
             const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            geom->prefetchL1_vertices(geom->curve(geom->segmentID(primID1)));
             if (mask1) {
               const size_t i2 = bsf(mask1);
               const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              geom->prefetchL2_vertices(geom->curve(geom->segmentID(primID2)));
             }
           }
 
-          Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,Epilog(ray,k,context,geomID,primID));
+          Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,CurveSegmentEpilog<Epilog>(Epilog(ray,k,context,geomID,primID),geom->segmentRange(code)));
           mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
         }
       }
@@ -391,23 +430,26 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(shadow.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,geom->curve(primID));
+          if (unlikely(code)) CurveGeometry::clipSegment<typename Intersector::NativeCurve3ff>(code,a0,a1,a2,a3);
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
             const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            geom->prefetchL1_vertices(geom->curve(geom->segmentID(primID1)));
             if (mask1) {
               const size_t i2 = bsf(mask1);
               const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              geom->prefetchL2_vertices(geom->curve(geom->segmentID(primID2)));
             }
           }
           
-          if (Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,Epilog(ray,k,context,geomID,primID)))
+          if (Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,CurveSegmentEpilog<Epilog>(Epilog(ray,k,context,geomID,primID),geom->segmentRange(code))))
             return true;
           
           mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
@@ -428,25 +470,31 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(normal.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
 
           unsigned int vertexID = geom->curve(primID);
           Vec3ff a0,a1,a2,a3; Vec3fa n0,n1,n2,n3; geom->gather(a0,a1,a2,a3,n0,n1,n2,n3,vertexID);
+          if (unlikely(code)) {
+            CurveGeometry::clipSegment<typename Intersector::SourceCurve3ff>(code,a0,a1,a2,a3);
+            CurveGeometry::clipSegment<typename Intersector::SourceCurve3fa>(code,n0,n1,n2,n3);
+          }
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
             const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            geom->prefetchL1_vertices(geom->curve(geom->segmentID(primID1)));
             if (mask1) {
               const size_t i2 = bsf(mask1);
               const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              geom->prefetchL2_vertices(geom->curve(geom->segmentID(primID2)));
             }
           }
 
-          Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,n0,n1,n2,n3,Epilog(ray,k,context,geomID,primID));
+          Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,n0,n1,n2,n3,CurveSegmentEpilog<Epilog>(Epilog(ray,k,context,geomID,primID),geom->segmentRange(code)));
           mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
         }
       }
@@ -464,25 +512,31 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(shadow.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
 
           unsigned int vertexID = geom->curve(primID);
           Vec3ff a0,a1,a2,a3; Vec3fa n0,n1,n2,n3; geom->gather(a0,a1,a2,a3,n0,n1,n2,n3,vertexID);
+          if (unlikely(code)) {
+            CurveGeometry::clipSegment<typename Intersector::SourceCurve3ff>(code,a0,a1,a2,a3);
+            CurveGeometry::clipSegment<typename Intersector::SourceCurve3fa>(code,n0,n1,n2,n3);
+          }
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
           if (mask) {
             const unsigned int primID1 = prim.primID(N)[i1];
-            geom->prefetchL1_vertices(geom->curve(primID1));
+            geom->prefetchL1_vertices(geom->curve(geom->segmentID(primID1)));
             if (mask1) {
               const size_t i2 = bsf(mask1);
               const unsigned int primID2 = prim.primID(N)[i2];
-              geom->prefetchL2_vertices(geom->curve(primID2));
+              geom->prefetchL2_vertices(geom->curve(geom->segmentID(primID2)));
             }
           }
 
-          if (Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,n0,n1,n2,n3,Epilog(ray,k,context,geomID,primID)))
+          if (Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,n0,n1,n2,n3,CurveSegmentEpilog<Epilog>(Epilog(ray,k,context,geomID,primID),geom->segmentRange(code))))
             return true;
           
           mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
@@ -503,10 +557,13 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(normal.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff p0,t0,p1,t1; geom->gather_hermite(p0,t0,p1,t1,geom->curve(primID));
-          Intersector().intersect(pre,ray,k,context,geom,primID,p0,t0,p1,t1,Epilog(ray,k,context,geomID,primID));
+          if (unlikely(code)) CurveGeometry::clipHermiteSegment(code,p0,t0,p1,t1);
+          Intersector().intersect(pre,ray,k,context,geom,primID,p0,t0,p1,t1,CurveSegmentEpilog<Epilog>(Epilog(ray,k,context,geomID,primID),geom->segmentRange(code)));
           mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
         }
       }
@@ -524,10 +581,13 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(shadow.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff p0,t0,p1,t1; geom->gather_hermite(p0,t0,p1,t1,geom->curve(primID));
-          if (Intersector().intersect(pre,ray,k,context,geom,primID,p0,t0,p1,t1,Epilog(ray,k,context,geomID,primID)))
+          if (unlikely(code)) CurveGeometry::clipHermiteSegment(code,p0,t0,p1,t1);
+          if (Intersector().intersect(pre,ray,k,context,geom,primID,p0,t0,p1,t1,CurveSegmentEpilog<Epilog>(Epilog(ray,k,context,geomID,primID),geom->segmentRange(code))))
             return true;
           
           mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
@@ -548,10 +608,16 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(normal.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff p0,t0,p1,t1; Vec3fa n0,dn0,n1,dn1; geom->gather_hermite(p0,t0,n0,dn0,p1,t1,n1,dn1,geom->curve(primID));
-          Intersector().intersect(pre,ray,k,context,geom,primID,p0,t0,p1,t1,n0,dn0,n1,dn1,Epilog(ray,k,context,geomID,primID));
+          if (unlikely(code)) {
+            CurveGeometry::clipHermiteSegment(code,p0,t0,p1,t1);
+            CurveGeometry::clipHermiteSegment(code,n0,dn0,n1,dn1);
+          }
+          Intersector().intersect(pre,ray,k,context,geom,primID,p0,t0,p1,t1,n0,dn0,n1,dn1,CurveSegmentEpilog<Epilog>(Epilog(ray,k,context,geomID,primID),geom->segmentRange(code)));
           mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
         }
       }
@@ -569,10 +635,16 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(shadow.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = context->scene->get<CurveGeometry>(geomID);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
           Vec3ff p0,t0,p1,t1; Vec3fa n0,dn0,n1,dn1; geom->gather_hermite(p0,t0,n0,dn0,p1,t1,n1,dn1,geom->curve(primID));
-          if (Intersector().intersect(pre,ray,k,context,geom,primID,p0,t0,p1,t1,n0,dn0,n1,dn1,Epilog(ray,k,context,geomID,primID)))
+          if (unlikely(code)) {
+            CurveGeometry::clipHermiteSegment(code,p0,t0,p1,t1);
+            CurveGeometry::clipHermiteSegment(code,n0,dn0,n1,dn1);
+          }
+          if (Intersector().intersect(pre,ray,k,context,geom,primID,p0,t0,p1,t1,n0,dn0,n1,dn1,CurveSegmentEpilog<Epilog>(Epilog(ray,k,context,geomID,primID),geom->segmentRange(code))))
             return true;
           
           mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
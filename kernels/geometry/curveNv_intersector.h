@@ -29,12 +29,15 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(normal.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
-          const Vec3ff a0 = Vec3ff::loadu(&prim.vertices(i,N)[0]);
-          const Vec3ff a1 = Vec3ff::loadu(&prim.vertices(i,N)[1]);
-          const Vec3ff a2 = Vec3ff::loadu(&prim.vertices(i,N)[2]);
-          const Vec3ff a3 = Vec3ff::loadu(&prim.vertices(i,N)[3]);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
+          Vec3ff a0 = Vec3ff::loadu(&prim.vertices(i,N)[0]);
+          Vec3ff a1 = Vec3ff::loadu(&prim.vertices(i,N)[1]);
+          Vec3ff a2 = Vec3ff::loadu(&prim.vertices(i,N)[2]);
+          Vec3ff a3 = Vec3ff::loadu(&prim.vertices(i,N)[3]);
+          if (unlikely(code)) CurveGeometry::clipSegment<typename Intersector::NativeCurve3ff>(code,a0,a1,a2,a3);
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
@@ -48,7 +51,7 @@ namespace embree
             }
           }
 
-          Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,Epilog(ray,context,geomID,primID));
+          Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,CurveSegmentEpilog<Epilog>(Epilog(ray,context,geomID,primID),geom->segmentRange(code)));
           mask &= movemask(tNear <= vfloat<M>(ray.tfar));
         }
       }
@@ -66,12 +69,15 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(shadow.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
-          const Vec3ff a0 = Vec3ff::loadu(&prim.vertices(i,N)[0]);
-          const Vec3ff a1 = Vec3ff::loadu(&prim.vertices(i,N)[1]);
-          const Vec3ff a2 = Vec3ff::loadu(&prim.vertices(i,N)[2]);
-          const Vec3ff a3 = Vec3ff::loadu(&prim.vertices(i,N)[3]);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
+          Vec3ff a0 = Vec3ff::loadu(&prim.vertices(i,N)[0]);
+          Vec3ff a1 = Vec3ff::loadu(&prim.vertices(i,N)[1]);
+          Vec3ff a2 = Vec3ff::loadu(&prim.vertices(i,N)[2]);
+          Vec3ff a3 = Vec3ff::loadu(&prim.vertices(i,N)[3]);
+          if (unlikely(code)) CurveGeometry::clipSegment<typename Intersector::NativeCurve3ff>(code,a0,a1,a2,a3);
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
@@ -85,7 +91,7 @@ namespace embree
             }
           }
           
-          if (Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,Epilog(ray,context,geomID,primID)))
+          if (Intersector().intersect(pre,ray,context,geom,primID,a0,a1,a2,a3,CurveSegmentEpilog<Epilog>(Epilog(ray,context,geomID,primID),geom->segmentRange(code))))
             return true;
           
           mask &= movemask(tNear <= vfloat<M>(ray.tfar));
@@ -113,12 +119,15 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(normal.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
-          const Vec3ff a0 = Vec3ff::loadu(&prim.vertices(i,N)[0]);
-          const Vec3ff a1 = Vec3ff::loadu(&prim.vertices(i,N)[1]);
-          const Vec3ff a2 = Vec3ff::loadu(&prim.vertices(i,N)[2]);
-          const Vec3ff a3 = Vec3ff::loadu(&prim.vertices(i,N)[3]);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
+          Vec3ff a0 = Vec3ff::loadu(&prim.vertices(i,N)[0]);
+          Vec3ff a1 = Vec3ff::loadu(&prim.vertices(i,N)[1]);
+          Vec3ff a2 = Vec3ff::loadu(&prim.vertices(i,N)[2]);
+          Vec3ff a3 = Vec3ff::loadu(&prim.vertices(i,N)[3]);
+          if (unlikely(code)) CurveGeometry::clipSegment<typename Intersector::NativeCurve3ff>(code,a0,a1,a2,a3);
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
@@ -132,7 +141,7 @@ namespace embree
             }
           }
 
-          Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,Epilog(ray,k,context,geomID,primID));
+          Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,CurveSegmentEpilog<Epilog>(Epilog(ray,k,context,geomID,primID),geom->segmentRange(code)));
           mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
         }
       }
@@ -150,12 +159,15 @@ namespace embree
           const size_t i = bscf(mask);
           STAT3(shadow.trav_prims,1,1,1);
           const unsigned int geomID = prim.geomID(N);
-          const unsigned int primID = prim.primID(N)[i];
           const CurveGeometry* geom = (CurveGeometry*) context->scene->get(geomID);
-          const Vec3ff a0 = Vec3ff::loadu(&prim.vertices(i,N)[0]);
-          const Vec3ff a1 = Vec3ff::loadu(&prim.vertices(i,N)[1]);
-          const Vec3ff a2 = Vec3ff::loadu(&prim.vertices(i,N)[2]);
-          const Vec3ff a3 = Vec3ff::loadu(&prim.vertices(i,N)[3]);
+          const unsigned int segID = prim.primID(N)[i];
+          const unsigned int primID = geom->segmentID(segID);
+          const unsigned int code = geom->segmentCode(segID);
+          Vec3ff a0 = Vec3ff::loadu(&prim.vertices(i,N)[0]);
+          Vec3ff a1 = Vec3ff::loadu(&prim.vertices(i,N)[1]);
+          Vec3ff a2 = Vec3ff::loadu(&prim.vertices(i,N)[2]);
+          Vec3ff a3 = Vec3ff::loadu(&prim.vertices(i,N)[3]);
+          if (unlikely(code)) CurveGeometry::clipSegment<typename Intersector::NativeCurve3ff>(code,a0,a1,a2,a3);
 
           size_t mask1 = mask;
           const size_t i1 = bscf(mask1);
@@ -169,7 +181,7 @@ namespace embree
             }
           }
 
-          if (Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,Epilog(ray,k,context,geomID,primID)))
+          if (Intersector().intersect(pre,ray,k,context,geom,primID,a0,a1,a2,a3,CurveSegmentEpilog<Epilog>(Epilog(ray,k,context,geomID,primID),geom->segmentRange(code))))
             return true;
 
           mask &= movemask(tNear <= vfloat<M>(ray.tfar[k]));
@@ -7,15 +7,26 @@
 #include "../common/ray.h"
 #include "../common/hit.h"
 #include "../common/context.h"
+#include "../common/scene.h"
 
 namespace embree
 {
   namespace isa
   {
+    /* counts filter function invocations if statistics are enabled for the scene or requested for the query */
+    __forceinline void countFilterCall(RayQueryContext* context)
+    {
+      if (unlikely(context->scene->traversal_stat.isEnabled()))
+        context->scene->traversal_stat.addFilter();
+      if (unlikely(context->args->stats != nullptr))
+        context->args->stats->numFilterCalls++;
+    }
+
     __forceinline bool runIntersectionFilter1Helper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, RayQueryContext* context)
     {
       if (geometry->intersectionFilterN)
       {
+        countFilterCall(context);
         geometry->intersectionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -24,8 +35,10 @@ namespace embree
 
       if (context->getFilter())
       {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
+          countFilterCall(context);
           context->getFilter()(args);
+        }
 
         if (args->valid[0] == 0)
           return false;
@@ -52,6 +65,7 @@ namespace embree
     {
       if (geometry->occlusionFilterN)
       {
+        countFilterCall(context);
         geometry->occlusionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -60,8 +74,10 @@ namespace embree
 
       if (context->getFilter())
       {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
+          countFilterCall(context);
           context->getFilter()(args);
+        }
 
         if (args->valid[0] == 0)
           return false;
@@ -87,15 +103,19 @@ namespace embree
       __forceinline vbool<K> runIntersectionFilterHelper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, RayQueryContext* context)
     {
       vint<K>* mask = (vint<K>*) args->valid;
-      if (geometry->intersectionFilterN)
+      if (geometry->intersectionFilterN) {
+        countFilterCall(context);
         geometry->intersectionFilterN(args);
+      }
       
       vbool<K> valid_o = *mask != vint<K>(zero);
       if (none(valid_o)) return valid_o;
 
       if (context->getFilter()) {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
+          countFilterCall(context);
           context->getFilter()(args);
+        }
       }
 
       valid_o = *mask != vint<K>(zero);
@@ -123,15 +143,19 @@ namespace embree
       __forceinline vbool<K> runOcclusionFilterHelper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, RayQueryContext* context)
     {
       vint<K>* mask = (vint<K>*) args->valid;
-      if (geometry->occlusionFilterN)
+      if (geometry->occlusionFilterN) {
+        countFilterCall(context);
         geometry->occlusionFilterN(args);
+      }
       
       vbool<K> valid_o = *mask != vint<K>(zero);
       if (none(valid_o)) return valid_o;
 
       if (context->getFilter()) {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
+          countFilterCall(context);
           context->getFilter()(args);
+        }
       }
       valid_o = *mask != vint<K>(zero);
 
@@ -31,6 +31,7 @@ namespace embree
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        ((Scene*)object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
         object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
@@ -61,6 +62,7 @@ namespace embree
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        ((Scene*)object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
         object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
@@ -91,6 +93,8 @@ namespace embree
         query_inst.p = xfmPoint(world2local, query->p); 
         query_inst.radius = query->radius * similarityScale;
 
+        ((Scene*)object)->buildOnDemand();
+
         PointQueryContext context_inst(
           (Scene*)object, 
           context->query_ws, 
@@ -127,6 +131,7 @@ namespace embree
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        ((Scene*)object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
         object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
@@ -156,6 +161,7 @@ namespace embree
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        ((Scene*)object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
         object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
@@ -185,6 +191,8 @@ namespace embree
         query_inst.p = xfmPoint(world2local, query->p); 
         query_inst.radius = query->radius * similarityScale;
 
+        ((Scene*)object)->buildOnDemand();
+
         PointQueryContext context_inst(
           (Scene*)object, 
           context->query_ws, 
@@ -223,6 +231,7 @@ namespace embree
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
+        ((Scene*)object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
         object->intersectors.intersect(valid, ray, &newcontext);
         ray.org = ray_org;
@@ -254,6 +263,7 @@ namespace embree
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
+        ((Scene*)object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
         object->intersectors.occluded(valid, ray, &newcontext);
         ray.org = ray_org;
@@ -286,6 +296,7 @@ namespace embree
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
+        ((Scene*)object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
         object->intersectors.intersect(valid, ray, &newcontext);
         ray.org = ray_org;
@@ -317,6 +328,7 @@ namespace embree
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
+        ((Scene*)object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
         object->intersectors.occluded(valid, ray, &newcontext);
         ray.org = ray_org;
@@ -27,8 +27,9 @@ namespace embree
         const AffineSpace3fa world2local = instance->getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(xfmPoint(world2local, instance->rebase(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        ((Scene*)instance->object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
@@ -54,8 +55,9 @@ namespace embree
         const AffineSpace3fa world2local = instance->getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(xfmPoint(world2local, instance->rebase(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        ((Scene*)instance->object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
@@ -77,13 +79,17 @@ namespace embree
                            && similarityTransform(world2local, &similarityScale);
       assert((similtude && similarityScale > 0) || !similtude);
 
-      if (likely(instance_id_stack::push(context->userContext, prim.instID_, 0, world2local, local2world)))
+      AffineSpace3fa world2inst = world2local, inst2world = local2world;
+      instance->addOrigin(inst2world, world2inst);
+      if (likely(instance_id_stack::push(context->userContext, prim.instID_, 0, world2inst, inst2world)))
       {
         PointQuery query_inst;
         query_inst.time = query->time;
-        query_inst.p = xfmPoint(world2local, query->p); 
+        query_inst.p = xfmPoint(world2local, instance->rebase(query->p));
         query_inst.radius = query->radius * similarityScale;
 
+        ((Scene*)instance->object)->buildOnDemand();
+
         PointQueryContext context_inst(
           (Scene*)instance->object, 
           context->query_ws, 
@@ -116,8 +122,9 @@ namespace embree
         const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(xfmPoint(world2local, instance->rebase(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        ((Scene*)instance->object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
@@ -143,8 +150,9 @@ namespace embree
         const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(xfmPoint(world2local, instance->rebase(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        ((Scene*)instance->object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
@@ -165,13 +173,17 @@ namespace embree
       const bool similtude = context->query_type == POINT_QUERY_TYPE_SPHERE
                            && similarityTransform(world2local, &similarityScale);
 
-      if (likely(instance_id_stack::push(context->userContext, prim.instID_, 0, world2local, local2world)))
+      AffineSpace3fa world2inst = world2local, inst2world = local2world;
+      instance->addOrigin(inst2world, world2inst);
+      if (likely(instance_id_stack::push(context->userContext, prim.instID_, 0, world2inst, inst2world)))
       {
         PointQuery query_inst;
         query_inst.time = query->time;
-        query_inst.p = xfmPoint(world2local, query->p); 
+        query_inst.p = xfmPoint(world2local, instance->rebase(query->p));
         query_inst.radius = query->radius * similarityScale;
         
+        ((Scene*)instance->object)->buildOnDemand();
+
         PointQueryContext context_inst(
           (Scene*)instance->object, 
           context->query_ws, 
@@ -206,8 +218,9 @@ namespace embree
         AffineSpace3vf<K> world2local = instance->getWorld2Local();
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = xfmPoint(world2local, instance->template rebase<K>(valid, ray_org));
         ray.dir = xfmVector(world2local, ray_dir);
+        ((Scene*)instance->object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.intersect(valid, ray, &newcontext);
         ray.org = ray_org;
@@ -235,8 +248,9 @@ namespace embree
         AffineSpace3vf<K> world2local = instance->getWorld2Local();
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = xfmPoint(world2local, instance->template rebase<K>(valid, ray_org));
         ray.dir = xfmVector(world2local, ray_dir);
+        ((Scene*)instance->object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.occluded(valid, ray, &newcontext);
         ray.org = ray_org;
@@ -265,8 +279,9 @@ namespace embree
         AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = xfmPoint(world2local, instance->template rebase<K>(valid, ray_org));
         ray.dir = xfmVector(world2local, ray_dir);
+        ((Scene*)instance->object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.intersect(valid, ray, &newcontext);
         ray.org = ray_org;
@@ -294,8 +309,9 @@ namespace embree
         AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = xfmPoint(world2local, instance->template rebase<K>(valid, ray_org));
         ray.dir = xfmVector(world2local, ray_dir);
+        ((Scene*)instance->object)->buildOnDemand();
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.occluded(valid, ray, &newcontext);
         ray.org = ray_org;
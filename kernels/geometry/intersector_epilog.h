@@ -16,6 +16,74 @@ namespace embree
       __forceinline void operator() (vfloat<M>& u, vfloat<M>& v, Vec3vf<M>& Ng) const {}
     };
 
+    /* inserts a hit into the sorted multi hit buffer of the query and shrinks the ray to the last hit once the buffer is full */
+    __forceinline bool insertMultiHit(RayHit& ray, RayQueryContext* context, const float t, const Hit& h)
+    {
+      RTCMultiHitBuffer* buffer = context->getMultiHitBuffer();
+      const unsigned int maxHits = buffer->maxHits;
+      unsigned int numHits = buffer->numHits;
+      if (unlikely(maxHits == 0)) return false;
+
+      /* find insertion position behind all hits at the same or smaller distance, comparing 4 hits at once */
+      unsigned int pos = 0;
+      while (pos+4 <= numHits) {
+        const size_t farther = movemask(vfloat4::loadu(&buffer->tfar[pos]) > vfloat4(t));
+        if (farther) { pos += (unsigned int) bsf(farther); break; }
+        pos += 4;
+      }
+      while (pos < numHits && buffer->tfar[pos] <= t) pos++;
+      if (pos == maxHits) return false;
+
+      /* primitives referenced from multiple leaves due to spatial splits report identical hits */
+      for (unsigned int i=pos; i>0 && buffer->tfar[i-1] == t; i--)
+      {
+        const Hit& other = *(const Hit*) &buffer->hit[i-1];
+        if (other.geomID != h.geomID || other.primID != h.primID) continue;
+        if (!instance_id_stack::equal_UU(other.instID,h.instID)) continue;
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+        if (!instance_id_stack::equal_UU(other.instPrimID,h.instPrimID)) continue;
+#endif
+        return false;
+      }
+
+      /* shift farther hits back as a block, dropping the last one if the buffer is full */
+      if (numHits < maxHits) buffer->numHits = ++numHits;
+      const unsigned int numMoved = numHits-1-pos;
+      memmove(&buffer->tfar[pos+1],&buffer->tfar[pos],numMoved*sizeof(float));
+      memmove(&buffer->hit [pos+1],&buffer->hit [pos],numMoved*sizeof(RTCHit));
+      buffer->tfar[pos] = t;
+      *(Hit*) &buffer->hit[pos] = h;
+
+      if (numHits == maxHits)
+        ray.tfar = buffer->tfar[maxHits-1];
+      return true;
+    }
+
+    /* performs ray mask test and intersection filter for a single hit and inserts it into the multi hit buffer */
+    template<bool filter>
+    __forceinline bool multiHitEpilog1(RayHit& ray, RayQueryContext* context, Geometry* geometry,
+                                       const unsigned int geomID, const unsigned int primID,
+                                       const float t, const float u, const float v, const Vec3fa& Ng)
+    {
+#if defined(EMBREE_RAY_MASK)
+      if (filter && (geometry->mask & ray.mask) == 0) return false;
+#endif
+      HitK<1> h(context->user,geomID,primID,u,v,Ng);
+
+#if defined(EMBREE_FILTER_FUNCTION)
+      if (filter) {
+        if (unlikely(context->hasContextFilter() || geometry->hasIntersectionFilter())) {
+          const float old_t = ray.tfar;
+          ray.tfar = t;
+          const bool found = runIntersectionFilter1(geometry,ray,context,h);
+          ray.tfar = old_t;
+          if (!found) return false;
+        }
+      }
+#endif
+      return insertMultiHit(ray,context,t,h);
+    }
+
 
     template<bool filter>
     struct Intersect1Epilog1
@@ -37,8 +105,19 @@ namespace embree
         /* ray mask test */
         Scene* scene MAYBE_UNUSED = context->scene;
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
+        /* collect hit into the multi hit buffer */
+        if (unlikely(context->getMultiHitBuffer())) {
+          hit.finalize();
+          return multiHitEpilog1<filter>(ray,context,geometry,geomID,primID,hit.t,hit.u,hit.v,hit.Ng);
+        }
+
 #if defined(EMBREE_RAY_MASK)
-        if ((geometry->mask & ray.mask) == 0) return false;
+        if (filter && (geometry->mask & ray.mask) == 0) return false;
 #endif
         hit.finalize();
 
@@ -92,9 +171,12 @@ namespace embree
         Scene* scene MAYBE_UNUSED = context->scene;
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
 
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
 
 #if defined(EMBREE_RAY_MASK)
-        if ((geometry->mask & ray.mask) == 0) return false;
+        if (filter && (geometry->mask & ray.mask) == 0) return false;
 #endif
         hit.finalize();
 
@@ -136,8 +218,13 @@ namespace embree
         /* ray mask test */
         Scene* scene MAYBE_UNUSED = context->scene;
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
 #if defined(EMBREE_RAY_MASK)
-        if ((geometry->mask & ray.mask[k]) == 0)
+        if (filter && (geometry->mask & ray.mask[k]) == 0)
           return false;
 #endif
         hit.finalize();
@@ -194,8 +281,13 @@ namespace embree
         /* ray mask test */
         Scene* scene MAYBE_UNUSED = context->scene;
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
 #if defined(EMBREE_RAY_MASK)
-        if ((geometry->mask & ray.mask[k]) == 0)
+        if (filter && (geometry->mask & ray.mask[k]) == 0)
           return false;
 #endif
 
@@ -236,7 +328,30 @@ namespace embree
       {
         Scene* scene MAYBE_UNUSED = context->scene;
         vbool<M> valid = valid_i;
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->hasIgnoredPrimitive())) {
+          valid &= !context->isIgnored<M>(geomIDs,primIDs);
+          if (none(valid)) return false;
+        }
+
         hit.finalize();
+
+        /* collect hits into the multi hit buffer front to back, such that a full buffer culls the remaining hits */
+        if (unlikely(context->getMultiHitBuffer()))
+        {
+          bool inserted = false;
+          while (any(valid))
+          {
+            const size_t j = select_min(valid,hit.vt);
+            clear(valid,j);
+            const Vec2f uv = hit.uv(j);
+            inserted |= multiHitEpilog1<filter>(ray,context,scene->get(geomIDs[j]),geomIDs[j],primIDs[j],hit.t(j),uv.x,uv.y,hit.Ng(j));
+            valid &= hit.vt <= ray.tfar;
+          }
+          return inserted;
+        }
+
         size_t i = select_min(valid,hit.vt);
         unsigned int geomID = geomIDs[i];
 
@@ -255,7 +370,7 @@ namespace embree
 
 #if defined(EMBREE_RAY_MASK)
           /* goto next hit if mask test fails */
-          if ((geometry->mask & ray.mask) == 0) {
+          if (filter && (geometry->mask & ray.mask) == 0) {
             clear(valid,i);
             continue;
           }
@@ -319,12 +434,19 @@ namespace embree
       __forceinline bool operator() (const vbool<M>& valid_i, Hit& hit) const
       {
         Scene* scene MAYBE_UNUSED = context->scene;
+        vbool<M> valid = valid_i;
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->hasIgnoredPrimitive())) {
+          valid &= !context->isIgnored<M>(geomIDs,primIDs);
+          if (none(valid)) return false;
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
         if (unlikely(filter))
           hit.finalize(); /* called only once */
 
-        vbool<M> valid = valid_i;
         size_t m=movemask(valid);
         goto entry;
         while (true)
@@ -338,7 +460,7 @@ namespace embree
 
 #if defined(EMBREE_RAY_MASK)
           /* goto next hit if mask test fails */
-          if ((geometry->mask & ray.mask) == 0) {
+          if (filter && (geometry->mask & ray.mask) == 0) {
             m=btc(m,i);
             continue;
           }
@@ -388,13 +510,33 @@ namespace embree
         /* ray mask test */
         Scene* scene MAYBE_UNUSED = context->scene;
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
 #if defined(EMBREE_RAY_MASK)
-        if ((geometry->mask & ray.mask) == 0) return false;
+        if (filter && (geometry->mask & ray.mask) == 0) return false;
 #endif
 
         vbool<M> valid = valid_i;
         hit.finalize();
 
+        /* collect hits into the multi hit buffer front to back, such that a full buffer culls the remaining hits */
+        if (unlikely(context->getMultiHitBuffer()))
+        {
+          bool inserted = false;
+          while (any(valid))
+          {
+            const size_t j = select_min(valid,hit.vt);
+            clear(valid,j);
+            const Vec2f uv = hit.uv(j);
+            inserted |= multiHitEpilog1<filter>(ray,context,geometry,geomID,primID,hit.t(j),uv.x,uv.y,hit.Ng(j));
+            valid &= hit.vt <= ray.tfar;
+          }
+          return inserted;
+        }
+
         size_t i = select_min(valid,hit.vt);
 
         /* intersection filter test */
@@ -460,8 +602,13 @@ namespace embree
         /* ray mask test */
         Scene* scene MAYBE_UNUSED = context->scene;
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
 #if defined(EMBREE_RAY_MASK)
-        if ((geometry->mask & ray.mask) == 0) return false;
+        if (filter && (geometry->mask & ray.mask) == 0) return false;
 #endif
 
         /* intersection filter test */
@@ -516,9 +663,13 @@ namespace embree
         const unsigned int primID = primIDs[i];
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
 
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
         /* ray masking test */
 #if defined(EMBREE_RAY_MASK)
-        valid &= (geometry->mask & ray.mask) != 0;
+        if (filter) valid &= (geometry->mask & ray.mask) != 0;
         if (unlikely(none(valid))) return false;
 #endif
 
@@ -581,8 +732,13 @@ namespace embree
         const unsigned int geomID MAYBE_UNUSED = geomIDs[i];
         const unsigned int primID MAYBE_UNUSED = primIDs[i];
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
 #if defined(EMBREE_RAY_MASK)
-        valid &= (geometry->mask & ray.mask) != 0;
+        if (filter) valid &= (geometry->mask & ray.mask) != 0;
         if (unlikely(none(valid))) return valid;
 #endif
 
@@ -634,9 +790,13 @@ namespace embree
         Scene* scene MAYBE_UNUSED = context->scene;
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
 
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
         /* ray masking test */
 #if defined(EMBREE_RAY_MASK)
-        valid &= (geometry->mask & ray.mask) != 0;
+        if (filter) valid &= (geometry->mask & ray.mask) != 0;
         if (unlikely(none(valid))) return false;
 #endif
 
@@ -694,8 +854,12 @@ namespace embree
         Scene* scene MAYBE_UNUSED = context->scene;
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
 
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
 #if defined(EMBREE_RAY_MASK)
-        valid &= (geometry->mask & ray.mask) != 0;
+        if (filter) valid &= (geometry->mask & ray.mask) != 0;
         if (unlikely(none(valid))) return false;
 #endif
 
@@ -742,6 +906,13 @@ namespace embree
       {
         Scene* scene MAYBE_UNUSED = context->scene;
         vbool<M> valid = valid_i;
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->hasIgnoredPrimitive())) {
+          valid &= !context->isIgnored<M>(geomIDs,primIDs);
+          if (none(valid)) return false;
+        }
+
         hit.finalize();
         size_t i = select_min(valid,hit.vt);
         assert(i<M);
@@ -762,7 +933,7 @@ namespace embree
 
 #if defined(EMBREE_RAY_MASK)
           /* goto next hit if mask test fails */
-          if ((geometry->mask & ray.mask[k]) == 0) {
+          if (filter && (geometry->mask & ray.mask[k]) == 0) {
             clear(valid,i);
             continue;
           }
@@ -827,13 +998,19 @@ namespace embree
       __forceinline bool operator() (const vbool<M>& valid_i, Hit& hit) const
       {
         Scene* scene MAYBE_UNUSED = context->scene;
+        vbool<M> valid = valid_i;
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->hasIgnoredPrimitive())) {
+          valid &= !context->isIgnored<M>(geomIDs,primIDs);
+          if (none(valid)) return false;
+        }
 
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
         if (unlikely(filter))
           hit.finalize(); /* called only once */
 
-        vbool<M> valid = valid_i;
         size_t m=movemask(valid);
         goto entry;
         while (true)
@@ -847,7 +1024,7 @@ namespace embree
 
 #if defined(EMBREE_RAY_MASK)
           /* goto next hit if mask test fails */
-          if ((geometry->mask & ray.mask[k]) == 0) {
+          if (filter && (geometry->mask & ray.mask[k]) == 0) {
             m=btc(m,i);
             continue;
           }
@@ -896,9 +1073,14 @@ namespace embree
       {
         Scene* scene MAYBE_UNUSED = context->scene;
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
 #if defined(EMBREE_RAY_MASK)
         /* ray mask test */
-        if ((geometry->mask & ray.mask[k]) == 0)
+        if (filter && (geometry->mask & ray.mask[k]) == 0)
           return false;
 #endif
 
@@ -971,9 +1153,14 @@ namespace embree
       {
         Scene* scene MAYBE_UNUSED = context->scene;
         Geometry* geometry MAYBE_UNUSED = scene->get(geomID);
+
+        /* skip the primitive to ignore */
+        if (unlikely(context->isIgnored(geomID,primID)))
+          return false;
+
 #if defined(EMBREE_RAY_MASK)
         /* ray mask test */
-        if ((geometry->mask & ray.mask[k]) == 0)
+        if (filter && (geometry->mask & ray.mask[k]) == 0)
           return false;
 #endif
 
@@ -999,5 +1186,60 @@ namespace embree
         return true;
       }
     };
+
+    /* forwards hits of a curve clipped to a sub-segment to the wrapped epilog, maps u
+     * back to the parent curve and keeps only hits inside the half-open range [lower,upper) */
+    template<typename Epilog>
+    struct CurveSegmentEpilog
+    {
+      template<typename Hit>
+      struct SegmentHit
+      {
+        typedef decltype(Hit::vu) vfloatM;
+
+        __forceinline SegmentHit(const Hit& hit, const BBox1f& u)
+          : hit(hit), vu(madd(hit.vu,vfloatM(u.size()),vfloatM(u.lower))), vv(hit.vv), vt(hit.vt) {}
+
+        __forceinline void finalize() {}
+
+        __forceinline Vec2f uv (const size_t i) const { return Vec2f(vu[i],vv[i]); }
+        __forceinline float t  (const size_t i) const { return vt[i]; }
+        __forceinline Vec3fa Ng(const size_t i) const { return hit.Ng(i); }
+
+      public:
+        const Hit& hit;
+        vfloatM vu;
+        vfloatM vv;
+        vfloatM vt;
+      };
+
+      const Epilog epilog;
+      const BBox1f u_range;
+      const BBox1f u_clip;
+
+      __forceinline CurveSegmentEpilog(const Epilog& epilog, const BBox1f& u_range)
+        : epilog(epilog), u_range(u_range), u_clip(max(u_range.lower,0.0f),min(u_range.upper,1.0f)) {}
+
+      template<typename Hit>
+      __forceinline bool operator() (Hit& hit) const
+      {
+        hit.finalize();
+        Hit h = hit;
+        h.u = madd(hit.u,u_clip.size(),u_clip.lower);
+        if (!(u_range.lower <= h.u && h.u < u_range.upper)) return false;
+        return epilog(h);
+      }
+
+      template<typename vboolM, typename Hit>
+      __forceinline bool operator() (const vboolM& valid_i, Hit& hit) const
+      {
+        hit.finalize();
+        SegmentHit<Hit> h(hit,u_clip);
+        typedef typename SegmentHit<Hit>::vfloatM vfloatM;
+        const vboolM valid = valid_i & (vfloatM(u_range.lower) <= h.vu) & (h.vu < vfloatM(u_range.upper));
+        if (none(valid)) return false;
+        return epilog(valid,h);
+      }
+    };
   }
 }
@@ -12,6 +12,7 @@
 #include "trianglei.h"
 #include "quadv.h"
 #include "quadi.h"
+#include "trianglepairv.h"
 #include "subdivpatch1.h"
 #include "object.h"
 #include "instance.h"
@@ -254,6 +255,28 @@ namespace embree
     return sizeof(Quad4v);
   }
 
+  /********************** TrianglePair4v **************************/
+
+  template<>
+  const char* TrianglePair4v::Type::name () const {
+    return "trianglepair4v";
+  }
+
+  template<>
+  size_t TrianglePair4v::Type::sizeActive(const char* This) const {
+    return ((TrianglePair4v*)This)->size();
+  }
+
+  template<>
+  size_t TrianglePair4v::Type::sizeTotal(const char* This) const {
+    return 4;
+  }
+
+  template<>
+  size_t TrianglePair4v::Type::getBytes(const char* This) const {
+    return sizeof(TrianglePair4v);
+  }
+
   /********************** Quad4i **************************/
 
   template<>
@@ -10,7 +10,7 @@ namespace embree
 {
   namespace isa
   {
-    template<int M>
+    template<int M, bool cull = false>
     struct QuadHitM
     {
       __forceinline QuadHitM() {}
@@ -32,16 +32,19 @@ namespace embree
         const vfloat<M> v = min(V * rcpAbsDen,1.0f);
         const vfloat<M> u1 = vfloat<M>(1.0f) - u;
         const vfloat<M> v1 = vfloat<M>(1.0f) - v;
-#if !defined(__AVX__) || defined(EMBREE_BACKFACE_CULLING)
+#if defined(__AVX__)
+        if (!BackfaceCulling<cull>::enabled)
+        {
+          const vfloat<M> flip = select(flags,vfloat<M>(-1.0f),vfloat<M>(1.0f));
+          vv = select(flags,u1,v);
+          vu = select(flags,v1,u);
+          vNg = Vec3vf<M>(flip*tri_Ng.x,flip*tri_Ng.y,flip*tri_Ng.z);
+          return;
+        }
+#endif
         vu = select(flags,u1,u);
         vv = select(flags,v1,v);
         vNg = Vec3vf<M>(tri_Ng.x,tri_Ng.y,tri_Ng.z);
-#else
-        const vfloat<M> flip = select(flags,vfloat<M>(-1.0f),vfloat<M>(1.0f));
-        vv = select(flags,u1,v);
-        vu = select(flags,v1,u);
-        vNg = Vec3vf<M>(flip*tri_Ng.x,flip*tri_Ng.y,flip*tri_Ng.z);
-#endif
       }
 
       __forceinline Vec2f uv(const size_t i)
@@ -111,11 +114,11 @@ namespace embree
     /* ----------------------------- */
 
 
-    template<int M, bool filter>
+    template<int M, bool filter, bool cull = false>
     struct QuadMIntersector1MoellerTrumbore;
 
     /*! Intersects M quads with 1 ray */
-    template<int M, bool filter>
+    template<int M, bool filter, bool cull>
     struct QuadMIntersector1MoellerTrumbore
     {
       __forceinline QuadMIntersector1MoellerTrumbore() {}
@@ -128,7 +131,7 @@ namespace embree
       {
         UVIdentity<M> mapUV;
         MoellerTrumboreHitM<M,UVIdentity<M>> hit(mapUV);
-        MoellerTrumboreIntersector1<M> intersector(ray,nullptr);
+        MoellerTrumboreIntersector1<M,true,cull> intersector(ray,nullptr);
         Intersect1EpilogM<M,filter> epilog(ray,context,geomID,primID);
 
         /* intersect first triangle */
@@ -150,7 +153,7 @@ namespace embree
       {
         UVIdentity<M> mapUV;
         MoellerTrumboreHitM<M,UVIdentity<M>> hit(mapUV);
-        MoellerTrumboreIntersector1<M> intersector(ray,nullptr);
+        MoellerTrumboreIntersector1<M,true,cull> intersector(ray,nullptr);
         Occluded1EpilogM<M,filter> epilog(ray,context,geomID,primID);
 
         /* intersect first triangle */
@@ -175,8 +178,8 @@ namespace embree
 #if defined(__AVX__)
 
     /*! Intersects 4 quads with 1 ray using AVX */
-    template<bool filter>
-    struct QuadMIntersector1MoellerTrumbore<4,filter>
+    template<bool filter, bool cull>
+    struct QuadMIntersector1MoellerTrumbore<4,filter,cull>
     {
       __forceinline QuadMIntersector1MoellerTrumbore() {}
 
@@ -186,29 +189,29 @@ namespace embree
       __forceinline bool intersect(Ray& ray, const Vec3vf4& v0, const Vec3vf4& v1, const Vec3vf4& v2, const Vec3vf4& v3, const Epilog& epilog) const
       {
         const Vec3vf8 vtx0(vfloat8(v0.x,v2.x),vfloat8(v0.y,v2.y),vfloat8(v0.z,v2.z));
-#if !defined(EMBREE_BACKFACE_CULLING)
-        const Vec3vf8 vtx1(vfloat8(v1.x),vfloat8(v1.y),vfloat8(v1.z));
-        const Vec3vf8 vtx2(vfloat8(v3.x),vfloat8(v3.y),vfloat8(v3.z));        
-#else
-        const Vec3vf8 vtx1(vfloat8(v1.x,v3.x),vfloat8(v1.y,v3.y),vfloat8(v1.z,v3.z));
-        const Vec3vf8 vtx2(vfloat8(v3.x,v1.x),vfloat8(v3.y,v1.y),vfloat8(v3.z,v1.z));
-#endif
+        /* with backface culling the second triangle has to keep its orientation */
+        const Vec3vf8 vtx1 = BackfaceCulling<cull>::enabled
+          ? Vec3vf8(vfloat8(v1.x,v3.x),vfloat8(v1.y,v3.y),vfloat8(v1.z,v3.z))
+          : Vec3vf8(vfloat8(v1.x),vfloat8(v1.y),vfloat8(v1.z));
+        const Vec3vf8 vtx2 = BackfaceCulling<cull>::enabled
+          ? Vec3vf8(vfloat8(v3.x,v1.x),vfloat8(v3.y,v1.y),vfloat8(v3.z,v1.z))
+          : Vec3vf8(vfloat8(v3.x),vfloat8(v3.y),vfloat8(v3.z));
         UVIdentity<8> mapUV;
         MoellerTrumboreHitM<8,UVIdentity<8>> hit(mapUV);
-        MoellerTrumboreIntersector1<8> intersector(ray,nullptr);
+        MoellerTrumboreIntersector1<8,true,cull> intersector(ray,nullptr);
         const vbool8 flags(0,0,0,0,1,1,1,1);
         if (unlikely(intersector.intersect(ray,vtx0,vtx1,vtx2,mapUV,hit)))
         {
           vfloat8 U = hit.U, V = hit.V, absDen = hit.absDen;
 
-#if !defined(EMBREE_BACKFACE_CULLING)
-          hit.U = select(flags,absDen-V,U);
-          hit.V = select(flags,absDen-U,V);
-          hit.vNg *= select(flags,vfloat8(-1.0f),vfloat8(1.0f)); // FIXME: use XOR
-#else
-          hit.U = select(flags,absDen-U,U);
-          hit.V = select(flags,absDen-V,V);
-#endif
+          if (!BackfaceCulling<cull>::enabled) {
+            hit.U = select(flags,absDen-V,U);
+            hit.V = select(flags,absDen-U,V);
+            hit.vNg *= select(flags,vfloat8(-1.0f),vfloat8(1.0f)); // FIXME: use XOR
+          } else {
+            hit.U = select(flags,absDen-U,U);
+            hit.V = select(flags,absDen-V,V);
+          }
           if (unlikely(epilog(hit.valid,hit)))
             return true;
         }
@@ -240,7 +243,7 @@ namespace embree
     struct MoellerTrumboreIntersector1KTriangleM
     {
       /*! Intersect k'th ray from ray packet of size K with M triangles. */
-      template<int M, int K, typename Epilog>
+      template<int M, int K, bool cull = false, typename Epilog>
       static  __forceinline bool intersect(RayK<K>& ray,
                                            size_t k,
                                            const Vec3vf<M>& tri_v0,
@@ -264,11 +267,11 @@ namespace embree
         const vfloat<M> V = dot(R,Vec3vf<M>(tri_e1)) ^ sgnDen;
         
         /* perform backface culling */
-#if defined(EMBREE_BACKFACE_CULLING)
-        vbool<M> valid = (den < vfloat<M>(zero)) & (U >= 0.0f) & (V >= 0.0f) & (U+V<=absDen);
-#else
-        vbool<M> valid = (den != vfloat<M>(zero)) & (U >= 0.0f) & (V >= 0.0f) & (U+V<=absDen);
-#endif
+        vbool<M> valid = (U >= 0.0f) & (V >= 0.0f) & (U+V<=absDen);
+        if (BackfaceCulling<cull>::enabled)
+          valid &= den < vfloat<M>(zero);
+        else
+          valid &= den != vfloat<M>(zero);
         if (likely(none(valid))) return false;
         
         /* perform depth test */
@@ -277,11 +280,11 @@ namespace embree
         if (likely(none(valid))) return false;
         
         /* calculate hit information */
-        QuadHitM<M> hit(valid,U,V,T,absDen,tri_Ng,flags);
+        QuadHitM<M,cull> hit(valid,U,V,T,absDen,tri_Ng,flags);
         return epilog(valid,hit);
       }
       
-      template<int M, int K, typename Epilog>
+      template<int M, int K, bool cull = false, typename Epilog>
       static __forceinline bool intersect1(RayK<K>& ray,
                                            size_t k,
                                            const Vec3vf<M>& v0,
@@ -293,11 +296,11 @@ namespace embree
         const Vec3vf<M> e1 = v0-v1;
         const Vec3vf<M> e2 = v2-v0;
         const Vec3vf<M> Ng = cross(e2,e1);
-        return intersect<M,K>(ray,k,v0,e1,e2,Ng,flags,epilog);
+        return intersect<M,K,cull>(ray,k,v0,e1,e2,Ng,flags,epilog);
       }
     };
 
-    template<int M, int K, bool filter>
+    template<int M, int K, bool filter, bool cull = false>
     struct QuadMIntersectorKMoellerTrumboreBase
     {
       __forceinline QuadMIntersectorKMoellerTrumboreBase(const vbool<K>& valid, const RayK<K>& ray) {}
@@ -342,13 +345,11 @@ namespace embree
         if (unlikely(none(valid))) return false;
         
         /* perform backface culling */
-#if defined(EMBREE_BACKFACE_CULLING)
-        valid &= den < vfloat<K>(zero);
-        if (unlikely(none(valid))) return false;
-#else
-        valid &= den != vfloat<K>(zero);
+        if (BackfaceCulling<cull>::enabled)
+          valid &= den < vfloat<K>(zero);
+        else
+          valid &= den != vfloat<K>(zero);
         if (unlikely(none(valid))) return false;
-#endif
         
         /* calculate hit information */
         QuadHitK<K> hit(U,V,T,absDen,tri_Ng,flags);
@@ -388,19 +389,19 @@ namespace embree
       }
     };
 
-    template<int M, int K, bool filter>
-    struct QuadMIntersectorKMoellerTrumbore : public QuadMIntersectorKMoellerTrumboreBase<M,K,filter>
+    template<int M, int K, bool filter, bool cull = false>
+    struct QuadMIntersectorKMoellerTrumbore : public QuadMIntersectorKMoellerTrumboreBase<M,K,filter,cull>
     {
       __forceinline QuadMIntersectorKMoellerTrumbore(const vbool<K>& valid, const RayK<K>& ray)
-        : QuadMIntersectorKMoellerTrumboreBase<M,K,filter>(valid,ray) {}
+        : QuadMIntersectorKMoellerTrumboreBase<M,K,filter,cull>(valid,ray) {}
 
       __forceinline void intersect1(RayHitK<K>& ray, size_t k, RayQueryContext* context,
                                     const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const Vec3vf<M>& v3,
                                     const vuint<M>& geomID, const vuint<M>& primID) const
       {
         Intersect1KEpilogM<M,K,filter> epilog(ray,k,context,geomID,primID);
-        MoellerTrumboreIntersector1KTriangleM::intersect1<M,K>(ray,k,v0,v1,v3,vbool<M>(false),epilog);
-        MoellerTrumboreIntersector1KTriangleM::intersect1<M,K>(ray,k,v2,v3,v1,vbool<M>(true ),epilog);
+        MoellerTrumboreIntersector1KTriangleM::intersect1<M,K,cull>(ray,k,v0,v1,v3,vbool<M>(false),epilog);
+        MoellerTrumboreIntersector1KTriangleM::intersect1<M,K,cull>(ray,k,v2,v3,v1,vbool<M>(true ),epilog);
       }
       
       __forceinline bool occluded1(RayK<K>& ray, size_t k, RayQueryContext* context,
@@ -408,8 +409,8 @@ namespace embree
                                    const vuint<M>& geomID, const vuint<M>& primID) const
       {
         Occluded1KEpilogM<M,K,filter> epilog(ray,k,context,geomID,primID);
-        if (MoellerTrumboreIntersector1KTriangleM::intersect1<M,K>(ray,k,v0,v1,v3,vbool<M>(false),epilog)) return true;
-        if (MoellerTrumboreIntersector1KTriangleM::intersect1<M,K>(ray,k,v2,v3,v1,vbool<M>(true ),epilog)) return true;
+        if (MoellerTrumboreIntersector1KTriangleM::intersect1<M,K,cull>(ray,k,v0,v1,v3,vbool<M>(false),epilog)) return true;
+        if (MoellerTrumboreIntersector1KTriangleM::intersect1<M,K,cull>(ray,k,v2,v3,v1,vbool<M>(true ),epilog)) return true;
         return false;
       }
     };
@@ -418,26 +419,26 @@ namespace embree
 #if defined(__AVX__)
 
     /*! Intersects 4 quads with 1 ray using AVX */
-    template<int K, bool filter>
-    struct QuadMIntersectorKMoellerTrumbore<4,K,filter> : public QuadMIntersectorKMoellerTrumboreBase<4,K,filter>
+    template<int K, bool filter, bool cull>
+    struct QuadMIntersectorKMoellerTrumbore<4,K,filter,cull> : public QuadMIntersectorKMoellerTrumboreBase<4,K,filter,cull>
     {
       __forceinline QuadMIntersectorKMoellerTrumbore(const vbool<K>& valid, const RayK<K>& ray)
-        : QuadMIntersectorKMoellerTrumboreBase<4,K,filter>(valid,ray) {}
+        : QuadMIntersectorKMoellerTrumboreBase<4,K,filter,cull>(valid,ray) {}
       
       template<typename Epilog>
       __forceinline bool intersect1(RayK<K>& ray, size_t k,
                                     const Vec3vf4& v0, const Vec3vf4& v1, const Vec3vf4& v2, const Vec3vf4& v3, const Epilog& epilog) const
       {
         const Vec3vf8 vtx0(vfloat8(v0.x,v2.x),vfloat8(v0.y,v2.y),vfloat8(v0.z,v2.z));
-#if !defined(EMBREE_BACKFACE_CULLING)
-        const Vec3vf8 vtx1(vfloat8(v1.x),vfloat8(v1.y),vfloat8(v1.z));
-        const Vec3vf8 vtx2(vfloat8(v3.x),vfloat8(v3.y),vfloat8(v3.z));
-#else
-        const Vec3vf8 vtx1(vfloat8(v1.x,v3.x),vfloat8(v1.y,v3.y),vfloat8(v1.z,v3.z));
-        const Vec3vf8 vtx2(vfloat8(v3.x,v1.x),vfloat8(v3.y,v1.y),vfloat8(v3.z,v1.z));
-#endif
+        /* with backface culling the second triangle has to keep its orientation */
+        const Vec3vf8 vtx1 = BackfaceCulling<cull>::enabled
+          ? Vec3vf8(vfloat8(v1.x,v3.x),vfloat8(v1.y,v3.y),vfloat8(v1.z,v3.z))
+          : Vec3vf8(vfloat8(v1.x),vfloat8(v1.y),vfloat8(v1.z));
+        const Vec3vf8 vtx2 = BackfaceCulling<cull>::enabled
+          ? Vec3vf8(vfloat8(v3.x,v1.x),vfloat8(v3.y,v1.y),vfloat8(v3.z,v1.z))
+          : Vec3vf8(vfloat8(v3.x),vfloat8(v3.y),vfloat8(v3.z));
         const vbool8 flags(0,0,0,0,1,1,1,1);
-        return MoellerTrumboreIntersector1KTriangleM::intersect1<8,K>(ray,k,vtx0,vtx1,vtx2,flags,epilog); 
+        return MoellerTrumboreIntersector1KTriangleM::intersect1<8,K,cull>(ray,k,vtx0,vtx1,vtx2,flags,epilog); 
       }
       
       __forceinline bool intersect1(RayHitK<K>& ray, size_t k, RayQueryContext* context,
@@ -12,11 +12,11 @@ namespace embree
   namespace isa
   {
     /*! Intersects M quads with 1 ray */
-    template<int M, bool filter>
+    template<int M, bool filter, bool cull = false>
     struct QuadMvIntersector1Moeller
     {
       typedef QuadMv<M> Primitive;
-      typedef QuadMIntersector1MoellerTrumbore<M,filter> Precalculations;
+      typedef QuadMIntersector1MoellerTrumbore<M,filter,cull> Precalculations;
         
       /*! Intersect a ray with the M quads and updates the hit. */
       static __forceinline void intersect(const Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive& quad)
@@ -39,11 +39,11 @@ namespace embree
     };
 
     /*! Intersects M triangles with K rays. */
-    template<int M, int K, bool filter>
+    template<int M, int K, bool filter, bool cull = false>
     struct QuadMvIntersectorKMoeller
     {
       typedef QuadMv<M> Primitive;
-      typedef QuadMIntersectorKMoellerTrumbore<M,K,filter> Precalculations;
+      typedef QuadMIntersectorKMoellerTrumbore<M,K,filter,cull> Precalculations;
 
       /*! Intersects K rays with M triangles. */
       static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, RayQueryContext* context, const QuadMv<M>& quad)
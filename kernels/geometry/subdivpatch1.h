@@ -8,6 +8,7 @@
 
 namespace embree
 {
+  class FastAllocator;
 
   struct __aligned(64) SubdivPatch1 : public SubdivPatch1Base
   {
@@ -35,4 +36,23 @@ namespace embree
                         const int simd_width) 
       : SubdivPatch1Base(gID,pID,subPatch,mesh,time,uv,edge_level,subdiv,simd_width) {}
   };
+
+  /*! subdivision patch with conservative bounds whose displaced grid
+   *  gets created when a ray reaches the patch the first time */
+  struct __aligned(64) SubdivPatch1Lazy : public SubdivPatch1
+  {
+    SubdivPatch1Lazy (const unsigned int gID,
+                      const unsigned int pID,
+                      const unsigned int subPatch,
+                      const SubdivMesh *const mesh,
+                      const Vec2f uv[4],
+                      const float edge_level[4],
+                      const int subdiv[4],
+                      const int simd_width,
+                      FastAllocator* alloc) 
+      : SubdivPatch1(gID,pID,subPatch,mesh,0,uv,edge_level,subdiv,simd_width), alloc(alloc) {}
+
+  public:
+    FastAllocator* alloc;  //!< allocator of the BVH to create the grid in
+  };
 }
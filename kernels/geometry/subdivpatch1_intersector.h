@@ -29,14 +29,32 @@ namespace embree
         : T(valid,ray) {}
     };
 
+    /*! returns the grid of a lazy patch and creates it the first time a ray reaches the patch */
+    static __noinline GridSOA* getLazyGrid(RayQueryContext* context, const SubdivPatch1Lazy* patch_i)
+    {
+      SubdivPatch1Lazy* patch = (SubdivPatch1Lazy*) patch_i;
+      GridSOA* grid = (GridSOA*) patch->root_ref.get();
+      if (likely(grid)) return grid;
+
+      Lock<SpinLock> lock(patch->mtx);
+      grid = (GridSOA*) patch->root_ref.get();
+      if (grid) return grid;
+      
+      FastAllocator::CachedAllocator alloc = patch->alloc->getCachedAllocator();
+      grid = GridSOA::create(patch,1,context->scene,alloc);
+      patch->root_ref.set((int64_t) grid);
+      return grid;
+    }
+
     class SubdivPatch1Intersector1
     {
     public:
       typedef GridSOA Primitive;
       typedef SubdivPatch1Precalculations<GridSOAIntersector1::Precalculations> Precalculations;
 
-      static __forceinline bool processLazyNode(Precalculations& pre, RayQueryContext* context, const Primitive* prim, size_t& lazy_node)
+      static __forceinline bool processLazyNode(Precalculations& pre, RayQueryContext* context, const Primitive* prim, size_t ty, size_t& lazy_node)
       {
+        if (unlikely(ty == 2)) prim = getLazyGrid(context,(const SubdivPatch1Lazy*)prim);
         lazy_node = prim->root(0);
         pre.grid = (Primitive*)prim;
         return false;
@@ -47,7 +65,7 @@ namespace embree
         static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node) 
       {
         if (likely(ty == 0)) GridSOAIntersector1::intersect(pre,ray,context,prim,lazy_node);
-        else                 processLazyNode(pre,context,prim,lazy_node);
+        else                 processLazyNode(pre,context,prim,ty,lazy_node);
       }
 
       template<int N, bool robust>
@@ -60,7 +78,7 @@ namespace embree
       static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, Ray& ray, RayQueryContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node)
       {
         if (likely(ty == 0)) return GridSOAIntersector1::occluded(pre,ray,context,prim,lazy_node);
-        else                 return processLazyNode(pre,context,prim,lazy_node);
+        else                 return processLazyNode(pre,context,prim,ty,lazy_node);
       }
 
       template<int N, bool robust>
@@ -145,8 +163,9 @@ namespace embree
       typedef GridSOA Primitive;
       typedef SubdivPatch1PrecalculationsK<K,typename GridSOAIntersectorK<K>::Precalculations> Precalculations;
       
-      static __forceinline bool processLazyNode(Precalculations& pre, RayQueryContext* context, const Primitive* prim, size_t& lazy_node)
+      static __forceinline bool processLazyNode(Precalculations& pre, RayQueryContext* context, const Primitive* prim, size_t ty, size_t& lazy_node)
       {
+        if (unlikely(ty == 2)) prim = getLazyGrid(context,(const SubdivPatch1Lazy*)prim);
         lazy_node = prim->root(0);
         pre.grid = (Primitive*)prim;
         return false;
@@ -156,28 +175,28 @@ namespace embree
       static __forceinline void intersect(const vbool<K>& valid, const Accel::Intersectors* This, Precalculations& pre, RayHitK<K>& ray, RayQueryContext* context, const Primitive* prim, size_t ty, const TravRayK<K, robust> &tray, size_t& lazy_node)
       {
         if (likely(ty == 0)) GridSOAIntersectorK<K>::intersect(valid,pre,ray,context,prim,lazy_node);
-        else                 processLazyNode(pre,context,prim,lazy_node);
+        else                 processLazyNode(pre,context,prim,ty,lazy_node);
       }
       
       template<bool robust>        
       static __forceinline vbool<K> occluded(const vbool<K>& valid, const Accel::Intersectors* This, Precalculations& pre, RayK<K>& ray, RayQueryContext* context, const Primitive* prim, size_t ty, const TravRayK<K, robust> &tray, size_t& lazy_node)
       {
         if (likely(ty == 0)) return GridSOAIntersectorK<K>::occluded(valid,pre,ray,context,prim,lazy_node);
-        else                 return processLazyNode(pre,context,prim,lazy_node);
+        else                 return processLazyNode(pre,context,prim,ty,lazy_node);
       }
       
       template<int N, bool robust>              
         static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHitK<K>& ray, size_t k, RayQueryContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node)
       {
         if (likely(ty == 0)) GridSOAIntersectorK<K>::intersect(pre,ray,k,context,prim,lazy_node);
-        else                 processLazyNode(pre,context,prim,lazy_node);
+        else                 processLazyNode(pre,context,prim,ty,lazy_node);
       }
       
       template<int N, bool robust>              
       static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, RayK<K>& ray, size_t k, RayQueryContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node)
       {
         if (likely(ty == 0)) return GridSOAIntersectorK<K>::occluded(pre,ray,k,context,prim,lazy_node);
-        else                 return processLazyNode(pre,context,prim,lazy_node);
+        else                 return processLazyNode(pre,context,prim,ty,lazy_node);
       }
     };
 
@@ -11,11 +11,11 @@ namespace embree
   namespace isa
   {
     /*! Intersects M triangles with 1 ray */
-    template<int M, bool filter>
+    template<int M, bool filter, bool cull = false>
     struct TriangleMIntersector1Moeller
     {
       typedef TriangleM<M> Primitive;
-      typedef MoellerTrumboreIntersector1<M> Precalculations;
+      typedef MoellerTrumboreIntersector1<M,true,cull> Precalculations;
 
       /*! Intersect a ray with the M triangles and updates the hit. */
       static __forceinline void intersect(const Precalculations& pre, RayHit& ray, RayQueryContext* context, const TriangleM<M>& tri)
@@ -39,11 +39,11 @@ namespace embree
     };
 
     /*! Intersects M triangles with K rays. */
-    template<int M, int K, bool filter>
+    template<int M, int K, bool filter, bool cull = false>
     struct TriangleMIntersectorKMoeller
     {
       typedef TriangleM<M> Primitive;
-      typedef MoellerTrumboreIntersectorK<M,K> Precalculations;
+      typedef MoellerTrumboreIntersectorK<M,K,cull> Precalculations;
 
       /*! Intersects K rays with M triangles. */
       static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, RayQueryContext* context, const TriangleM<M>& tri)
@@ -18,6 +18,19 @@ namespace embree
 {
   namespace isa
   {
+    /*! Backface culling is either enabled for all queries at compile
+     *  time, or selected per query through the cull template parameter
+     *  of the intersectors. */
+    template<bool cull>
+    struct BackfaceCulling
+    {
+#if defined(EMBREE_BACKFACE_CULLING)
+      static const bool enabled = true;
+#else
+      static const bool enabled = cull;
+#endif
+    };
+
     template<int M, typename UVMapper>
     struct MoellerTrumboreHitM
     {
@@ -58,7 +71,7 @@ namespace embree
       Vec3vf<M> vNg;
     };
     
-    template<int M, bool early_out = true>
+    template<int M, bool early_out = true, bool cull = false>
     struct MoellerTrumboreIntersector1
     {
       __forceinline MoellerTrumboreIntersector1() {}
@@ -91,11 +104,10 @@ namespace embree
         const vfloat<M> V = asFloat(asInt(dot(R,Vec3vf<M>(tri_e1))) ^ asInt(sgnDen));
         
         /* perform backface culling */        
-#if defined(EMBREE_BACKFACE_CULLING)
-        valid &= (den < vfloat<M>(zero)) & (U >= 0.0f) & (V >= 0.0f) & (U+V<=absDen);
-#else
-        valid &= (den != vfloat<M>(zero)) & (U >= 0.0f) & (V >= 0.0f) & (U+V<=absDen);
-#endif
+        if (BackfaceCulling<cull>::enabled)
+          valid &= (den < vfloat<M>(zero)) & (U >= 0.0f) & (V >= 0.0f) & (U+V<=absDen);
+        else
+          valid &= (den != vfloat<M>(zero)) & (U >= 0.0f) & (V >= 0.0f) & (U+V<=absDen);
         if (likely(early_out && none(valid))) return false;
 
         /* perform depth test */
@@ -243,7 +255,7 @@ namespace embree
       const UVMapper& mapUV;
     };
     
-    template<int M, int K>
+    template<int M, int K, bool cull = false>
     struct MoellerTrumboreIntersectorK
     {
       __forceinline MoellerTrumboreIntersectorK() {}
@@ -293,13 +305,11 @@ namespace embree
         if (unlikely(none(valid))) return false;
         
         /* perform backface culling */
-#if defined(EMBREE_BACKFACE_CULLING)
-        valid &= den < vfloat<K>(zero);
-        if (unlikely(none(valid))) return false;
-#else
-        valid &= den != vfloat<K>(zero);
+        if (BackfaceCulling<cull>::enabled)
+          valid &= den < vfloat<K>(zero);
+        else
+          valid &= den != vfloat<K>(zero);
         if (unlikely(none(valid))) return false;
-#endif
         
         /* calculate hit information */
         new (&hit) MoellerTrumboreHitK<K,UVMapper>(U,V,T,absDen,tri_Ng,mapUV);
@@ -402,11 +412,11 @@ namespace embree
         const vfloat<M> V = dot(Vec3vf<M>(tri_e1),R) ^ sgnDen;
         
         /* perform backface culling */
-#if defined(EMBREE_BACKFACE_CULLING)
-        vbool<M> valid = (den < vfloat<M>(zero)) & (U >= 0.0f) & (V >= 0.0f) & (U+V<=absDen);
-#else
-        vbool<M> valid = (den != vfloat<M>(zero)) & (U >= 0.0f) & (V >= 0.0f) & (U+V<=absDen);
-#endif
+        vbool<M> valid = (U >= 0.0f) & (V >= 0.0f) & (U+V<=absDen);
+        if (BackfaceCulling<cull>::enabled)
+          valid &= den < vfloat<M>(zero);
+        else
+          valid &= den != vfloat<M>(zero);
         if (likely(none(valid))) return false;
         
         /* perform depth test */
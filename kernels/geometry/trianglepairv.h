@@ -0,0 +1,168 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Stores M pairs of triangles of a triangle mesh as quads (q0,q1,q2,q3)
+   * in struct of array layout. The first triangle of a pair is stored as
+   * (q0,q1,q3) and the second one as (q2,q3,q1), together with the
+   * primIDs of both original triangles and the rotations relative to
+   * their vertex order, see TriangleMesh::pairTriangles. Unpaired
+   * triangles are stored as degenerated quad with q2 == q3. */
+  template <int M>
+  struct TrianglePairMv
+  {
+  public:
+    struct Type : public PrimitiveType
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximum number of stored triangle pairs */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+  public:
+
+    /* Default constructor */
+    __forceinline TrianglePairMv() {}
+
+    /* Construction from vertices, IDs and rotations */
+    __forceinline TrianglePairMv(const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const Vec3vf<M>& v3,
+                                 const vuint<M>& geomIDs, const vuint<M>& primIDs0, const vuint<M>& primIDs1, const vint<M>& rots)
+      : v0(v0), v1(v1), v2(v2), v3(v3), geomIDs(geomIDs), primIDs0(primIDs0), primIDs1(primIDs1), rots(rots) {}
+
+    /* Returns a mask that tells which triangle pairs are valid */
+    __forceinline vbool<M> valid() const { return geomIDs != vuint<M>(-1); }
+
+    /* Returns true if the specified triangle pair is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return geomIDs[i] != -1; }
+
+    /* Returns the number of stored triangle pairs */
+    __forceinline size_t size() const { return bsf(~movemask(valid())); }
+
+    /* Returns true if the specified entry stores two triangles */
+    __forceinline bool paired(const size_t i) const { assert(i<M); return primIDs0[i] != primIDs1[i]; }
+
+    /* Returns the geometry IDs */
+    __forceinline       vuint<M>& geomID()       { return geomIDs; }
+    __forceinline const vuint<M>& geomID() const { return geomIDs; }
+    __forceinline unsigned int geomID(const size_t i) const { assert(i<M); return geomIDs[i]; }
+
+    /* Returns the primitive IDs of the first triangles */
+    __forceinline       vuint<M> primID0()       { return primIDs0; }
+    __forceinline const vuint<M> primID0() const { return primIDs0; }
+    __forceinline unsigned int primID0(const size_t i) const { assert(i<M); return primIDs0[i]; }
+
+    /* Returns the primitive IDs of the second triangles */
+    __forceinline       vuint<M> primID1()       { return primIDs1; }
+    __forceinline const vuint<M> primID1() const { return primIDs1; }
+    __forceinline unsigned int primID1(const size_t i) const { assert(i<M); return primIDs1[i]; }
+
+    /* Returns the rotations of the first and second triangles */
+    __forceinline vint<M> rot0() const { return rots & vint<M>(3); }
+    __forceinline vint<M> rot1() const { return rots >> 2; }
+    __forceinline int rot0(const size_t i) const { assert(i<M); return rots[i] & 3; }
+    __forceinline int rot1(const size_t i) const { assert(i<M); return rots[i] >> 2; }
+
+    /* Calculate the bounds of the triangle pairs */
+    __forceinline BBox3fa bounds() const
+    {
+      Vec3vf<M> lower = min(v0,v1,v2,v3);
+      Vec3vf<M> upper = max(v0,v1,v2,v3);
+      vbool<M> mask = valid();
+      lower.x = select(mask,lower.x,vfloat<M>(pos_inf));
+      lower.y = select(mask,lower.y,vfloat<M>(pos_inf));
+      lower.z = select(mask,lower.z,vfloat<M>(pos_inf));
+      upper.x = select(mask,upper.x,vfloat<M>(neg_inf));
+      upper.y = select(mask,upper.y,vfloat<M>(neg_inf));
+      upper.z = select(mask,upper.z,vfloat<M>(neg_inf));
+      return BBox3fa(Vec3fa(reduce_min(lower.x),reduce_min(lower.y),reduce_min(lower.z)),
+                     Vec3fa(reduce_max(upper.x),reduce_max(upper.y),reduce_max(upper.z)));
+    }
+
+    /* Non temporal store */
+    __forceinline static void store_nt(TrianglePairMv* dst, const TrianglePairMv& src)
+    {
+      vfloat<M>::store_nt(&dst->v0.x,src.v0.x);
+      vfloat<M>::store_nt(&dst->v0.y,src.v0.y);
+      vfloat<M>::store_nt(&dst->v0.z,src.v0.z);
+      vfloat<M>::store_nt(&dst->v1.x,src.v1.x);
+      vfloat<M>::store_nt(&dst->v1.y,src.v1.y);
+      vfloat<M>::store_nt(&dst->v1.z,src.v1.z);
+      vfloat<M>::store_nt(&dst->v2.x,src.v2.x);
+      vfloat<M>::store_nt(&dst->v2.y,src.v2.y);
+      vfloat<M>::store_nt(&dst->v2.z,src.v2.z);
+      vfloat<M>::store_nt(&dst->v3.x,src.v3.x);
+      vfloat<M>::store_nt(&dst->v3.y,src.v3.y);
+      vfloat<M>::store_nt(&dst->v3.z,src.v3.z);
+      vuint<M>::store_nt(&dst->geomIDs,src.geomIDs);
+      vuint<M>::store_nt(&dst->primIDs0,src.primIDs0);
+      vuint<M>::store_nt(&dst->primIDs1,src.primIDs1);
+      vint<M>::store_nt(&dst->rots,src.rots);
+    }
+
+    /* Fill triangle pairs from primref list, the primID of a primref is the one of
+     * the first triangle and partners[geomID] returns the second triangle of its pair */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const std::vector<std::vector<unsigned int>>& partners)
+    {
+      vuint<M> vgeomID = -1, vprimID0 = -1, vprimID1 = -1;
+      vint<M> vrot = zero;
+      Vec3vf<M> v0 = zero, v1 = zero, v2 = zero, v3 = zero;
+
+      for (size_t i=0; i<M && begin<end; i++, begin++)
+      {
+	const PrimRef& prim = prims[begin];
+        const unsigned geomID = prim.geomID();
+        const unsigned primID0 = prim.primID();
+        const unsigned primID1 = partners[geomID][primID0];
+        const TriangleMesh* __restrict__ const mesh = scene->get<TriangleMesh>(geomID);
+        const TriangleMesh::Triangle& tri0 = mesh->triangle(primID0);
+        const TriangleMesh::Triangle& tri1 = mesh->triangle(primID1);
+        unsigned int rot0 = 0, rot1 = 0;
+        if (primID1 != primID0) TriangleMesh::pairTriangles(tri0,tri1,rot0,rot1);
+        const Vec3fa p0 = mesh->vertex(tri0.v[rot0]);
+        const Vec3fa p1 = mesh->vertex(tri0.v[(rot0+1)%3]);
+        const Vec3fa p3 = mesh->vertex(tri0.v[(rot0+2)%3]);
+        const Vec3fa p2 = primID1 != primID0 ? mesh->vertex(tri1.v[rot1]) : p3;
+        vgeomID [i] = geomID;
+        vprimID0[i] = primID0;
+        vprimID1[i] = primID1;
+        vrot    [i] = rot0 | (rot1 << 2);
+        v0.x[i] = p0.x; v0.y[i] = p0.y; v0.z[i] = p0.z;
+        v1.x[i] = p1.x; v1.y[i] = p1.y; v1.z[i] = p1.z;
+        v2.x[i] = p2.x; v2.y[i] = p2.y; v2.z[i] = p2.z;
+        v3.x[i] = p3.x; v3.y[i] = p3.y; v3.z[i] = p3.z;
+      }
+      TrianglePairMv::store_nt(this,TrianglePairMv(v0,v1,v2,v3,vgeomID,vprimID0,vprimID1,vrot));
+    }
+
+  public:
+    Vec3vf<M> v0;      // 1st vertex of the quads
+    Vec3vf<M> v1;      // 2nd vertex of the quads
+    Vec3vf<M> v2;      // 3rd vertex of the quads
+    Vec3vf<M> v3;      // 4th vertex of the quads
+  private:
+    vuint<M> geomIDs;  // geometry ID
+    vuint<M> primIDs0; // primitive ID of the first triangle
+    vuint<M> primIDs1; // primitive ID of the second triangle
+    vint<M> rots;      // rotation of the first triangle in bits 0-1 and of the second one in bits 2-3
+  };
+
+  template<int M>
+  typename TrianglePairMv<M>::Type TrianglePairMv<M>::type;
+
+  typedef TrianglePairMv<4> TrianglePair4v;
+}
@@ -0,0 +1,234 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "trianglepairv.h"
+#include "triangle_intersector_moeller.h"
+
+/*! Intersectors for pairs of triangles of a triangle mesh stored as
+ *  quads. The first triangle of a pair is stored as (q0,q1,q3) and the
+ *  second one as (q2,q3,q1), both rotated relative to the vertex order of
+ *  the original triangle, see TriangleMesh::pairTriangles. On a hit the
+ *  rotation stored in the leaf is undone to report the u/v coordinates
+ *  and primID of the original triangle. */
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! maps the u/v coordinates of a rotated triangle back to the original vertex order */
+    template<int M>
+    struct TrianglePairUVMapper
+    {
+      __forceinline TrianglePairUVMapper(const vint<M>& rot) : rot(rot) {}
+
+      __forceinline void operator() (vfloat<M>& u, vfloat<M>& v, Vec3vf<M>& Ng) const
+      {
+        const vfloat<M> w = vfloat<M>(1.0f)-u-v;
+        const vbool<M> rot1 = rot == vint<M>(1);
+        const vbool<M> rot2 = rot == vint<M>(2);
+        const vfloat<M> u1 = select(rot1,w,select(rot2,v,u));
+        const vfloat<M> v1 = select(rot1,u,select(rot2,w,v));
+        u = u1; v = v1;
+      }
+
+      const vint<M>& rot;
+    };
+
+    /*! Intersects M triangle pairs with 1 ray, both triangles of a pair
+     *  keep the winding order of the original triangles, thus backface
+     *  culling works as for triangle meshes */
+    template<int M, bool filter, bool cull = false>
+    struct TrianglePairMvIntersector1Moeller
+    {
+      typedef TrianglePairMv<M> Primitive;
+      typedef MoellerTrumboreIntersector1<M,true,cull> Precalculations;
+
+      /*! Intersect a ray with the M triangle pairs and updates the hit. */
+      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive& quad)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        vint<M> rot;
+        TrianglePairUVMapper<M> mapUV(rot);
+        MoellerTrumboreHitM<M,TrianglePairUVMapper<M>> hit(mapUV);
+
+        /* intersect first triangle */
+        rot = quad.rot0();
+        if (pre.intersect(ray,quad.v0,quad.v1,quad.v3,mapUV,hit)) {
+          Intersect1EpilogM<M,filter>(ray,context,quad.geomID(),quad.primID0())(hit.valid,hit);
+        }
+
+        /* intersect second triangle */
+        rot = quad.rot1();
+        if (pre.intersect(ray,quad.v2,quad.v3,quad.v1,mapUV,hit)) {
+          Intersect1EpilogM<M,filter>(ray,context,quad.geomID(),quad.primID1())(hit.valid,hit);
+        }
+      }
+
+      /*! Test if the ray is occluded by one of M triangle pairs. */
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, RayQueryContext* context, const Primitive& quad)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        vint<M> rot;
+        TrianglePairUVMapper<M> mapUV(rot);
+        MoellerTrumboreHitM<M,TrianglePairUVMapper<M>> hit(mapUV);
+
+        /* intersect first triangle */
+        rot = quad.rot0();
+        if (pre.intersect(ray,quad.v0,quad.v1,quad.v3,mapUV,hit)) {
+          if (Occluded1EpilogM<M,filter>(ray,context,quad.geomID(),quad.primID0())(hit.valid,hit))
+            return true;
+        }
+
+        /* intersect second triangle */
+        rot = quad.rot1();
+        if (pre.intersect(ray,quad.v2,quad.v3,quad.v1,mapUV,hit)) {
+          if (Occluded1EpilogM<M,filter>(ray,context,quad.geomID(),quad.primID1())(hit.valid,hit))
+            return true;
+        }
+        return false;
+      }
+
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
+      {
+        bool changed = false;
+        for (size_t i=0; i<M; i++)
+        {
+          if (!quad.valid(i)) break;
+          STAT3(point_query.trav_prims,1,1,1);
+          TriangleMesh* mesh = context->scene->get<TriangleMesh>(quad.geomID(i));
+          context->geomID = quad.geomID(i);
+          context->primID = quad.primID0(i);
+          changed |= mesh->pointQuery(query, context);
+
+          if (quad.paired(i)) {
+            context->primID = quad.primID1(i);
+            changed |= mesh->pointQuery(query, context);
+          }
+        }
+        return changed;
+      }
+    };
+
+    /*! Intersects M triangle pairs with K rays */
+    template<int M, int K, bool filter, bool cull = false>
+    struct TrianglePairMvIntersectorKMoeller
+    {
+      typedef TrianglePairMv<M> Primitive;
+      typedef MoellerTrumboreIntersectorK<M,K,cull> Precalculations;
+
+      /*! Intersects K rays with M triangle pairs. */
+      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, RayQueryContext* context, const Primitive& quad)
+      {
+        for (size_t i=0; i<M; i++)
+        {
+          if (!quad.valid(i)) break;
+          STAT3(normal.trav_prims,1,popcnt(valid_i),K);
+          const Vec3vf<K> p0 = broadcast<vfloat<K>>(quad.v0,i);
+          const Vec3vf<K> p1 = broadcast<vfloat<K>>(quad.v1,i);
+          const Vec3vf<K> p2 = broadcast<vfloat<K>>(quad.v2,i);
+          const Vec3vf<K> p3 = broadcast<vfloat<K>>(quad.v3,i);
+          vint<K> rot;
+          TrianglePairUVMapper<K> mapUV(rot);
+          MoellerTrumboreHitK<K,TrianglePairUVMapper<K>> hit(mapUV);
+
+          /* intersect first triangle */
+          rot = vint<K>(quad.rot0(i));
+          vbool<K> valid = pre.intersectK(valid_i,ray,p0,p1,p3,mapUV,hit);
+          if (any(valid)) {
+            IntersectKEpilogM<M,K,filter>(ray,context,quad.geomID(),quad.primID0(),i)(valid,hit);
+          }
+
+          /* intersect second triangle */
+          rot = vint<K>(quad.rot1(i));
+          valid = pre.intersectK(valid_i,ray,p2,p3,p1,mapUV,hit);
+          if (any(valid)) {
+            IntersectKEpilogM<M,K,filter>(ray,context,quad.geomID(),quad.primID1(),i)(valid,hit);
+          }
+        }
+      }
+
+      /*! Test for K rays if they are occluded by any of the M triangle pairs. */
+      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, RayQueryContext* context, const Primitive& quad)
+      {
+        vbool<K> valid0 = valid_i;
+
+        for (size_t i=0; i<M; i++)
+        {
+          if (!quad.valid(i)) break;
+          STAT3(shadow.trav_prims,1,popcnt(valid0),K);
+          const Vec3vf<K> p0 = broadcast<vfloat<K>>(quad.v0,i);
+          const Vec3vf<K> p1 = broadcast<vfloat<K>>(quad.v1,i);
+          const Vec3vf<K> p2 = broadcast<vfloat<K>>(quad.v2,i);
+          const Vec3vf<K> p3 = broadcast<vfloat<K>>(quad.v3,i);
+          vint<K> rot;
+          TrianglePairUVMapper<K> mapUV(rot);
+          MoellerTrumboreHitK<K,TrianglePairUVMapper<K>> hit(mapUV);
+
+          /* intersect first triangle */
+          rot = vint<K>(quad.rot0(i));
+          vbool<K> valid = pre.intersectK(valid0,ray,p0,p1,p3,mapUV,hit);
+          if (any(valid)) {
+            OccludedKEpilogM<M,K,filter>(valid0,ray,context,quad.geomID(),quad.primID0(),i)(valid,hit);
+            if (none(valid0)) break;
+          }
+
+          /* intersect second triangle */
+          rot = vint<K>(quad.rot1(i));
+          valid = pre.intersectK(valid0,ray,p2,p3,p1,mapUV,hit);
+          if (any(valid)) {
+            OccludedKEpilogM<M,K,filter>(valid0,ray,context,quad.geomID(),quad.primID1(),i)(valid,hit);
+            if (none(valid0)) break;
+          }
+        }
+        return !valid0;
+      }
+
+      /*! Intersect a ray with M triangle pairs and updates the hit. */
+      static __forceinline void intersect(Precalculations& pre, RayHitK<K>& ray, size_t k, RayQueryContext* context, const Primitive& quad)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        vint<M> rot;
+        TrianglePairUVMapper<M> mapUV(rot);
+        MoellerTrumboreHitM<M,TrianglePairUVMapper<M>> hit(mapUV);
+
+        /* intersect first triangle */
+        rot = quad.rot0();
+        if (pre.intersect(ray,k,quad.v0,quad.v1,quad.v3,mapUV,hit)) {
+          Intersect1KEpilogM<M,K,filter>(ray,k,context,quad.geomID(),quad.primID0())(hit.valid,hit);
+        }
+
+        /* intersect second triangle */
+        rot = quad.rot1();
+        if (pre.intersect(ray,k,quad.v2,quad.v3,quad.v1,mapUV,hit)) {
+          Intersect1KEpilogM<M,K,filter>(ray,k,context,quad.geomID(),quad.primID1())(hit.valid,hit);
+        }
+      }
+
+      /*! Test if the ray is occluded by one of the M triangle pairs. */
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, RayQueryContext* context, const Primitive& quad)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        vint<M> rot;
+        TrianglePairUVMapper<M> mapUV(rot);
+        MoellerTrumboreHitM<M,TrianglePairUVMapper<M>> hit(mapUV);
+
+        /* intersect first triangle */
+        rot = quad.rot0();
+        if (pre.intersect(ray,k,quad.v0,quad.v1,quad.v3,mapUV,hit)) {
+          if (Occluded1KEpilogM<M,K,filter>(ray,k,context,quad.geomID(),quad.primID0())(hit.valid,hit))
+            return true;
+        }
+
+        /* intersect second triangle */
+        rot = quad.rot1();
+        if (pre.intersect(ray,k,quad.v2,quad.v3,quad.v1,mapUV,hit)) {
+          if (Occluded1KEpilogM<M,K,filter>(ray,k,context,quad.geomID(),quad.primID1())(hit.valid,hit))
+            return true;
+        }
+        return false;
+      }
+    };
+  }
+}
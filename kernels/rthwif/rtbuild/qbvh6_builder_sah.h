@@ -1222,6 +1222,12 @@ namespace embree
           qbvh->numTimeSegments = 1; 
           qbvh->dispatchGlobalsPtr = (uint64_t) dispatchGlobalsPtr;
 
+          /* all data got allocated in the node section, store its size such that the BVH can get copied or serialized */
+          const uint32_t numBlocks = (uint32_t) ((allocator.bytesAllocated()+63)/64);
+          qbvh->nodeDataCur = qbvh->leafDataStart = qbvh->leafDataCur = numBlocks;
+          qbvh->proceduralDataStart = qbvh->proceduralDataCur = numBlocks;
+          qbvh->backPointerDataStart = qbvh->backPointerDataEnd = numBlocks;
+
 #if 0
           BVHStatistics stats = qbvh->computeStatistics();
           stats.print(std::cout);
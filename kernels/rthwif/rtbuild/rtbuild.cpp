@@ -472,15 +472,9 @@ namespace embree
     };
   }
   
-  RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASBuilderGetBuildPropertiesExpImpl(ze_rtas_builder_exp_handle_t hBuilder,
-                                                                                  const ze_rtas_builder_build_op_exp_desc_t* args,
-                                                                                  ze_rtas_builder_exp_properties_t* pProp)
+  ze_result_t zeRTASBuilderGetBuildPropertiesExpBody(const ze_rtas_builder_build_op_exp_desc_t* args,
+                                                    ze_rtas_builder_exp_properties_t* pProp)
   {
-    /* input validation */
-    VALIDATE(hBuilder);
-    VALIDATE(args);
-    VALIDATE(pProp);
-
     const ze_rtas_builder_geometry_info_exp_t** geometries = args->ppGeometries;
     const size_t numGeometries = args->numGeometries;
 
@@ -516,6 +510,18 @@ namespace embree
     pProp->scratchBufferSizeBytes = scratchBytes;
     return ZE_RESULT_SUCCESS;
   }
+
+  RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASBuilderGetBuildPropertiesExpImpl(ze_rtas_builder_exp_handle_t hBuilder,
+                                                                                  const ze_rtas_builder_build_op_exp_desc_t* args,
+                                                                                  ze_rtas_builder_exp_properties_t* pProp)
+  {
+    /* input validation */
+    VALIDATE(hBuilder);
+    VALIDATE(args);
+    VALIDATE(pProp);
+
+    return zeRTASBuilderGetBuildPropertiesExpBody(args,pProp);
+  }
   
   ze_result_t zeRTASBuilderBuildExpBody(const ze_rtas_builder_build_op_exp_desc_t* args,
                                             void *pScratchBuffer, size_t scratchBufferSizeBytes,
@@ -759,4 +765,138 @@ namespace embree
     op->object_in_use.store(false); // this is slighty too early
     return op->errorCode;
   }
+
+  RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASBuilderGetBuildPropertiesHostExpImpl(const ze_rtas_builder_build_op_exp_desc_t* args,
+                                                                                      ze_rtas_builder_exp_properties_t* pProp)
+  {
+    /* input validation */
+    VALIDATE(args);
+    VALIDATE(pProp);
+
+    return zeRTASBuilderGetBuildPropertiesExpBody(args,pProp);
+  }
+
+  RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASBuilderBuildHostExpImpl(const ze_rtas_builder_build_op_exp_desc_t* args,
+                                                                         void *pScratchBuffer, size_t scratchBufferSizeBytes,
+                                                                         void *pRtasBuffer, size_t rtasBufferSizeBytes,
+                                                                         void *pBuildUserPtr, ze_rtas_aabb_exp_t *pBounds, size_t *pRtasBufferSizeBytes)
+  {
+    /* input validation */
+    VALIDATE(args);
+    VALIDATE_PTR(pScratchBuffer);
+    VALIDATE_PTR(pRtasBuffer);
+
+    /* the build runs inside the builder task arena, thus uses all threads of the host */
+    ze_result_t errorCode = ZE_RESULT_SUCCESS;
+    g_arena.execute([&](){ errorCode = zeRTASBuilderBuildExpBody(args,
+                                                                 pScratchBuffer, scratchBufferSizeBytes,
+                                                                 pRtasBuffer, rtasBufferSizeBytes,
+                                                                 pBuildUserPtr, pBounds, pRtasBufferSizeBytes);
+      });
+    return errorCode;
+  }
+
+  RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASBuilderGetStatisticsHostExpImpl(const void* pRtasBuffer, ze_rtas_builder_host_statistics_exp_t* pStatistics)
+  {
+    /* input validation */
+    VALIDATE_PTR(pRtasBuffer);
+    VALIDATE_PTR(pStatistics);
+
+    const QBVH6* qbvh = (const QBVH6*) pRtasBuffer;
+    const BVHStatistics stats = qbvh->computeStatistics();
+
+    pStatistics->rtasBufferSizeBytes  = qbvh->getTotalBytes();
+    pStatistics->internalNodeBytes    = stats.internalNode.bytes();
+    pStatistics->leafBytes            = stats.quadLeaf.bytes() + stats.proceduralLeaf.bytes() + stats.instanceLeaf.bytes();
+    pStatistics->numPrimitives        = stats.quadLeaf.numPrimsUsed + stats.proceduralLeaf.numPrimsUsed + stats.instanceLeaf.numPrimsUsed;
+    pStatistics->numInternalNodes     = stats.internalNode.numNodes;
+    pStatistics->numQuadLeaves        = stats.quadLeaf.numLeaves;
+    pStatistics->numProceduralLeaves  = stats.proceduralLeaf.numLeaves;
+    pStatistics->numInstanceLeaves    = stats.instanceLeaf.numLeaves;
+    pStatistics->internalNodeFillRate = stats.internalNode.fillRate();
+    pStatistics->sah = stats.internalNode.sah() + stats.quadLeaf.sah() + stats.proceduralLeaf.sah() + stats.instanceLeaf.sah();
+    return ZE_RESULT_SUCCESS;
+  }
+
+  /* header of a serialized acceleration structure, followed by the acceleration structure data */
+  struct SerializedRTASHeader
+  {
+    enum { MAGICK = 0x36485642 }; // "BVH6"
+    enum { VERSION = 1 };
+
+    uint32_t magick;
+    uint32_t version;
+    uint32_t rtasFormat;
+    uint32_t reserved0;
+    uint64_t rtasBytes;
+    uint64_t reserved1[5];
+  };
+
+  static_assert(sizeof(SerializedRTASHeader) == 64, "SerializedRTASHeader must be 64 bytes large");
+  static_assert(offsetof(QBVH6,dispatchGlobalsPtr) == ZE_RTAS_DISPATCH_GLOBALS_PTR_OFFSET, "wrong offset of dispatch globals pointer");
+
+  RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASSerializeHostExpImpl(const void* pRtasBuffer, void* pBlob, size_t blobSizeBytes, size_t* pBlobSizeBytes)
+  {
+    /* input validation */
+    VALIDATE_PTR(pRtasBuffer);
+    VALIDATE_PTR(pBlobSizeBytes);
+
+    const QBVH6* qbvh = (const QBVH6*) pRtasBuffer;
+    const size_t rtasBytes = qbvh->getTotalBytes();
+    *pBlobSizeBytes = sizeof(SerializedRTASHeader) + rtasBytes;
+    if (pBlob == nullptr)
+      return ZE_RESULT_SUCCESS;
+
+    if (blobSizeBytes < *pBlobSizeBytes)
+      return ZE_RESULT_ERROR_INVALID_SIZE;
+
+    /* instance leaves store absolute addresses of other acceleration structures */
+    if (qbvh->computeStatistics().instanceLeaf.numLeaves)
+      return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+
+    SerializedRTASHeader* header = (SerializedRTASHeader*) pBlob;
+    memset(header,0,sizeof(SerializedRTASHeader));
+    header->magick = SerializedRTASHeader::MAGICK;
+    header->version = SerializedRTASHeader::VERSION;
+    header->rtasFormat = (uint32_t) qbvh->rtas_format;
+    header->rtasBytes = rtasBytes;
+
+    /* node and leaf references are relative, only the dispatch globals pointer has to get cleared */
+    QBVH6* qbvh_out = (QBVH6*) ((char*)pBlob + sizeof(SerializedRTASHeader));
+    memcpy((void*)qbvh_out,pRtasBuffer,rtasBytes);
+    qbvh_out->dispatchGlobalsPtr = 0;
+    return ZE_RESULT_SUCCESS;
+  }
+
+  RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASDeserializeHostExpImpl(const void* pBlob, size_t blobSizeBytes,
+                                                                        void* pRtasBuffer, size_t rtasBufferSizeBytes,
+                                                                        ze_rtas_format_exp_t* pRtasFormat, size_t* pRtasBufferSizeBytes)
+  {
+    /* input validation */
+    VALIDATE_PTR(pBlob);
+    VALIDATE_PTR(pRtasBufferSizeBytes);
+
+    if (blobSizeBytes < sizeof(SerializedRTASHeader))
+      return ZE_RESULT_ERROR_INVALID_SIZE;
+
+    const SerializedRTASHeader* header = (const SerializedRTASHeader*) pBlob;
+    if (header->magick != SerializedRTASHeader::MAGICK || header->version != SerializedRTASHeader::VERSION)
+      return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+
+    VALIDATE((ze_rtas_format_exp_t) header->rtasFormat);
+
+    if (blobSizeBytes < sizeof(SerializedRTASHeader) + header->rtasBytes)
+      return ZE_RESULT_ERROR_INVALID_SIZE;
+
+    if (pRtasFormat) *pRtasFormat = (ze_rtas_format_exp_t) header->rtasFormat;
+    *pRtasBufferSizeBytes = header->rtasBytes;
+    if (pRtasBuffer == nullptr)
+      return ZE_RESULT_SUCCESS;
+
+    if (rtasBufferSizeBytes < header->rtasBytes)
+      return ZE_RESULT_ERROR_INVALID_SIZE;
+
+    memcpy(pRtasBuffer,(const char*)pBlob + sizeof(SerializedRTASHeader),header->rtasBytes);
+    return ZE_RESULT_SUCCESS;
+  }
 }
@@ -64,3 +64,61 @@ RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASParallelOperationGetPropertiesExp
 
 RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASParallelOperationJoinExpImpl( ze_rtas_parallel_operation_exp_handle_t hParallelOperation);
 
+
+/*
+  Host builder entry points that do not require a Level Zero driver
+  or device. They build the same QBVH6 acceleration structure as
+  zeRTASBuilderBuildExpImpl on the CPU using all threads of the
+  builder task arena, such that acceleration structures can get baked
+  offline (e.g. on build machines without GPU) and get shipped with
+  the assets.
+*/
+
+typedef struct _ze_rtas_builder_host_statistics_exp_t
+{
+  size_t rtasBufferSizeBytes;   // total size of the acceleration structure in bytes
+  size_t internalNodeBytes;     // bytes used by internal nodes
+  size_t leafBytes;             // bytes used by leaves
+  size_t numPrimitives;         // number of primitives referenced by the leaves
+  size_t numInternalNodes;      // number of internal nodes
+  size_t numQuadLeaves;         // number of triangle and quad leaves
+  size_t numProceduralLeaves;   // number of procedural leaves
+  size_t numInstanceLeaves;     // number of instance leaves
+  double internalNodeFillRate;  // ratio of used to available children of internal nodes
+  double sah;                   // SAH cost of the acceleration structure
+} ze_rtas_builder_host_statistics_exp_t;
+
+RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASBuilderGetBuildPropertiesHostExpImpl(const ze_rtas_builder_build_op_exp_desc_t* args,
+                                                                                    ze_rtas_builder_exp_properties_t* pProp);
+
+RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASBuilderBuildHostExpImpl(const ze_rtas_builder_build_op_exp_desc_t* args,
+                                                                       void *pScratchBuffer, size_t scratchBufferSizeBytes,
+                                                                       void *pRtasBuffer, size_t rtasBufferSizeBytes,
+                                                                       void *pBuildUserPtr, ze_rtas_aabb_exp_t *pBounds, size_t *pRtasBufferSizeBytes);
+
+RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASBuilderGetStatisticsHostExpImpl(const void* pRtasBuffer, ze_rtas_builder_host_statistics_exp_t* pStatistics);
+
+/* Byte offset of the 64 bit dispatch globals pointer inside an
+ * acceleration structure. */
+#define ZE_RTAS_DISPATCH_GLOBALS_PTR_OFFSET 120
+
+/* Serializes an acceleration structure into a relocatable blob. When
+ * pBlob is NULL only the required blob size is returned. Acceleration
+ * structures that contain instances cannot get serialized, as they
+ * reference other acceleration structures by address. The dispatch
+ * globals pointer is device specific and is stored as 0. */
+RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASSerializeHostExpImpl(const void* pRtasBuffer, void* pBlob, size_t blobSizeBytes, size_t* pBlobSizeBytes);
+
+/* Restores an acceleration structure from a serialized blob. When
+ * pRtasBuffer is NULL only the acceleration structure format and the
+ * required buffer size are returned, the format should get checked
+ * for compatibility with the device before using the acceleration
+ * structure. Blobs with wrong magic or version are rejected with
+ * ZE_RESULT_ERROR_INVALID_ARGUMENT, truncated blobs and too small
+ * buffers with ZE_RESULT_ERROR_INVALID_SIZE. The dispatch globals
+ * pointer of the restored acceleration structure is 0, the caller has
+ * to patch it at ZE_RTAS_DISPATCH_GLOBALS_PTR_OFFSET before tracing
+ * rays, unless the device uses implicit dispatch globals. */
+RTHWIF_API_EXPORT ze_result_t ZE_APICALL zeRTASDeserializeHostExpImpl(const void* pBlob, size_t blobSizeBytes,
+                                                                      void* pRtasBuffer, size_t rtasBufferSizeBytes,
+                                                                      ze_rtas_format_exp_t* pRtasFormat, size_t* pRtasBufferSizeBytes);
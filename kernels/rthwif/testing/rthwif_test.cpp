@@ -34,6 +34,10 @@
 
 #include <level_zero/ze_wrapper.h>
 
+#if !defined(EMBREE_SYCL_L0_RTAS_BUILDER)
+#include "../rtbuild/rtbuild.h"
+#endif
+
 #include <vector>
 #include <map>
 #include <iostream>
@@ -138,6 +142,7 @@ enum class TestType
   BUILD_TEST_PROCEDURALS,            // test BVH builder with procedurals
   BUILD_TEST_INSTANCES,              // test BVH builder with instances
   BUILD_TEST_MIXED,                  // test BVH builder with mixed scene (triangles, procedurals, and instances)
+  SERIALIZE_TEST_TRIANGLES,          // test serialization and deserialization of BVHs with triangles
   BENCHMARK_TRIANGLES,               // benchmark BVH builder with triangles
   BENCHMARK_PROCEDURALS,             // benchmark BVH builder with procedurals
 };
@@ -1901,8 +1906,76 @@ uint32_t executeTest(sycl::device& device, sycl::queue& queue, sycl::context& co
   return numErrors;
 }
 
+#if !defined(EMBREE_SYCL_L0_RTAS_BUILDER)
+
+/* serializes and deserializes an acceleration structure and returns the restored copy */
+void* serializeAccel(void* accel, sycl::device& device, sycl::context& context, uint32_t& numErrors)
+{
+  size_t blobBytes = 0;
+  if (zeRTASSerializeHostExpImpl(accel,nullptr,0,&blobBytes) != ZE_RESULT_SUCCESS)
+    throw std::runtime_error("serialized size query failed");
+
+  std::vector<char> blob(blobBytes);
+  if (zeRTASSerializeHostExpImpl(accel,blob.data(),blob.size(),&blobBytes) != ZE_RESULT_SUCCESS)
+    throw std::runtime_error("serialization failed");
+
+  size_t bytes = 0;
+  if (zeRTASSerializeHostExpImpl(accel,blob.data(),blob.size()-1,&bytes) != ZE_RESULT_ERROR_INVALID_SIZE) {
+    std::cout << "serialization into too small blob not rejected" << std::endl;
+    numErrors++;
+  }
+
+  /* truncated blobs and blobs with wrong magic have to get rejected */
+  if (zeRTASDeserializeHostExpImpl(blob.data(),blob.size()-1,nullptr,0,nullptr,&bytes) != ZE_RESULT_ERROR_INVALID_SIZE) {
+    std::cout << "truncated blob not rejected" << std::endl;
+    numErrors++;
+  }
+  if (zeRTASDeserializeHostExpImpl(blob.data(),16,nullptr,0,nullptr,&bytes) != ZE_RESULT_ERROR_INVALID_SIZE) {
+    std::cout << "blob smaller than header not rejected" << std::endl;
+    numErrors++;
+  }
+
+  std::vector<char> wrongMagic = blob;
+  wrongMagic[0] ^= 0xFF;
+  if (zeRTASDeserializeHostExpImpl(wrongMagic.data(),wrongMagic.size(),nullptr,0,nullptr,&bytes) != ZE_RESULT_ERROR_INVALID_ARGUMENT) {
+    std::cout << "blob with wrong magic not rejected" << std::endl;
+    numErrors++;
+  }
+
+  ze_rtas_format_exp_t rtasFormat;
+  size_t rtasBytes = 0;
+  if (zeRTASDeserializeHostExpImpl(blob.data(),blob.size(),nullptr,0,&rtasFormat,&rtasBytes) != ZE_RESULT_SUCCESS)
+    throw std::runtime_error("deserialized size query failed");
+
+  void* restored = alloc_accel_buffer(rtasBytes,device,context);
+  if (zeRTASDeserializeHostExpImpl(blob.data(),blob.size(),restored,rtasBytes-1,nullptr,&bytes) != ZE_RESULT_ERROR_INVALID_SIZE) {
+    std::cout << "deserialization into too small buffer not rejected" << std::endl;
+    numErrors++;
+  }
+  if (zeRTASDeserializeHostExpImpl(blob.data(),blob.size(),restored,rtasBytes,nullptr,&bytes) != ZE_RESULT_SUCCESS)
+    throw std::runtime_error("deserialization failed");
+
+  /* the dispatch globals pointer is not serialized and has to get patched */
+  uint64_t* dispatchGlobals = (uint64_t*) ((char*)restored + ZE_RTAS_DISPATCH_GLOBALS_PTR_OFFSET);
+  if (*dispatchGlobals != 0) {
+    std::cout << "dispatch globals pointer not cleared" << std::endl;
+    numErrors++;
+  }
+  *dispatchGlobals = *(uint64_t*) ((char*)accel + ZE_RTAS_DISPATCH_GLOBALS_PTR_OFFSET);
+
+  if (memcmp(restored,accel,rtasBytes) != 0) {
+    std::cout << "deserialized acceleration structure differs" << std::endl;
+    numErrors++;
+  }
+  return restored;
+}
+
+#endif
+
 uint32_t executeBuildTest(sycl::device& device, sycl::queue& queue, sycl::context& context, TestType test, BuildMode buildMode, uint32_t numPrimitives, int testID)
 {
+  uint32_t numErrors = 0;
+
   const uint32_t width = 2*(uint32_t)ceilf(sqrtf(numPrimitives));
   std::shared_ptr<TriangleMesh> plane = createTrianglePlane(sycl::float3(0,0,0), sycl::float3(width,0,0), sycl::float3(0,width,0), width, width);
   if (test == TestType::BUILD_TEST_PROCEDURALS) plane->procedural = true;
@@ -1943,6 +2016,15 @@ uint32_t executeBuildTest(sycl::device& device, sycl::queue& queue, sycl::contex
   intel_raytracing_acceleration_structure_t accel = (intel_raytracing_acceleration_structure_t) scene->getAccel();
   size_t scene_ptr = (size_t) scene.get();
 
+  /* trace the deserialized copy of the acceleration structure */
+  void* restored = nullptr;
+#if !defined(EMBREE_SYCL_L0_RTAS_BUILDER)
+  if (test == TestType::SERIALIZE_TEST_TRIANGLES) {
+    restored = serializeAccel(scene->getAccel(),device,context,numErrors);
+    accel = (intel_raytracing_acceleration_structure_t) restored;
+  }
+#endif
+
   if (numPrimitives)
   {
 #if defined(ZE_RAYTRACING_RT_SIMULATION)
@@ -1962,9 +2044,11 @@ uint32_t executeBuildTest(sycl::device& device, sycl::queue& queue, sycl::contex
   }
     
   /* verify result */
-  uint32_t numErrors = 0;
   for (size_t tid=0; tid<numPrimitives; tid++)
     compareTestOutput(tid,numErrors,out_test[tid],out_expected[tid]);
+
+  if (restored)
+    free_accel_buffer(restored,context);
   
   sycl::free(in,context);
   sycl::free(out_test,context);
@@ -2110,6 +2194,15 @@ int main(int argc, char* argv[]) try
     else if (strcmp(argv[i], "--build_test_mixed") == 0) {
       test = TestType::BUILD_TEST_MIXED;
     }
+    else if (strcmp(argv[i], "--serialize_test_triangles") == 0) {
+#if defined(EMBREE_SYCL_L0_RTAS_BUILDER)
+      std::cout << "ERROR: serialization test requires the internal RTAS builder" << std::endl;
+      return 1;
+#else
+      test = TestType::SERIALIZE_TEST_TRIANGLES;
+      rtas_build_mode = ZeWrapper::RTAS_BUILD_MODE::INTERNAL;
+#endif
+    }
     else if (strcmp(argv[i], "--benchmark_triangles") == 0) {
       test = TestType::BENCHMARK_TRIANGLES;
     }
@@ -300,6 +300,16 @@ namespace embree
     ocurve = BezierCurveT<Vertex>(v0,v1,v2,v3);
   }
 
+  template<typename Vertex>
+    __forceinline void convert(const BezierCurveT<Vertex>& icurve, CatmullRomCurveT<Vertex>& ocurve)
+  {
+    const Vertex v0 = icurve.v3+(icurve.v0-icurve.v1)*6.0f;
+    const Vertex v1 = icurve.v0;
+    const Vertex v2 = icurve.v3;
+    const Vertex v3 = icurve.v0+(icurve.v3-icurve.v2)*6.0f;
+    ocurve = CatmullRomCurveT<Vertex>(v0,v1,v2,v3);
+  }
+
   template<typename CurveGeometry>
   __forceinline CatmullRomCurveT<Vec3ff> enlargeRadiusToMinWidth(const RayQueryContext* context, const CurveGeometry* geom, const Vec3fa& ray_org, const CatmullRomCurveT<Vec3ff>& curve)
   {
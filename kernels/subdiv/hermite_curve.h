@@ -34,6 +34,12 @@ namespace embree
   {
     ocurve = BezierCurveT<Vertex>(icurve.v0,icurve.v1,icurve.v2,icurve.v3);
   }
+
+  template<typename Vertex>
+    __forceinline void convert(const BezierCurveT<Vertex>& icurve, HermiteCurveT<Vertex>& ocurve)
+  {
+    ocurve = HermiteCurveT<Vertex>(icurve);
+  }
   
   template<typename CurveGeometry>
   __forceinline HermiteCurveT<Vec3ff> enlargeRadiusToMinWidth(const RayQueryContext* context, const CurveGeometry* geom, const Vec3fa& ray_org, const HermiteCurveT<Vec3ff>& curve) {
@@ -45,6 +45,67 @@ namespace embree
             FeatureAdaptiveEvalSimd<vbool,vint,vfloat,Vertex,Vertex_t>(edge,vertices,stride,valid2,u,v,P,dPdu,dPdv,ddPdudu,ddPdvdv,ddPdudv,dstride,N);
           }
         }
+
+        /* evaluates a batch of numQueries (u,v) pairs on the same patch, the
+         * patch is looked up only once and reused for all SIMD packets */
+        PatchEvalSimd (SharedLazyTessellationCache::CacheEntry& entry, size_t commitCounter, 
+                       const HalfEdge* edge, const char* vertices, size_t stride, const float* u, const float* v, const size_t numQueries,
+                       float* P_i, float* dPdu_i, float* dPdv_i, float* ddPdudu_i, float* ddPdvdv_i, float* ddPdudv_i, const size_t dstride, const size_t N)
+        : dstride(dstride), N(N)
+        {
+          assert(numQueries <= MAX_BATCH_SIZE);
+          
+          /* conservative time for the very first allocation */
+          auto time = SharedLazyTessellationCache::sharedLazyTessellationCache.getTime(commitCounter);
+
+          Ref patch = SharedLazyTessellationCache::lookup(entry,commitCounter,[&] () {
+              auto alloc = [](size_t bytes) { return SharedLazyTessellationCache::malloc(bytes); };
+              return Patch::create(alloc,edge,vertices,stride);
+            }, true);
+
+          auto curTime = SharedLazyTessellationCache::sharedLazyTessellationCache.getTime(commitCounter);
+          const bool allAllocationsValid = SharedLazyTessellationCache::validTime(time,curTime);
+          
+          patch = allAllocationsValid ? patch : nullptr;
+
+          /* use cached data structure for calculations */
+          vbool valid1[MAX_BATCH_SIZE/vfloat::size];
+          for (size_t i=0, k=0; i<numQueries; i+=vfloat::size, k++)
+          {
+            const vbool valid0 = vint(int(i))+vint(step) < vint(int(numQueries));
+            setOutput(i,P_i,dPdu_i,dPdv_i,ddPdudu_i,ddPdvdv_i,ddPdudv_i);
+            valid1[k] = patch ? eval(valid0,patch,vfloat::loadu(&u[i]),vfloat::loadu(&v[i]),1.0f,0) : vbool(false);
+          }
+          SharedLazyTessellationCache::unlock();
+
+          /* evaluate directly where the cached patch was not usable */
+          for (size_t i=0, k=0; i<numQueries; i+=vfloat::size, k++)
+          {
+            const vbool valid0 = vint(int(i))+vint(step) < vint(int(numQueries));
+            const vbool valid2 = valid0 & !valid1[k];
+            if (none(valid2)) continue;
+            setOutput(i,P_i,dPdu_i,dPdv_i,ddPdudu_i,ddPdvdv_i,ddPdudv_i);
+            FeatureAdaptiveEvalSimd<vbool,vint,vfloat,Vertex,Vertex_t>(edge,vertices,stride,valid2,vfloat::loadu(&u[i]),vfloat::loadu(&v[i]),
+                                                                       P,dPdu,dPdv,ddPdudu,ddPdvdv,ddPdudv,dstride,N);
+          }
+        }
+
+        /* maximum number of queries of a batch */
+        static const size_t MAX_BATCH_SIZE = 64;
+
+      private:
+
+        __forceinline void setOutput(size_t i, float* P_i, float* dPdu_i, float* dPdv_i, float* ddPdudu_i, float* ddPdvdv_i, float* ddPdudv_i)
+        {
+          P       = P_i       ? P_i+i       : nullptr;
+          dPdu    = dPdu_i    ? dPdu_i+i    : nullptr;
+          dPdv    = dPdv_i    ? dPdv_i+i    : nullptr;
+          ddPdudu = ddPdudu_i ? ddPdudu_i+i : nullptr;
+          ddPdvdv = ddPdvdv_i ? ddPdvdv_i+i : nullptr;
+          ddPdudv = ddPdudv_i ? ddPdudv_i+i : nullptr;
+        }
+
+      public:
         
         vbool eval_quad(const vbool& valid, const typename Patch::SubdividedQuadPatch* This, const vfloat& u, const vfloat& v, const float dscale, const size_t depth)
         {
@@ -114,12 +175,12 @@ namespace embree
         }
 
       private:
-        float* const P;
-        float* const dPdu;
-        float* const dPdv;
-        float* const ddPdudu;
-        float* const ddPdvdv;
-        float* const ddPdudv;
+        float* P;
+        float* dPdu;
+        float* dPdv;
+        float* ddPdudu;
+        float* ddPdvdv;
+        float* ddPdudv;
         const size_t dstride;
         const size_t N;
       };
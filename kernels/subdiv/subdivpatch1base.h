@@ -151,6 +151,6 @@ namespace embree
                            const unsigned x0, const unsigned x1,
                            const unsigned y0, const unsigned y1,
                            const unsigned swidth, const unsigned sheight,
-                           const SubdivMesh* const geom);
+                           const SubdivMesh* const geom, const bool displace = true);
   }
 }
@@ -216,7 +216,7 @@ namespace embree
                            const unsigned x0, const unsigned x1,
                            const unsigned y0, const unsigned y1,
                            const unsigned swidth, const unsigned sheight,
-                           const SubdivMesh* const geom)
+                           const SubdivMesh* const geom, const bool displace)
     {
       BBox3fa b(empty);
       const unsigned dwidth  = x1-x0+1;
@@ -228,7 +228,7 @@ namespace embree
 
       if (unlikely(patch.type == SubdivPatch1Base::EVAL_PATCH))
       {
-        const bool displ = geom->displFunc;
+        const bool displ = displace && geom->displFunc;
         dynamic_large_stack_array(float,grid_x,M,64*64*sizeof(float));
         dynamic_large_stack_array(float,grid_y,M,64*64*sizeof(float));
         dynamic_large_stack_array(float,grid_z,M,64*64*sizeof(float));
@@ -258,7 +258,7 @@ namespace embree
         }
 
         /* call displacement shader */
-        if (unlikely(geom->displFunc))
+        if (unlikely(displ))
         {
           RTCDisplacementFunctionNArguments args;
           args.geometryUserPtr = geom->userPtr;
@@ -358,7 +358,7 @@ namespace embree
           Vec3vfx vtx = patchEval(patch,u,v);
         
           /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
+          if (unlikely(displace && geom->displFunc != nullptr))
           {
             const Vec3vfx normal = normalize_safe(patchNormal(patch,u,v));
             RTCDisplacementFunctionNArguments args;
@@ -25,6 +25,25 @@ namespace embree
     //SharedLazyTessellationCache::sharedLazyTessellationCache.addCurrentIndex(SharedLazyTessellationCache::NUM_CACHE_SEGMENTS);
     SharedLazyTessellationCache::sharedLazyTessellationCache.reset();
   }
+
+  void setTessellationCacheLimits(size_t min_size, size_t max_size)
+  {
+    max_size = min(max_size,SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE);
+    min_size = min(min_size,max_size);
+    SharedLazyTessellationCache::sharedLazyTessellationCache.setLimits(min_size,max_size);
+  }
+
+  void adaptTessellationCache() {
+    SharedLazyTessellationCache::sharedLazyTessellationCache.adapt();
+  }
+
+  TessellationCacheStats getTessellationCacheStats() {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.getStats();
+  }
+
+  void clearTessellationCacheStats() {
+    SharedLazyTessellationCache::sharedLazyTessellationCache.clearStats();
+  }
   
   SharedLazyTessellationCache::SharedLazyTessellationCache()
   {
@@ -42,6 +61,19 @@ namespace embree
 #endif
     threadWorkState     = new ThreadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
 
+    bufferEpoch          = 0;
+    minSize              = 0;
+    maxSize              = 0;
+    cycleSegments        = 0;
+    cycleAccesses        = 0;
+    cycleEvictions       = 0;
+    adaptCommits         = 0;
+    adaptAllocatedBlocks = 0;
+    shrinkWindow         = MIN_SHRINK_WINDOW;
+    flushedBlocks        = 0;
+    numFlushes           = 0;
+    numResizes           = 0;
+
     //reset_state.reset();
     //linkedlist_mtx.reset();
   }
@@ -56,6 +88,10 @@ namespace embree
     }
 
     delete[] threadWorkState;
+
+    for (auto& buffer : retiredBuffers)
+      os_free(buffer.data,buffer.size,buffer.hugepages);
+    if (data) os_free(data,size,hugepages);
   }
 
   void SharedLazyTessellationCache::getNextRenderThreadWorkState() 
@@ -83,24 +119,54 @@ namespace embree
      }
    }
 
+  void SharedLazyTessellationCache::blockThreads()
+  {
+    /* lock the linked list of thread states */
+    linkedlist_mtx.lock();
+
+    /* block all threads */
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
+        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+  }
+
+  void SharedLazyTessellationCache::unblockThreads()
+  {
+    /* release all blocked threads */
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
+
+    /* unlock the linked list of thread states */
+    linkedlist_mtx.unlock();
+  }
+
+  size_t SharedLazyTessellationCache::segmentBlocks() const
+  {
+#if FORCE_SIMPLE_FLUSH == 1
+    return maxBlocks;
+#else
+    return maxBlocks/NUM_CACHE_SEGMENTS;
+#endif
+  }
+
+  size_t SharedLazyTessellationCache::allocatedBlocks() const
+  {
+    const size_t segmentBegin = switch_block_threshold - segmentBlocks();
+    return flushedBlocks + min(next_block.load(),switch_block_threshold.load()) - segmentBegin;
+  }
+
   void SharedLazyTessellationCache::allocNextSegment() 
   {
     if (reset_state.try_lock())
     {
       if (next_block >= switch_block_threshold)
       {
-        /* lock the linked list of thread states */
-        
-        linkedlist_mtx.lock();
-        
-        /* block all threads */
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-            waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+        blockThreads();
         
         /* switch to the next segment */
         addCurrentIndex();
-        CACHE_STATS(PRINT("RESET TESS CACHE"));
+        numFlushes++;
+        flushedBlocks += segmentBlocks();
         
 #if FORCE_SIMPLE_FLUSH == 1
         next_block = 0;
@@ -111,19 +177,26 @@ namespace embree
         switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
         assert( switch_block_threshold <= maxBlocks );
 #endif
+
+        /* grow the cache if too many entries got reclaimed while still in use during the last full ring cycle */
+        if (++cycleSegments >= NUM_CACHE_SEGMENTS)
+        {
+          const TessellationCacheStats stats = sumThreadStats();
+          const size_t accesses  = stats.hits + stats.misses - cycleAccesses;
+          const size_t evictions = stats.evictions - cycleEvictions;
+          if (size < maxSize && evictions > accesses/8) {
+            resizeBuffer(min(2*size,maxSize));
+            numResizes++;
+            /* back off shrinking to not oscillate between two sizes */
+            shrinkWindow = min(2*shrinkWindow,MAX_SHRINK_WINDOW);
+          }
+          cycleSegments  = 0;
+          cycleAccesses  = stats.hits + stats.misses;
+          cycleEvictions = stats.evictions;
+        }
+        freeRetiredBuffers();
         
-        CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
-        
-        /* release all blocked threads */
-        
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-        
-        /* unlock the linked list of thread states */
-        
-        linkedlist_mtx.unlock();
-	
-        
+        unblockThreads();
       }
       reset_state.unlock();
     }
@@ -131,19 +204,12 @@ namespace embree
       reset_state.wait_until_unlocked();	   
   }
   
-  
   void SharedLazyTessellationCache::reset()
   {
     /* lock the reset_state */
     reset_state.lock();
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
-
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+    blockThreads();
 
     /* reset to the first segment */
     next_block = 0;
@@ -156,32 +222,20 @@ namespace embree
     /* reset local time */
     localTime = NUM_CACHE_SEGMENTS;
 
-    /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    freeRetiredBuffers();
+    unblockThreads();
 
     /* unlock the reset_state */
     reset_state.unlock();
   }
 
-  void SharedLazyTessellationCache::realloc(const size_t new_size)
+  void SharedLazyTessellationCache::resizeBuffer(const size_t new_size)
   {
-    /* lock the reset_state */
-    reset_state.lock();
-
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
-
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+    /* threads that currently construct an entry may still write to the old buffer */
+    if (data) retiredBuffers.push_back(RetiredBuffer { data, size, hugepages, bufferEpoch.load() });
+    bufferEpoch++;
 
     /* reallocate data */
-    if (data) os_free(data,size,hugepages);
     size      = new_size;
     data      = nullptr;
     if (size) data = (float*)os_malloc(size,hugepages);
@@ -201,48 +255,123 @@ namespace embree
     assert( switch_block_threshold <= maxBlocks );
 #endif
 
-    /* release all blocked threads */
+    /* restart adaptation */
+    cycleSegments = 0;
+    adaptCommits = 0;
+    adaptAllocatedBlocks = allocatedBlocks();
+  }
+
+  void SharedLazyTessellationCache::freeRetiredBuffers()
+  {
+    if (retiredBuffers.empty())
+      return;
+    
+    /* oldest buffer epoch any in-flight construction may reference */
+    size_t minEpoch = std::numeric_limits<size_t>::max();
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
+      if (t->buildEpoch) minEpoch = min(minEpoch,t->buildEpoch-1);
 
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    size_t j=0;
+    for (size_t i=0; i<retiredBuffers.size(); i++)
+    {
+      if (retiredBuffers[i].epoch < minEpoch) os_free(retiredBuffers[i].data,retiredBuffers[i].size,retiredBuffers[i].hugepages);
+      else retiredBuffers[j++] = retiredBuffers[i];
+    }
+    retiredBuffers.resize(j);
+  }
+
+  void SharedLazyTessellationCache::realloc(const size_t new_size)
+  {
+    /* lock the reset_state */
+    reset_state.lock();
+
+    blockThreads();
+    resizeBuffer(new_size);
+    freeRetiredBuffers();
+    unblockThreads();
 
     /* unlock the reset_state */
     reset_state.unlock();
   }
 
+  void SharedLazyTessellationCache::setLimits(const size_t min_size, const size_t max_size)
+  {
+    reset_state.lock();
+    minSize = min_size;
+    maxSize = max_size;
+    reset_state.unlock();
+  }
+
+  void SharedLazyTessellationCache::adapt()
+  {
+    if (minSize >= maxSize)
+      return;
 
-  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
-  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
-  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /* lock the reset_state */
+    reset_state.lock();
 
-  std::atomic<size_t> SharedTessellationCacheStats::cache_accesses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_hits(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_misses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_flushes(0);  
-  SpinLock   SharedTessellationCacheStats::mtx;  
-  size_t SharedTessellationCacheStats::cache_num_patches(0);
+    if (++adaptCommits >= shrinkWindow)
+    {
+      blockThreads();
+
+      /* blocks allocated since the last adaptation */
+      const size_t allocated = allocatedBlocks() - adaptAllocatedBlocks;
+
+      /* shrink if the last commits allocated less than a single segment */
+      if (size/2 >= max(minSize,MIN_SHRINK_SIZE) && allocated < segmentBlocks()) {
+        resizeBuffer(size/2);
+        numResizes++;
+      }
 
-  void SharedTessellationCacheStats::printStats()
+      adaptCommits = 0;
+      adaptAllocatedBlocks = allocatedBlocks();
+      freeRetiredBuffers();
+      unblockThreads();
+    }
+
+    /* unlock the reset_state */
+    reset_state.unlock();
+  }
+
+  TessellationCacheStats SharedLazyTessellationCache::sumThreadStats()
   {
-    PRINT(cache_accesses);
-    PRINT(cache_misses);
-    PRINT(cache_hits);
-    PRINT(cache_flushes);
-    PRINT(100.0f * cache_hits / cache_accesses);
-    assert(cache_hits + cache_misses == cache_accesses);
-    PRINT(cache_num_patches);
+    TessellationCacheStats stats;
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next) {
+      stats.hits      += t->hits.load(std::memory_order_relaxed);
+      stats.misses    += t->misses.load(std::memory_order_relaxed);
+      stats.evictions += t->evictions.load(std::memory_order_relaxed);
+    }
+    stats.flushes = numFlushes;
+    stats.resizes = numResizes;
+    return stats;
   }
 
-  void SharedTessellationCacheStats::clearStats()
+  TessellationCacheStats SharedLazyTessellationCache::getStats()
   {
-    SharedTessellationCacheStats::cache_accesses  = 0;
-    SharedTessellationCacheStats::cache_hits      = 0;
-    SharedTessellationCacheStats::cache_misses    = 0;
-    SharedTessellationCacheStats::cache_flushes   = 0;
+    linkedlist_mtx.lock();
+    TessellationCacheStats stats = sumThreadStats();
+    linkedlist_mtx.unlock();
+
+    stats.hits      -= statsBase.hits;
+    stats.misses    -= statsBase.misses;
+    stats.evictions -= statsBase.evictions;
+    stats.flushes   -= statsBase.flushes;
+    stats.resizes   -= statsBase.resizes;
+    return stats;
   }
 
+  void SharedLazyTessellationCache::clearStats()
+  {
+    /* per thread counters are owned by their threads, thus we only remember the current values */
+    linkedlist_mtx.lock();
+    statsBase = sumThreadStats();
+    linkedlist_mtx.unlock();
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
   struct cache_regression_test : public RegressionTest
   {
     BarrierSys barrier;
@@ -323,6 +452,12 @@ namespace embree
 extern "C" void printTessCacheStats()
 {
   PRINT("SHARED TESSELLATION CACHE");
-  embree::SharedTessellationCacheStats::printStats();
-  embree::SharedTessellationCacheStats::clearStats();
+  embree::TessellationCacheStats stats = embree::getTessellationCacheStats();
+  PRINT(stats.hits);
+  PRINT(stats.misses);
+  PRINT(stats.evictions);
+  PRINT(stats.flushes);
+  PRINT(stats.resizes);
+  PRINT(100.0f * stats.hits / embree::max(stats.hits+stats.misses,size_t(1)));
+  embree::clearTessellationCacheStats();
 }
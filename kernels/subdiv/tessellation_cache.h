@@ -10,32 +10,27 @@
 
 #define THREAD_BLOCK_ATOMIC_ADD 4
 
-#if defined(DEBUG)
-#define CACHE_STATS(x) 
-#else
-#define CACHE_STATS(x) 
-#endif
-
 namespace embree
 {
-  class SharedTessellationCacheStats
+  /*! statistics of the shared tessellation cache */
+  struct TessellationCacheStats
   {
-  public:
-    /* stats */
-    static std::atomic<size_t> cache_accesses;
-    static std::atomic<size_t> cache_hits;
-    static std::atomic<size_t> cache_misses;
-    static std::atomic<size_t> cache_flushes;                
-    static size_t        cache_num_patches;
-    __aligned(64) static SpinLock mtx;
-    
-    /* print stats for debugging */                 
-    static void printStats();
-    static void clearStats();
+    TessellationCacheStats ()
+      : hits(0), misses(0), evictions(0), flushes(0), resizes(0) {}
+
+    size_t hits;       //!< number of lookups that found a valid cache entry
+    size_t misses;     //!< number of lookups that had to construct the entry
+    size_t evictions;  //!< number of misses of entries that were cached before but got reclaimed or invalidated
+    size_t flushes;    //!< number of reclaimed cache segments
+    size_t resizes;    //!< number of adaptive resize operations
   };
-  
+
   void resizeTessellationCache(size_t new_size);
   void resetTessellationCache();
+  void setTessellationCacheLimits(size_t min_size, size_t max_size);
+  void adaptTessellationCache();
+  TessellationCacheStats getTessellationCacheStats();
+  void clearTessellationCacheStats();
   
  ////////////////////////////////////////////////////////////////////////////////
  ////////////////////////////////////////////////////////////////////////////////
@@ -49,11 +44,23 @@ namespace embree
    ThreadWorkState* next;
    bool allocated;
 
+   /* per thread statistics, only written by the owning thread */
+   std::atomic<size_t> hits;
+   std::atomic<size_t> misses;
+   std::atomic<size_t> evictions;
+
+   /* buffer epoch+1 of an in-flight entry construction, 0 if idle */
+   std::atomic<size_t> buildEpoch;
+
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), next(nullptr), allocated(allocated), hits(0), misses(0), evictions(0), buildEpoch(0)
    {
      assert( ((size_t)this % 64) == 0 ); 
    }   
+
+   static __forceinline void increment(std::atomic<size_t>& stat) {
+     stat.store(stat.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+   }
  };
 
  class __aligned(64) SharedLazyTessellationCache 
@@ -70,6 +77,9 @@ namespace embree
 #endif
    static const size_t MAX_TESSELLATION_CACHE_SIZE     = REF_TAG_MASK+1;
    static const size_t BLOCK_SIZE                      = 64;
+   static const size_t MIN_SHRINK_WINDOW               = 16;
+   static const size_t MAX_SHRINK_WINDOW               = 1024;
+   static const size_t MIN_SHRINK_SIZE                 = 1024*1024;
    
 
     /*! Per thread tessellation ref cache */
@@ -132,6 +142,33 @@ namespace embree
    size_t size;
    size_t maxBlocks;
    ThreadWorkState *threadWorkState;
+
+   /* buffers replaced by adaptive resizing, freed once no construction references them anymore */
+   struct RetiredBuffer
+   {
+     float* data;
+     size_t size;
+     bool hugepages;
+     size_t epoch;
+   };
+   std::vector<RetiredBuffer> retiredBuffers;
+   std::atomic<size_t> bufferEpoch;
+
+   /* adaptive sizing state */
+   size_t minSize;
+   size_t maxSize;
+   size_t cycleSegments;
+   size_t cycleAccesses;
+   size_t cycleEvictions;
+   size_t adaptCommits;
+   size_t adaptAllocatedBlocks;
+   size_t shrinkWindow;
+   size_t flushedBlocks;
+
+   /* statistics */
+   std::atomic<size_t> numFlushes;
+   std::atomic<size_t> numResizes;
+   TessellationCacheStats statsBase;
       
    __aligned(64) std::atomic<size_t> localTime;
    __aligned(64) std::atomic<size_t> next_block;
@@ -196,7 +233,6 @@ namespace embree
    static __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
    {   
      const int64_t subdiv_patch_root_ref = entry.tag.get(); 
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      
      if (likely(subdiv_patch_root_ref != 0)) 
      {
@@ -204,12 +240,8 @@ namespace embree
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
        
        if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
-       {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
          return (void*) subdiv_patch_root;
-       }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return nullptr;
    }
 
@@ -222,12 +254,21 @@ namespace embree
      {
        sharedLazyTessellationCache.lockThreadLoop(t_state);
        void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       if (patch) {
+         ThreadWorkState::increment(t_state->hits);
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
+           ThreadWorkState::increment(t_state->misses);
+           if (entry.tag.get() != 0) ThreadWorkState::increment(t_state->evictions);
+
+           /* the cache buffer may get replaced by an adaptive resize while we construct */
+           const size_t epoch = sharedLazyTessellationCache.getBufferEpoch();
+           t_state->buildEpoch = epoch+1;
            auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
            auto ret = constructor(); // thread is locked here!
            assert(ret);
@@ -235,8 +276,10 @@ namespace embree
            auto timeAfter = sharedLazyTessellationCache.getTime(globalTime);
            auto time = before ? timeBefore : timeAfter;
            __memory_barrier();
-           entry.tag = SharedLazyTessellationCache::Tag(ret,time);
+           if (likely(epoch == sharedLazyTessellationCache.getBufferEpoch()))
+             entry.tag = SharedLazyTessellationCache::Tag(ret,time);
            __memory_barrier();
+           t_state->buildEpoch = 0;
            entry.mutex.unlock();
            return ret;
          }
@@ -314,12 +357,33 @@ namespace embree
    __forceinline size_t getNumUsedBytes() { return next_block * BLOCK_SIZE; }
    __forceinline size_t getMaxBlocks()    { return maxBlocks; }
    __forceinline size_t getSize()         { return size; }
+   __forceinline size_t getBufferEpoch()  { return bufferEpoch.load(); }
 
    void allocNextSegment();
    void realloc(const size_t newSize);
 
    void reset();
 
+   /*! sets the range the cache may grow or shrink in, adaptive sizing is disabled if both are equal */
+   void setLimits(const size_t minSize, const size_t maxSize);
+
+   /*! shrinks the cache if its allocation rate stayed low over the last commits */
+   void adapt();
+
+   TessellationCacheStats getStats();
+   void clearStats();
+
+ private:
+   void blockThreads();
+   void unblockThreads();
+   TessellationCacheStats sumThreadStats();
+   void resizeBuffer(const size_t newSize);
+   void freeRetiredBuffers();
+   size_t segmentBlocks() const;
+   size_t allocatedBlocks() const;
+
+ public:
+
    static SharedLazyTessellationCache sharedLazyTessellationCache;
  };
 }
@@ -46,6 +46,13 @@ SYCL_EXTERNAL __attribute__((always_inline)) void rtcIntersect1(RTCScene hscene,
     rtcInitRayQueryContext(&defaultContext);
     context = &defaultContext;
   }
+
+  /* multi hit queries are not supported on the GPU, as device code cannot report errors such a query reports no hit */
+  if (unlikely(args->multiHit != nullptr)) {
+    args->multiHit->numHits = 0;
+    rayhit->hit.geomID = RTC_INVALID_GEOMETRY_ID;
+    return;
+  }
     
   rtcIntersectRTHW(hscene, context, rayhit, args); 
 }
@@ -106,6 +106,9 @@ __forceinline bool intersect_user_geometry(intel_ray_query_t& query, RayHit& ray
   raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
 #endif
 
+  if (context->cullBackfaces())
+    raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
+
   intel_raytracing_acceleration_structure_t hwaccel_ptr = (intel_raytracing_acceleration_structure_t) scene->hwaccel.data();
 
   EmbreeHWAccel* hwaccel = (EmbreeHWAccel*) hwaccel_ptr;
@@ -147,6 +150,9 @@ __forceinline bool intersect_user_geometry(intel_ray_query_t& query, Ray& ray, U
   raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
 #endif
 
+  if (context->cullBackfaces())
+    raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
+
   intel_raytracing_acceleration_structure_t hwaccel_ptr = (intel_raytracing_acceleration_structure_t) scene->hwaccel.data();
 
   EmbreeHWAccel* hwaccel = (EmbreeHWAccel*) hwaccel_ptr;
@@ -194,6 +200,9 @@ __forceinline bool intersect_instance(intel_ray_query_t& query, RayHit& ray, Ins
   raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
 #endif
 
+  if (context->cullBackfaces())
+    raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
+
   intel_raytracing_acceleration_structure_t hwaccel_ptr = (intel_raytracing_acceleration_structure_t) object->hwaccel.data();
   
   uint32_t bvh_id = 0;
@@ -245,6 +254,9 @@ __forceinline bool intersect_instance(intel_ray_query_t& query, Ray& ray, Instan
   raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
 #endif
 
+  if (context->cullBackfaces())
+    raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
+
   intel_raytracing_acceleration_structure_t hwaccel_ptr = (intel_raytracing_acceleration_structure_t) object->hwaccel.data();
   
   uint32_t bvh_id = 0;
@@ -301,6 +313,9 @@ __forceinline bool intersect_instance_array(intel_ray_query_t& query, RayHit& ra
   raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
 #endif
 
+  if (context->cullBackfaces())
+    raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
+
   intel_raytracing_acceleration_structure_t hwaccel_ptr = (intel_raytracing_acceleration_structure_t) object->hwaccel.data();
   
   uint32_t bvh_id = 0;
@@ -354,6 +369,9 @@ __forceinline bool intersect_instance_array(intel_ray_query_t& query, Ray& ray,
   raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
 #endif
 
+  if (context->cullBackfaces())
+    raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
+
   intel_raytracing_acceleration_structure_t hwaccel_ptr = (intel_raytracing_acceleration_structure_t) object->hwaccel.data();
   
   uint32_t bvh_id = 0;
@@ -733,6 +751,9 @@ SYCL_EXTERNAL __attribute__((always_inline)) void rtcIntersectRTHW(sycl::global_
   raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
 #endif
 
+  if (context.cullBackfaces())
+    raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
+
   if (context.enforceArgumentFilterFunction())
      raydesc.flags |= intel_ray_flags_force_non_opaque;
 
@@ -837,6 +858,9 @@ SYCL_EXTERNAL __attribute__((always_inline)) void rtcOccludedRTHW(sycl::global_p
   raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
 #endif
 
+  if (context.cullBackfaces())
+    raydesc.flags |= intel_ray_flags_cull_back_facing_triangles;
+
   if (context.enforceArgumentFilterFunction())
      raydesc.flags |= intel_ray_flags_force_non_opaque;
 
@@ -196,6 +196,7 @@ namespace embree {
     size_t objects = getNumObjects(scene_in);
     size_t iterations = 0;
     double time = 0.0;
+    SampleStatistics samples;
     for(size_t i=0;i<benchmark_iterations+params.skipIterations;i++)
     {
       updateObjects(scene_in,scene);
@@ -206,9 +207,12 @@ namespace embree {
       {
         time += t1 - t0;
         iterations++;
+        samples.add(float(double(primitives)/(t1-t0)/1000000.0));
       }
     }
 
+    BenchResults::add(params.name,"mprims","Mprims/s",true,samples);
+
     if (quality == RTC_BUILD_QUALITY_MEDIUM)
       std::cout << "BENCHMARK_UPDATE_DYNAMIC_STATIC ";
     else if (quality == RTC_BUILD_QUALITY_LOW)
@@ -283,6 +287,7 @@ namespace embree {
     size_t objects = getNumObjects(scene_in);
     size_t iterations = 0;
     double time = 0.0;
+    SampleStatistics samples;
     for(size_t i=0;i<benchmark_iterations+params.skipIterations;i++)
     {
       deleteObjects(scene_in,scene);
@@ -294,9 +299,12 @@ namespace embree {
       {
         time += t1 - t0;
         iterations++;
+        samples.add(float(double(primitives)/(t1-t0)/1000000.0));
       }
     }
 
+    BenchResults::add(params.name,"mprims","Mprims/s",true,samples);
+
     if (quality == RTC_BUILD_QUALITY_MEDIUM)
       std::cout << "BENCHMARK_CREATE_DYNAMIC_STATIC ";
     else if (quality == RTC_BUILD_QUALITY_LOW)
@@ -368,6 +376,7 @@ namespace embree {
     size_t objects = getNumObjects(scene_in);
     size_t iterations = 0;
     double time = 0.0;
+    SampleStatistics samples;
 
     for(size_t i=0;i<benchmark_iterations+params.skipIterations;i++)
     {
@@ -385,10 +394,13 @@ namespace embree {
       {
         time += t1 - t0;
         iterations++;
+        samples.add(float(double(primitives)/(t1-t0)/1000000.0));
       }
       rtcReleaseScene (scene);
     }
 
+    BenchResults::add(params.name,"mprims","Mprims/s",true,samples);
+
     if (qflags == RTC_BUILD_QUALITY_HIGH)
       std::cout << "BENCHMARK_CREATE_HQ_STATIC_";
     else
@@ -490,6 +502,7 @@ namespace embree {
     size_t objects = getNumObjects(scene_in);
     size_t iterations = 0;
     double time = 0.0;
+    SampleStatistics samples;
     const size_t numThreads = g_num_user_threads;
 
     Helper helper;
@@ -520,6 +533,7 @@ namespace embree {
       {
         time += t1 - t0;
         iterations++;
+        samples.add(float(double(primitives)/(t1-t0)/1000000.0));
       }
 
       if (iterations == 0) iterations = 1;
@@ -536,6 +550,8 @@ namespace embree {
     for (auto& thread: threads)
       thread.join();
 
+    BenchResults::add(params.name,"mprims","Mprims/s",true,samples);
+
     if (qflags == RTC_BUILD_QUALITY_HIGH)
       std::cout << "BENCHMARK_CREATE_HQ_STATIC_";
     else
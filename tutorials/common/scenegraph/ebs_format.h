@@ -0,0 +1,140 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "scenegraph.h"
+
+namespace embree
+{
+  /*! Layout of the Embree binary scene (.ebs) file format.
+
+      The file starts with a header, followed by the data arrays, the
+      array table, and the node table. Each data array starts at a 64
+      byte aligned file offset and stores its elements in the in-memory
+      layout of the scene graph (e.g. Vec3fa vertices), thus arrays can
+      get copied directly from the memory mapped file. Arrays with
+      multiple time steps store all time steps consecutively.
+
+      Each node references a consecutive range of arrays in the array
+      table. The first three arrays of each node are the node name, the
+      indices of referenced nodes, and the node parameters, the
+      remaining arrays depend on the node type. Nodes are stored after
+      all nodes they reference, thus nodes shared by multiple parents
+      (e.g. instanced objects, materials, and textures) are stored only
+      once and the last node is the root of the scene. */
+
+  namespace EBS
+  {
+    static const uint32_t MAGIC = 0x53424545; // "EEBS"
+    static const uint32_t VERSION = 1;
+    static const size_t ALIGNMENT = 64;
+    static const uint32_t INVALID_NODE = 0xFFFFFFFF;
+
+    enum NodeType
+    {
+      NODE_TEXTURE,           // subtype: texture format, parms: width, height, arrays: texels
+      NODE_MATERIAL,          // subtype: material type, refs: textures of OBJ material, parms: material parameters
+      NODE_TRIANGLE_MESH,     // refs: material, arrays: positions, normals, texcoords, triangles
+      NODE_QUAD_MESH,         // refs: material, arrays: positions, normals, texcoords, quads
+      NODE_GRID_MESH,         // refs: material, arrays: positions, grids
+      NODE_SUBDIV_MESH,       // refs: material, parms: subdivision modes, tessellation rate, arrays: see SUBDIV_*
+      NODE_CURVES,            // subtype: geometry type, refs: material, parms: tessellation rate, arrays: see CURVES_*
+      NODE_POINTS,            // subtype: geometry type, refs: material, arrays: positions, normals
+      NODE_TRANSFORM,         // subtype: quaternion flag, refs: child, arrays: transformations
+      NODE_MULTI_TRANSFORM,   // refs: child, arrays: instance descriptors, transformations of all instances
+      NODE_GROUP,             // refs: children
+      NODE_LIGHT,             // subtype: light type, parms: light parameters
+      NODE_ANIMATED_LIGHT,    // refs: lights
+      NODE_CAMERA,            // parms: from, to, up, fov
+      NODE_ANIMATED_CAMERA,   // refs: cameras
+    };
+
+    /* indices of the arrays of a node */
+    enum
+    {
+      ARRAY_NAME = 0,
+      ARRAY_REFS = 1,
+      ARRAY_PARMS = 2,
+      ARRAY_DATA = 3,
+
+      MESH_POSITIONS = ARRAY_DATA,
+      MESH_NORMALS,
+      MESH_TEXCOORDS,
+      MESH_INDICES,
+
+      GRID_POSITIONS = ARRAY_DATA,
+      GRID_GRIDS,
+
+      SUBDIV_POSITIONS = ARRAY_DATA,
+      SUBDIV_NORMALS,
+      SUBDIV_TEXCOORDS,
+      SUBDIV_POSITION_INDICES,
+      SUBDIV_NORMAL_INDICES,
+      SUBDIV_TEXCOORD_INDICES,
+      SUBDIV_VERTICES_PER_FACE,
+      SUBDIV_HOLES,
+      SUBDIV_EDGE_CREASES,
+      SUBDIV_EDGE_CREASE_WEIGHTS,
+      SUBDIV_VERTEX_CREASES,
+      SUBDIV_VERTEX_CREASE_WEIGHTS,
+
+      CURVES_POSITIONS = ARRAY_DATA,
+      CURVES_NORMALS,
+      CURVES_TANGENTS,
+      CURVES_DNORMALS,
+      CURVES_HAIRS,
+      CURVES_FLAGS,
+
+      POINTS_POSITIONS = ARRAY_DATA,
+      POINTS_NORMALS,
+
+      TRANSFORM_SPACES = ARRAY_DATA,
+
+      MULTI_TRANSFORM_INSTANCES = ARRAY_DATA,
+      MULTI_TRANSFORM_SPACES,
+
+      TEXTURE_TEXELS = ARRAY_DATA,
+    };
+
+    struct Header
+    {
+      uint32_t magic;         //!< MAGIC, also detects wrong endianness
+      uint32_t version;       //!< VERSION
+      uint64_t fileSize;      //!< size of the entire file in bytes
+      uint64_t arrayTableOfs; //!< file offset of the array table
+      uint64_t numArrays;     //!< number of entries in the array table
+      uint64_t nodeTableOfs;  //!< file offset of the node table
+      uint64_t numNodes;      //!< number of entries in the node table
+      uint32_t reserved[4];
+    };
+
+    struct Array
+    {
+      uint64_t ofs;           //!< 64 byte aligned file offset of the data, 0 for empty arrays
+      uint64_t bytes;         //!< size of the data in bytes
+      uint64_t numTimeSteps;  //!< number of time steps stored consecutively
+      uint64_t reserved;
+    };
+
+    struct Node
+    {
+      uint32_t type;          //!< NodeType
+      uint32_t subtype;       //!< node type specific
+      float time_lower;       //!< time range of motion blurred nodes
+      float time_upper;
+      uint64_t firstArray;    //!< index of the first array of the node in the array table
+      uint32_t numArrays;     //!< number of arrays of the node
+      uint32_t reserved;
+    };
+
+    /* instance descriptor of multi transform nodes */
+    struct Instance
+    {
+      float time_lower;
+      float time_upper;
+      uint32_t numTimeSteps;  //!< number of transformations of the instance
+      uint32_t quaternion;    //!< transformations are quaternion decompositions
+    };
+  }
+}
@@ -0,0 +1,611 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ebs_loader.h"
+#include "ebs_format.h"
+#include "../../../common/sys/mapped_file.h"
+#include "../../../common/algorithms/parallel_for.h"
+
+namespace embree
+{
+  class EBSLoader
+  {
+  public:
+
+    EBSLoader(const FileName& fileName);
+    Ref<SceneGraph::Node> load();
+
+  private:
+
+    /*! reads the parameters of a node */
+    struct Parms
+    {
+      Parms (const EBSLoader* loader, const char* ptr, size_t bytes)
+        : loader(loader), ptr(ptr), bytes(bytes), ofs(0) {}
+
+      template<typename T>
+      T get()
+      {
+        if (sizeof(T) > bytes-ofs) loader->corrupt();
+        T v; memcpy((void*)&v,ptr+ofs,sizeof(T));
+        ofs += sizeof(T);
+        return v;
+      }
+
+      const EBSLoader* loader;
+      const char* ptr;
+      size_t bytes;
+      size_t ofs;
+    };
+
+  private:
+    __noinline void corrupt() const;
+
+    const EBS::Array& getArray(const EBS::Node& node, size_t i) const;
+    void copy(void* dst, const EBS::Array& array, size_t ofs, size_t bytes) const;
+
+    template<typename Vector> void loadArray(const EBS::Node& node, size_t i, Vector& vec) const;
+    template<typename Vector> void loadTimeSteps(const EBS::Node& node, size_t i, std::vector<Vector>& steps) const;
+
+    std::string loadName(const EBS::Node& node) const;
+    Parms loadParms(const EBS::Node& node) const;
+    std::vector<Ref<SceneGraph::Node>> loadRefs(const EBS::Node& node) const;
+    Ref<SceneGraph::MaterialNode> loadMaterialRef(const EBS::Node& node) const;
+
+    template<typename T> Ref<T> cast(const Ref<SceneGraph::Node>& node) const;
+
+    std::shared_ptr<Texture> loadTexture(const EBS::Node& node) const;
+    Ref<SceneGraph::Node> loadMaterial(const EBS::Node& node) const;
+    Ref<SceneGraph::Node> loadLight(const EBS::Node& node) const;
+
+    Ref<SceneGraph::Node> loadTriangleMesh(const EBS::Node& node) const;
+    Ref<SceneGraph::Node> loadQuadMesh(const EBS::Node& node) const;
+    Ref<SceneGraph::Node> loadGridMesh(const EBS::Node& node) const;
+    Ref<SceneGraph::Node> loadSubdivMesh(const EBS::Node& node) const;
+    Ref<SceneGraph::Node> loadCurves(const EBS::Node& node) const;
+    Ref<SceneGraph::Node> loadPoints(const EBS::Node& node) const;
+
+    Ref<SceneGraph::Node> loadTransform(const EBS::Node& node) const;
+    Ref<SceneGraph::Node> loadMultiTransform(const EBS::Node& node) const;
+    Ref<SceneGraph::Node> loadNode(const EBS::Node& node) const;
+
+  private:
+    FileName fileName;
+    MappedFile file;
+    const EBS::Array* arrays;
+    size_t numArrays;
+    const EBS::Node* nodes;
+    size_t numNodes;
+
+  private:
+    std::vector<Ref<SceneGraph::Node>> id2node;
+    std::vector<std::shared_ptr<Texture>> id2texture;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  //// Loading of arrays
+  //////////////////////////////////////////////////////////////////////////////
+
+  void EBSLoader::corrupt() const {
+    THROW_RUNTIME_ERROR("corrupt binary scene file: "+fileName.str());
+  }
+
+  const EBS::Array& EBSLoader::getArray(const EBS::Node& node, size_t i) const
+  {
+    if (i >= node.numArrays) corrupt();
+    return arrays[node.firstArray+i];
+  }
+
+  void EBSLoader::copy(void* dst, const EBS::Array& array, size_t ofs, size_t bytes) const
+  {
+    const char* src = file.data()+array.ofs+ofs;
+
+    /* small arrays are copied directly */
+    const size_t blockSize = 4*1024*1024;
+    if (bytes <= blockSize) {
+      if (bytes) memcpy(dst,src,bytes);
+      return;
+    }
+
+    /* large arrays are copied in parallel to fault in pages concurrently */
+    parallel_for(size_t(0), (bytes+blockSize-1)/blockSize, [&] (const range<size_t>& r) {
+      for (size_t i=r.begin(); i<r.end(); i++) {
+        const size_t begin = i*blockSize;
+        const size_t end = std::min(begin+blockSize,bytes);
+        memcpy((char*)dst+begin,src+begin,end-begin);
+      }
+    });
+  }
+
+  template<typename Vector>
+  void EBSLoader::loadArray(const EBS::Node& node, size_t i, Vector& vec) const
+  {
+    const EBS::Array& array = getArray(node,i);
+    if (array.bytes % sizeof(vec[0])) corrupt();
+    vec.resize(array.bytes/sizeof(vec[0]));
+    copy(vec.data(),array,0,array.bytes);
+  }
+
+  template<typename Vector>
+  void EBSLoader::loadTimeSteps(const EBS::Node& node, size_t i, std::vector<Vector>& steps) const
+  {
+    const EBS::Array& array = getArray(node,i);
+    if (array.numTimeSteps == 0) {
+      if (array.bytes) corrupt();
+      return;
+    }
+
+    /* validate the number of time steps before computing with it, as a corrupt count can overflow */
+    if (array.numTimeSteps > array.bytes/sizeof(steps[0][0])) corrupt();
+    if (array.bytes % (array.numTimeSteps*sizeof(steps[0][0]))) corrupt();
+
+    const size_t stepBytes = array.bytes/array.numTimeSteps;
+    steps.resize(array.numTimeSteps);
+    for (size_t t=0; t<array.numTimeSteps; t++) {
+      steps[t].resize(stepBytes/sizeof(steps[0][0]));
+      copy(steps[t].data(),array,t*stepBytes,stepBytes);
+    }
+  }
+
+  std::string EBSLoader::loadName(const EBS::Node& node) const
+  {
+    const EBS::Array& array = getArray(node,EBS::ARRAY_NAME);
+    return std::string(file.data()+array.ofs,array.bytes);
+  }
+
+  EBSLoader::Parms EBSLoader::loadParms(const EBS::Node& node) const
+  {
+    const EBS::Array& array = getArray(node,EBS::ARRAY_PARMS);
+    return Parms(this,file.data()+array.ofs,array.bytes);
+  }
+
+  std::vector<Ref<SceneGraph::Node>> EBSLoader::loadRefs(const EBS::Node& node) const
+  {
+    std::vector<uint32_t> ids;
+    loadArray(node,EBS::ARRAY_REFS,ids);
+
+    /* nodes can only reference previously loaded nodes, which also excludes cycles */
+    const size_t index = &node - nodes;
+    std::vector<Ref<SceneGraph::Node>> refs(ids.size());
+    for (size_t i=0; i<ids.size(); i++) {
+      if (ids[i] == EBS::INVALID_NODE) continue;
+      if (ids[i] >= index) corrupt();
+      refs[i] = id2node[ids[i]];
+    }
+    return refs;
+  }
+
+  template<typename T>
+  Ref<T> EBSLoader::cast(const Ref<SceneGraph::Node>& node) const
+  {
+    if (!node) return nullptr;
+    Ref<T> r = node.dynamicCast<T>();
+    if (!r) corrupt();
+    return r;
+  }
+
+  Ref<SceneGraph::MaterialNode> EBSLoader::loadMaterialRef(const EBS::Node& node) const
+  {
+    const std::vector<Ref<SceneGraph::Node>> refs = loadRefs(node);
+    if (refs.size() != 1) corrupt();
+    return cast<SceneGraph::MaterialNode>(refs[0]);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  //// Loading of nodes
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::shared_ptr<Texture> EBSLoader::loadTexture(const EBS::Node& node) const
+  {
+    Parms parms = loadParms(node);
+    const unsigned width  = parms.get<uint32_t>();
+    const unsigned height = parms.get<uint32_t>();
+    const Texture::Format format = (Texture::Format) node.subtype;
+    if (format != Texture::RGBA8 && format != Texture::RGB8 && format != Texture::FLOAT32) corrupt();
+
+    const EBS::Array& texels = getArray(node,EBS::TEXTURE_TEXELS);
+    if (texels.bytes != size_t(width)*size_t(height)*Texture::getFormatBytesPerTexel(format)) corrupt();
+
+    std::shared_ptr<Texture> texture = std::make_shared<Texture>(width,height,format,file.data()+texels.ofs);
+    texture->fileName = loadName(node);
+    return texture;
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadMaterial(const EBS::Node& node) const
+  {
+    Parms parms = loadParms(node);
+    Ref<SceneGraph::MaterialNode> material;
+
+    switch (node.subtype)
+    {
+    case MATERIAL_OBJ:
+    {
+      std::vector<uint32_t> ids;
+      loadArray(node,EBS::ARRAY_REFS,ids);
+      if (ids.size() != 7) corrupt();
+
+      std::shared_ptr<Texture> maps[7];
+      for (size_t i=0; i<7; i++) {
+        if (ids[i] == EBS::INVALID_NODE) continue;
+        if (ids[i] >= id2texture.size() || !id2texture[ids[i]]) corrupt();
+        maps[i] = id2texture[ids[i]];
+      }
+
+      Ref<OBJMaterial> m = new OBJMaterial;
+      m->illum = parms.get<int>();
+      m->d  = parms.get<float>();
+      m->Ns = parms.get<float>();
+      m->Ni = parms.get<float>();
+      m->Ka = parms.get<Vec3fa>();
+      m->Kd = parms.get<Vec3fa>();
+      m->Ks = parms.get<Vec3fa>();
+      m->Kt = parms.get<Vec3fa>();
+      m->_map_d = maps[0]; m->_map_Ka = maps[1]; m->_map_Kd = maps[2]; m->_map_Ks = maps[3];
+      m->_map_Kt = maps[4]; m->_map_Ns = maps[5]; m->_map_Displ = maps[6];
+      material = m.dynamicCast<SceneGraph::MaterialNode>();
+      break;
+    }
+    case MATERIAL_THIN_DIELECTRIC: {
+      const Vec3fa transmission = parms.get<Vec3fa>();
+      const float eta = parms.get<float>();
+      const float thickness = parms.get<float>();
+      material = new ThinDielectricMaterial(transmission,eta,thickness);
+      break;
+    }
+    case MATERIAL_METAL:
+    case MATERIAL_REFLECTIVE_METAL: {
+      const Vec3fa reflectance = parms.get<Vec3fa>();
+      const Vec3fa eta = parms.get<Vec3fa>();
+      const Vec3fa k = parms.get<Vec3fa>();
+      const float roughness = parms.get<float>();
+      if (node.subtype == MATERIAL_METAL) material = new MetalMaterial(reflectance,eta,k,roughness);
+      else                                material = new ReflectiveMetalMaterial(reflectance,eta,k);
+      break;
+    }
+    case MATERIAL_VELVET: {
+      const Vec3fa reflectance = parms.get<Vec3fa>();
+      const float backScattering = parms.get<float>();
+      const Vec3fa horizonScatteringColor = parms.get<Vec3fa>();
+      const float horizonScatteringFallOff = parms.get<float>();
+      material = new VelvetMaterial(reflectance,backScattering,horizonScatteringColor,horizonScatteringFallOff);
+      break;
+    }
+    case MATERIAL_DIELECTRIC: {
+      const Vec3fa transmissionOutside = parms.get<Vec3fa>();
+      const Vec3fa transmissionInside = parms.get<Vec3fa>();
+      const float etaOutside = parms.get<float>();
+      const float etaInside = parms.get<float>();
+      material = new DielectricMaterial(transmissionOutside,transmissionInside,etaOutside,etaInside);
+      break;
+    }
+    case MATERIAL_METALLIC_PAINT: {
+      const Vec3fa shadeColor = parms.get<Vec3fa>();
+      const Vec3fa glitterColor = parms.get<Vec3fa>();
+      const float glitterSpread = parms.get<float>();
+      const float eta = parms.get<float>();
+      material = new MetallicPaintMaterial(shadeColor,glitterColor,glitterSpread,eta);
+      break;
+    }
+    case MATERIAL_MATTE:
+      material = new MatteMaterial(parms.get<Vec3fa>());
+      break;
+    case MATERIAL_MIRROR:
+      material = new MirrorMaterial(parms.get<Vec3fa>());
+      break;
+    case MATERIAL_HAIR: {
+      const Vec3fa Kr = parms.get<Vec3fa>();
+      const Vec3fa Kt = parms.get<Vec3fa>();
+      const float nx = parms.get<float>();
+      const float ny = parms.get<float>();
+      material = new HairMaterial(Kr,Kt,nx,ny);
+      break;
+    }
+    default:
+      corrupt();
+    }
+    return material.dynamicCast<SceneGraph::Node>();
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadLight(const EBS::Node& node) const
+  {
+    Parms parms = loadParms(node);
+    switch (node.subtype)
+    {
+    case SceneGraph::LIGHT_AMBIENT: {
+      const Vec3fa L = parms.get<Vec3fa>();
+      return new SceneGraph::LightNodeImpl<SceneGraph::AmbientLight>(SceneGraph::AmbientLight(L));
+    }
+    case SceneGraph::LIGHT_POINT: {
+      const Vec3fa P = parms.get<Vec3fa>();
+      const Vec3fa I = parms.get<Vec3fa>();
+      return new SceneGraph::LightNodeImpl<SceneGraph::PointLight>(SceneGraph::PointLight(P,I));
+    }
+    case SceneGraph::LIGHT_DIRECTIONAL: {
+      const Vec3fa D = parms.get<Vec3fa>();
+      const Vec3fa E = parms.get<Vec3fa>();
+      return new SceneGraph::LightNodeImpl<SceneGraph::DirectionalLight>(SceneGraph::DirectionalLight(D,E));
+    }
+    case SceneGraph::LIGHT_SPOT: {
+      const Vec3fa P = parms.get<Vec3fa>();
+      const Vec3fa D = parms.get<Vec3fa>();
+      const Vec3fa I = parms.get<Vec3fa>();
+      const float angleMin = parms.get<float>();
+      const float angleMax = parms.get<float>();
+      return new SceneGraph::LightNodeImpl<SceneGraph::SpotLight>(SceneGraph::SpotLight(P,D,I,angleMin,angleMax));
+    }
+    case SceneGraph::LIGHT_DISTANT: {
+      const Vec3fa D = parms.get<Vec3fa>();
+      const Vec3fa L = parms.get<Vec3fa>();
+      const float halfAngle = parms.get<float>();
+      return new SceneGraph::LightNodeImpl<SceneGraph::DistantLight>(SceneGraph::DistantLight(D,L,halfAngle));
+    }
+    case SceneGraph::LIGHT_TRIANGLE: {
+      const Vec3fa v0 = parms.get<Vec3fa>();
+      const Vec3fa v1 = parms.get<Vec3fa>();
+      const Vec3fa v2 = parms.get<Vec3fa>();
+      const Vec3fa L = parms.get<Vec3fa>();
+      return new SceneGraph::LightNodeImpl<SceneGraph::TriangleLight>(SceneGraph::TriangleLight(v0,v1,v2,L));
+    }
+    case SceneGraph::LIGHT_QUAD: {
+      const Vec3fa v0 = parms.get<Vec3fa>();
+      const Vec3fa v1 = parms.get<Vec3fa>();
+      const Vec3fa v2 = parms.get<Vec3fa>();
+      const Vec3fa v3 = parms.get<Vec3fa>();
+      const Vec3fa L = parms.get<Vec3fa>();
+      return new SceneGraph::LightNodeImpl<SceneGraph::QuadLight>(SceneGraph::QuadLight(v0,v1,v2,v3,L));
+    }
+    default:
+      corrupt();
+      return nullptr;
+    }
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadTriangleMesh(const EBS::Node& node) const
+  {
+    Ref<SceneGraph::TriangleMeshNode> mesh = new SceneGraph::TriangleMeshNode(loadMaterialRef(node),BBox1f(node.time_lower,node.time_upper),0);
+    loadTimeSteps(node,EBS::MESH_POSITIONS,mesh->positions);
+    loadTimeSteps(node,EBS::MESH_NORMALS,mesh->normals);
+    loadArray(node,EBS::MESH_TEXCOORDS,mesh->texcoords);
+    loadArray(node,EBS::MESH_INDICES,mesh->triangles);
+    if (mesh->positions.size() == 0) corrupt();
+    return mesh.dynamicCast<SceneGraph::Node>();
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadQuadMesh(const EBS::Node& node) const
+  {
+    Ref<SceneGraph::QuadMeshNode> mesh = new SceneGraph::QuadMeshNode(loadMaterialRef(node),BBox1f(node.time_lower,node.time_upper),0);
+    loadTimeSteps(node,EBS::MESH_POSITIONS,mesh->positions);
+    loadTimeSteps(node,EBS::MESH_NORMALS,mesh->normals);
+    loadArray(node,EBS::MESH_TEXCOORDS,mesh->texcoords);
+    loadArray(node,EBS::MESH_INDICES,mesh->quads);
+    if (mesh->positions.size() == 0) corrupt();
+    return mesh.dynamicCast<SceneGraph::Node>();
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadGridMesh(const EBS::Node& node) const
+  {
+    Ref<SceneGraph::GridMeshNode> mesh = new SceneGraph::GridMeshNode(loadMaterialRef(node),BBox1f(node.time_lower,node.time_upper),0);
+    loadTimeSteps(node,EBS::GRID_POSITIONS,mesh->positions);
+    loadArray(node,EBS::GRID_GRIDS,mesh->grids);
+    if (mesh->positions.size() == 0) corrupt();
+    return mesh.dynamicCast<SceneGraph::Node>();
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadSubdivMesh(const EBS::Node& node) const
+  {
+    Ref<SceneGraph::SubdivMeshNode> mesh = new SceneGraph::SubdivMeshNode(loadMaterialRef(node),BBox1f(node.time_lower,node.time_upper),0);
+    Parms parms = loadParms(node);
+    mesh->position_subdiv_mode = (RTCSubdivisionMode) parms.get<uint32_t>();
+    mesh->normal_subdiv_mode   = (RTCSubdivisionMode) parms.get<uint32_t>();
+    mesh->texcoord_subdiv_mode = (RTCSubdivisionMode) parms.get<uint32_t>();
+    mesh->tessellationRate = parms.get<float>();
+    loadTimeSteps(node,EBS::SUBDIV_POSITIONS,mesh->positions);
+    loadTimeSteps(node,EBS::SUBDIV_NORMALS,mesh->normals);
+    loadArray(node,EBS::SUBDIV_TEXCOORDS,mesh->texcoords);
+    loadArray(node,EBS::SUBDIV_POSITION_INDICES,mesh->position_indices);
+    loadArray(node,EBS::SUBDIV_NORMAL_INDICES,mesh->normal_indices);
+    loadArray(node,EBS::SUBDIV_TEXCOORD_INDICES,mesh->texcoord_indices);
+    loadArray(node,EBS::SUBDIV_VERTICES_PER_FACE,mesh->verticesPerFace);
+    loadArray(node,EBS::SUBDIV_HOLES,mesh->holes);
+    loadArray(node,EBS::SUBDIV_EDGE_CREASES,mesh->edge_creases);
+    loadArray(node,EBS::SUBDIV_EDGE_CREASE_WEIGHTS,mesh->edge_crease_weights);
+    loadArray(node,EBS::SUBDIV_VERTEX_CREASES,mesh->vertex_creases);
+    loadArray(node,EBS::SUBDIV_VERTEX_CREASE_WEIGHTS,mesh->vertex_crease_weights);
+    mesh->zero_pad_arrays();
+    if (mesh->positions.size() == 0) corrupt();
+    return mesh.dynamicCast<SceneGraph::Node>();
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadCurves(const EBS::Node& node) const
+  {
+    Ref<SceneGraph::HairSetNode> mesh = new SceneGraph::HairSetNode((RTCGeometryType)node.subtype,loadMaterialRef(node),BBox1f(node.time_lower,node.time_upper),0);
+    Parms parms = loadParms(node);
+    mesh->tessellation_rate = parms.get<unsigned>();
+    loadTimeSteps(node,EBS::CURVES_POSITIONS,mesh->positions);
+    loadTimeSteps(node,EBS::CURVES_NORMALS,mesh->normals);
+    loadTimeSteps(node,EBS::CURVES_TANGENTS,mesh->tangents);
+    loadTimeSteps(node,EBS::CURVES_DNORMALS,mesh->dnormals);
+    loadArray(node,EBS::CURVES_HAIRS,mesh->hairs);
+    loadArray(node,EBS::CURVES_FLAGS,mesh->flags);
+    if (mesh->positions.size() == 0) corrupt();
+    return mesh.dynamicCast<SceneGraph::Node>();
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadPoints(const EBS::Node& node) const
+  {
+    Ref<SceneGraph::PointSetNode> mesh = new SceneGraph::PointSetNode((RTCGeometryType)node.subtype,loadMaterialRef(node),BBox1f(node.time_lower,node.time_upper),0);
+    loadTimeSteps(node,EBS::POINTS_POSITIONS,mesh->positions);
+    loadTimeSteps(node,EBS::POINTS_NORMALS,mesh->normals);
+    if (mesh->positions.size() == 0) corrupt();
+    return mesh.dynamicCast<SceneGraph::Node>();
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadTransform(const EBS::Node& node) const
+  {
+    const std::vector<Ref<SceneGraph::Node>> refs = loadRefs(node);
+    if (refs.size() != 1 || !refs[0]) corrupt();
+
+    SceneGraph::Transformations spaces;
+    spaces.time_range = BBox1f(node.time_lower,node.time_upper);
+    spaces.quaternion = node.subtype != 0;
+    loadArray(node,EBS::TRANSFORM_SPACES,spaces.spaces);
+    if (spaces.size() == 0) corrupt();
+    return new SceneGraph::TransformNode(spaces,refs[0]);
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadMultiTransform(const EBS::Node& node) const
+  {
+    const std::vector<Ref<SceneGraph::Node>> refs = loadRefs(node);
+    if (refs.size() != 1 || !refs[0]) corrupt();
+
+    std::vector<EBS::Instance> instances;
+    loadArray(node,EBS::MULTI_TRANSFORM_INSTANCES,instances);
+
+    /* transformations of all instances are stored consecutively */
+    std::vector<size_t> first(instances.size());
+    size_t numSpaces = 0;
+    for (size_t i=0; i<instances.size(); i++) {
+      if (instances[i].numTimeSteps == 0) corrupt();
+      first[i] = numSpaces;
+      numSpaces += instances[i].numTimeSteps;
+    }
+
+    const EBS::Array& array = getArray(node,EBS::MULTI_TRANSFORM_SPACES);
+    if (array.bytes != numSpaces*sizeof(AffineSpace3ff)) corrupt();
+
+    std::vector<SceneGraph::Transformations> spaces(instances.size());
+    parallel_for(size_t(0), instances.size(), [&] (const range<size_t>& r) {
+      for (size_t i=r.begin(); i<r.end(); i++) {
+        spaces[i] = SceneGraph::Transformations(BBox1f(instances[i].time_lower,instances[i].time_upper),instances[i].numTimeSteps);
+        spaces[i].quaternion = instances[i].quaternion != 0;
+        memcpy((void*)spaces[i].spaces.data(),file.data()+array.ofs+first[i]*sizeof(AffineSpace3ff),instances[i].numTimeSteps*sizeof(AffineSpace3ff));
+      }
+    });
+    return new SceneGraph::MultiTransformNode(spaces,refs[0]);
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::loadNode(const EBS::Node& node) const
+  {
+    switch (node.type)
+    {
+    case EBS::NODE_MATERIAL       : return loadMaterial(node);
+    case EBS::NODE_LIGHT          : return loadLight(node);
+    case EBS::NODE_TRIANGLE_MESH  : return loadTriangleMesh(node);
+    case EBS::NODE_QUAD_MESH      : return loadQuadMesh(node);
+    case EBS::NODE_GRID_MESH      : return loadGridMesh(node);
+    case EBS::NODE_SUBDIV_MESH    : return loadSubdivMesh(node);
+    case EBS::NODE_CURVES         : return loadCurves(node);
+    case EBS::NODE_POINTS         : return loadPoints(node);
+    case EBS::NODE_TRANSFORM      : return loadTransform(node);
+    case EBS::NODE_MULTI_TRANSFORM: return loadMultiTransform(node);
+
+    case EBS::NODE_GROUP: {
+      std::vector<Ref<SceneGraph::Node>> children;
+      for (auto& child : loadRefs(node))
+        if (child) children.push_back(child);
+      return new SceneGraph::GroupNode(children);
+    }
+
+    case EBS::NODE_ANIMATED_LIGHT: {
+      std::vector<Ref<SceneGraph::LightNode>> lights;
+      for (auto& light : loadRefs(node))
+        lights.push_back(cast<SceneGraph::LightNode>(light));
+      if (lights.size() < 2 || !lights[0]) corrupt();
+      return new SceneGraph::AnimatedLightNode(std::move(lights),BBox1f(node.time_lower,node.time_upper));
+    }
+
+    case EBS::NODE_CAMERA: {
+      Parms parms = loadParms(node);
+      const Vec3fa from = parms.get<Vec3fa>();
+      const Vec3fa to = parms.get<Vec3fa>();
+      const Vec3fa up = parms.get<Vec3fa>();
+      const float fov = parms.get<float>();
+      return new SceneGraph::PerspectiveCameraNode(from,to,up,fov);
+    }
+
+    case EBS::NODE_ANIMATED_CAMERA: {
+      std::vector<Ref<SceneGraph::PerspectiveCameraNode>> cameras;
+      for (auto& camera : loadRefs(node))
+        cameras.push_back(cast<SceneGraph::PerspectiveCameraNode>(camera));
+      if (cameras.size() < 2 || !cameras[0]) corrupt();
+      return new SceneGraph::AnimatedPerspectiveCameraNode(std::move(cameras),BBox1f(node.time_lower,node.time_upper));
+    }
+
+    default:
+      corrupt();
+      return nullptr;
+    }
+  }
+
+  EBSLoader::EBSLoader(const FileName& fileName)
+    : fileName(fileName), arrays(nullptr), numArrays(0), nodes(nullptr), numNodes(0)
+  {
+    if (!file.open(fileName))
+      THROW_RUNTIME_ERROR("cannot open file "+fileName.str()+" for reading");
+
+    if (file.size() < sizeof(EBS::Header)) corrupt();
+    EBS::Header header;
+    memcpy(&header,file.data(),sizeof(header));
+    if (header.magic != EBS::MAGIC) corrupt();
+    if (header.version != EBS::VERSION)
+      THROW_RUNTIME_ERROR("unsupported binary scene file version "+std::to_string(header.version)+": "+fileName.str());
+    if (header.fileSize != file.size()) corrupt();
+
+    /* validate tables, such that loading of nodes only has to check indices */
+    const size_t size = file.size();
+    if (header.arrayTableOfs % EBS::ALIGNMENT || header.nodeTableOfs % EBS::ALIGNMENT) corrupt();
+    if (header.arrayTableOfs > size || header.numArrays > (size-header.arrayTableOfs)/sizeof(EBS::Array)) corrupt();
+    if (header.nodeTableOfs  > size || header.numNodes  > (size-header.nodeTableOfs )/sizeof(EBS::Node )) corrupt();
+    if (header.numNodes == 0) corrupt();
+
+    arrays = (const EBS::Array*) (file.data()+header.arrayTableOfs);
+    numArrays = header.numArrays;
+    nodes = (const EBS::Node*) (file.data()+header.nodeTableOfs);
+    numNodes = header.numNodes;
+
+    for (size_t i=0; i<numArrays; i++) {
+      if (arrays[i].ofs % EBS::ALIGNMENT) corrupt();
+      if (arrays[i].ofs > size || arrays[i].bytes > size-arrays[i].ofs) corrupt();
+    }
+    for (size_t i=0; i<numNodes; i++) {
+      if (nodes[i].firstArray > numArrays || nodes[i].numArrays > numArrays-nodes[i].firstArray) corrupt();
+      if (nodes[i].numArrays < EBS::ARRAY_DATA) corrupt();
+    }
+
+    /* let the OS read the array data ahead while the nodes get created */
+    file.prefetch(0,size);
+  }
+
+  Ref<SceneGraph::Node> EBSLoader::load()
+  {
+    id2node.resize(numNodes);
+    id2texture.resize(numNodes);
+
+    for (size_t i=0; i<numNodes; i++)
+    {
+      const EBS::Node& node = nodes[i];
+      if (node.type == EBS::NODE_TEXTURE) {
+        id2texture[i] = loadTexture(node);
+        continue;
+      }
+      id2node[i] = loadNode(node);
+      id2node[i]->name = loadName(node);
+    }
+
+    if (!id2node[numNodes-1]) corrupt();
+
+    /* the root group holds the top level nodes of the scene, a single top
+       level node is returned directly, thus storing a loaded scene does
+       not add another nesting level each time */
+    Ref<SceneGraph::Node> root = id2node[numNodes-1];
+    if (nodes[numNodes-1].type == EBS::NODE_GROUP) {
+      Ref<SceneGraph::GroupNode> group = root.dynamicCast<SceneGraph::GroupNode>();
+      if (group->size() == 1) return group->child(0);
+    }
+    return root;
+  }
+
+  Ref<SceneGraph::Node> SceneGraph::loadEBS(const FileName& fileName) {
+    return EBSLoader(fileName).load();
+  }
+}
@@ -0,0 +1,424 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ebs_writer.h"
+#include "ebs_format.h"
+
+namespace embree
+{
+  class EBSWriter
+  {
+  public:
+
+    EBSWriter(Ref<SceneGraph::Node> root, const FileName& fileName);
+
+  private:
+
+    /*! collects the parameters of a node */
+    struct Parms
+    {
+      template<typename T>
+      Parms& operator<< (const T& v)
+      {
+        const char* ptr = (const char*) &v;
+        data.insert(data.end(),ptr,ptr+sizeof(T));
+        return *this;
+      }
+
+      std::vector<char> data;
+    };
+
+  private:
+    size_t beginArray();
+    void endArray(size_t ofs, size_t bytes, size_t numTimeSteps);
+    void storeArray(const void* data, size_t bytes);
+
+    template<typename Vector> void storeArray(const Vector& vec);
+    template<typename Vector> void storeTimeSteps(const std::vector<Vector>& steps);
+
+    uint32_t storeNode(EBS::NodeType type, uint32_t subtype, const BBox1f& time_range,
+                       const std::string& name, const std::vector<uint32_t>& refs, const Parms& parms, size_t firstArray);
+
+    uint32_t store(const std::shared_ptr<Texture>& texture);
+    uint32_t store(Ref<SceneGraph::MaterialNode> material);
+    uint32_t store(Ref<SceneGraph::LightNode> light);
+
+    uint32_t store(Ref<SceneGraph::TriangleMeshNode> mesh);
+    uint32_t store(Ref<SceneGraph::QuadMeshNode> mesh);
+    uint32_t store(Ref<SceneGraph::GridMeshNode> mesh);
+    uint32_t store(Ref<SceneGraph::SubdivMeshNode> mesh);
+    uint32_t store(Ref<SceneGraph::HairSetNode> mesh);
+    uint32_t store(Ref<SceneGraph::PointSetNode> mesh);
+
+    uint32_t store(Ref<SceneGraph::PerspectiveCameraNode> camera);
+    uint32_t store(Ref<SceneGraph::AnimatedPerspectiveCameraNode> camera);
+    uint32_t store(Ref<SceneGraph::AnimatedLightNode> light);
+    uint32_t store(Ref<SceneGraph::TransformNode> node);
+    uint32_t store(Ref<SceneGraph::MultiTransformNode> node);
+    uint32_t store(Ref<SceneGraph::GroupNode> group);
+    uint32_t store(Ref<SceneGraph::Node> node);
+
+  private:
+    std::fstream file;
+    std::vector<EBS::Array> arrays;
+    std::vector<EBS::Node> nodes;
+    std::map<Ref<SceneGraph::Node>, uint32_t> nodeMap;
+    std::map<std::shared_ptr<Texture>, uint32_t> textureMap;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  //// Storing of arrays
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t EBSWriter::beginArray()
+  {
+    /* pad file to start the array at an aligned offset */
+    const char zeros[EBS::ALIGNMENT] = { 0 };
+    const size_t ofs = (size_t) file.tellp();
+    const size_t aligned = (ofs+EBS::ALIGNMENT-1) & ~(EBS::ALIGNMENT-1);
+    file.write(zeros,aligned-ofs);
+    return aligned;
+  }
+
+  void EBSWriter::endArray(size_t ofs, size_t bytes, size_t numTimeSteps)
+  {
+    EBS::Array array;
+    array.ofs = bytes ? ofs : 0;
+    array.bytes = bytes;
+    array.numTimeSteps = numTimeSteps;
+    array.reserved = 0;
+    arrays.push_back(array);
+  }
+
+  void EBSWriter::storeArray(const void* data, size_t bytes)
+  {
+    const size_t ofs = bytes ? beginArray() : 0;
+    file.write((const char*)data,bytes);
+    endArray(ofs,bytes,1);
+  }
+
+  template<typename Vector>
+  void EBSWriter::storeArray(const Vector& vec) {
+    storeArray(vec.data(),vec.size()*sizeof(vec[0]));
+  }
+
+  template<typename Vector>
+  void EBSWriter::storeTimeSteps(const std::vector<Vector>& steps)
+  {
+    size_t bytes = 0;
+    for (const auto& step : steps) bytes += step.size()*sizeof(step[0]);
+    if (steps.size() && bytes != steps.size()*steps[0].size()*sizeof(steps[0][0]))
+      THROW_RUNTIME_ERROR("time steps have different number of elements");
+
+    const size_t ofs = bytes ? beginArray() : 0;
+    for (const auto& step : steps)
+      file.write((const char*)step.data(),step.size()*sizeof(step[0]));
+    endArray(ofs,bytes,steps.size());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  //// Storing of nodes
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint32_t EBSWriter::storeNode(EBS::NodeType type, uint32_t subtype, const BBox1f& time_range,
+                                const std::string& name, const std::vector<uint32_t>& refs, const Parms& parms, size_t firstArray)
+  {
+    /* the type specific arrays got already stored, move them behind the name, refs, and parms arrays */
+    std::vector<EBS::Array> data(arrays.begin()+firstArray,arrays.end());
+    arrays.resize(firstArray);
+    storeArray(name.data(),name.size());
+    storeArray(refs);
+    storeArray(parms.data);
+    arrays.insert(arrays.end(),data.begin(),data.end());
+
+    if (nodes.size() >= size_t(EBS::INVALID_NODE))
+      THROW_RUNTIME_ERROR("too many nodes");
+
+    EBS::Node node;
+    node.type = type;
+    node.subtype = subtype;
+    node.time_lower = time_range.lower;
+    node.time_upper = time_range.upper;
+    node.firstArray = firstArray;
+    node.numArrays = (uint32_t) (arrays.size()-firstArray);
+    node.reserved = 0;
+    nodes.push_back(node);
+    return (uint32_t) (nodes.size()-1);
+  }
+
+  uint32_t EBSWriter::store(const std::shared_ptr<Texture>& texture)
+  {
+    if (texture == nullptr) return EBS::INVALID_NODE;
+    if (textureMap.find(texture) != textureMap.end()) return textureMap[texture];
+
+    Parms parms;
+    parms << uint32_t(texture->width) << uint32_t(texture->height);
+
+    const size_t firstArray = arrays.size();
+    storeArray(texture->data,size_t(texture->width)*size_t(texture->height)*texture->bytesPerTexel);
+    return textureMap[texture] = storeNode(EBS::NODE_TEXTURE,texture->format,BBox1f(0.0f,1.0f),texture->fileName,{},parms,firstArray);
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::MaterialNode> mnode)
+  {
+    if (!mnode) return EBS::INVALID_NODE;
+    Ref<SceneGraph::Node> node = mnode.dynamicCast<SceneGraph::Node>();
+    if (nodeMap.find(node) != nodeMap.end()) return nodeMap[node];
+
+    const MaterialType type = (MaterialType) mnode->material()->type;
+    std::vector<uint32_t> refs;
+    Parms parms;
+
+    if (Ref<OBJMaterial> m = mnode.dynamicCast<OBJMaterial>())
+    {
+      refs.push_back(store(m->_map_d));
+      refs.push_back(store(m->_map_Ka));
+      refs.push_back(store(m->_map_Kd));
+      refs.push_back(store(m->_map_Ks));
+      refs.push_back(store(m->_map_Kt));
+      refs.push_back(store(m->_map_Ns));
+      refs.push_back(store(m->_map_Displ));
+      parms << m->illum << m->d << m->Ns << m->Ni << m->Ka << m->Kd << m->Ks << m->Kt;
+    }
+    else if (Ref<ThinDielectricMaterial> m = mnode.dynamicCast<ThinDielectricMaterial>())
+      parms << m->transmission << m->eta << m->thickness;
+    else if (Ref<MetalMaterial> m = mnode.dynamicCast<MetalMaterial>())
+      parms << m->reflectance << m->eta << m->k << m->roughness;
+    else if (Ref<VelvetMaterial> m = mnode.dynamicCast<VelvetMaterial>())
+      parms << m->reflectance << m->backScattering << m->horizonScatteringColor << m->horizonScatteringFallOff;
+    else if (Ref<DielectricMaterial> m = mnode.dynamicCast<DielectricMaterial>())
+      parms << m->transmissionOutside << m->transmissionInside << m->etaOutside << m->etaInside;
+    else if (Ref<MetallicPaintMaterial> m = mnode.dynamicCast<MetallicPaintMaterial>())
+      parms << m->shadeColor << m->glitterColor << m->glitterSpread << m->eta;
+    else if (Ref<MatteMaterial> m = mnode.dynamicCast<MatteMaterial>())
+      parms << m->reflectance;
+    else if (Ref<MirrorMaterial> m = mnode.dynamicCast<MirrorMaterial>())
+      parms << m->reflectance;
+    else if (Ref<HairMaterial> m = mnode.dynamicCast<HairMaterial>())
+      parms << m->Kr << m->Kt << m->nx << m->ny;
+    else
+      THROW_RUNTIME_ERROR("unsupported material");
+
+    return nodeMap[node] = storeNode(EBS::NODE_MATERIAL,type,BBox1f(0.0f,1.0f),mnode->name,refs,parms,arrays.size());
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::LightNode> node)
+  {
+    Parms parms;
+    if (auto light = node.dynamicCast<SceneGraph::LightNodeImpl<SceneGraph::AmbientLight>>())
+      parms << light->light.L;
+    else if (auto light = node.dynamicCast<SceneGraph::LightNodeImpl<SceneGraph::PointLight>>())
+      parms << light->light.P << light->light.I;
+    else if (auto light = node.dynamicCast<SceneGraph::LightNodeImpl<SceneGraph::DirectionalLight>>())
+      parms << light->light.D << light->light.E;
+    else if (auto light = node.dynamicCast<SceneGraph::LightNodeImpl<SceneGraph::SpotLight>>())
+      parms << light->light.P << light->light.D << light->light.I << light->light.angleMin << light->light.angleMax;
+    else if (auto light = node.dynamicCast<SceneGraph::LightNodeImpl<SceneGraph::DistantLight>>())
+      parms << light->light.D << light->light.L << light->light.halfAngle;
+    else if (auto light = node.dynamicCast<SceneGraph::LightNodeImpl<SceneGraph::TriangleLight>>())
+      parms << light->light.v0 << light->light.v1 << light->light.v2 << light->light.L;
+    else if (auto light = node.dynamicCast<SceneGraph::LightNodeImpl<SceneGraph::QuadLight>>())
+      parms << light->light.v0 << light->light.v1 << light->light.v2 << light->light.v3 << light->light.L;
+    else
+      THROW_RUNTIME_ERROR("unsupported light");
+
+    return storeNode(EBS::NODE_LIGHT,node->getType(),BBox1f(0.0f,1.0f),node->name,{},parms,arrays.size());
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::TriangleMeshNode> mesh)
+  {
+    const std::vector<uint32_t> refs = { store(mesh->material) };
+    const size_t firstArray = arrays.size();
+    storeTimeSteps(mesh->positions);
+    storeTimeSteps(mesh->normals);
+    storeArray(mesh->texcoords);
+    storeArray(mesh->triangles);
+    return storeNode(EBS::NODE_TRIANGLE_MESH,0,mesh->time_range,mesh->name,refs,Parms(),firstArray);
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::QuadMeshNode> mesh)
+  {
+    const std::vector<uint32_t> refs = { store(mesh->material) };
+    const size_t firstArray = arrays.size();
+    storeTimeSteps(mesh->positions);
+    storeTimeSteps(mesh->normals);
+    storeArray(mesh->texcoords);
+    storeArray(mesh->quads);
+    return storeNode(EBS::NODE_QUAD_MESH,0,mesh->time_range,mesh->name,refs,Parms(),firstArray);
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::GridMeshNode> mesh)
+  {
+    const std::vector<uint32_t> refs = { store(mesh->material) };
+    const size_t firstArray = arrays.size();
+    storeTimeSteps(mesh->positions);
+    storeArray(mesh->grids);
+    return storeNode(EBS::NODE_GRID_MESH,0,mesh->time_range,mesh->name,refs,Parms(),firstArray);
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::SubdivMeshNode> mesh)
+  {
+    const std::vector<uint32_t> refs = { store(mesh->material) };
+    Parms parms;
+    parms << uint32_t(mesh->position_subdiv_mode) << uint32_t(mesh->normal_subdiv_mode) << uint32_t(mesh->texcoord_subdiv_mode) << mesh->tessellationRate;
+
+    const size_t firstArray = arrays.size();
+    storeTimeSteps(mesh->positions);
+    storeTimeSteps(mesh->normals);
+    storeArray(mesh->texcoords);
+    storeArray(mesh->position_indices);
+    storeArray(mesh->normal_indices);
+    storeArray(mesh->texcoord_indices);
+    storeArray(mesh->verticesPerFace);
+    storeArray(mesh->holes);
+    storeArray(mesh->edge_creases);
+    storeArray(mesh->edge_crease_weights);
+    storeArray(mesh->vertex_creases);
+    storeArray(mesh->vertex_crease_weights);
+    return storeNode(EBS::NODE_SUBDIV_MESH,0,mesh->time_range,mesh->name,refs,parms,firstArray);
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::HairSetNode> mesh)
+  {
+    const std::vector<uint32_t> refs = { store(mesh->material) };
+    Parms parms;
+    parms << mesh->tessellation_rate;
+
+    const size_t firstArray = arrays.size();
+    storeTimeSteps(mesh->positions);
+    storeTimeSteps(mesh->normals);
+    storeTimeSteps(mesh->tangents);
+    storeTimeSteps(mesh->dnormals);
+    storeArray(mesh->hairs);
+    storeArray(mesh->flags);
+    return storeNode(EBS::NODE_CURVES,mesh->type,mesh->time_range,mesh->name,refs,parms,firstArray);
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::PointSetNode> mesh)
+  {
+    const std::vector<uint32_t> refs = { store(mesh->material) };
+    const size_t firstArray = arrays.size();
+    storeTimeSteps(mesh->positions);
+    storeTimeSteps(mesh->normals);
+    return storeNode(EBS::NODE_POINTS,mesh->type,mesh->time_range,mesh->name,refs,Parms(),firstArray);
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::PerspectiveCameraNode> camera)
+  {
+    Parms parms;
+    parms << camera->data.from << camera->data.to << camera->data.up << camera->data.fov;
+    return storeNode(EBS::NODE_CAMERA,0,BBox1f(0.0f,1.0f),camera->name,{},parms,arrays.size());
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::AnimatedPerspectiveCameraNode> camera)
+  {
+    std::vector<uint32_t> refs;
+    for (auto& c : camera->cameras)
+      refs.push_back(store(c.dynamicCast<SceneGraph::Node>()));
+    return storeNode(EBS::NODE_ANIMATED_CAMERA,0,camera->time_range,camera->name,refs,Parms(),arrays.size());
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::AnimatedLightNode> light)
+  {
+    std::vector<uint32_t> refs;
+    for (auto& l : light->lights)
+      refs.push_back(store(l.dynamicCast<SceneGraph::Node>()));
+    return storeNode(EBS::NODE_ANIMATED_LIGHT,0,light->time_range,light->name,refs,Parms(),arrays.size());
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::TransformNode> node)
+  {
+    const std::vector<uint32_t> refs = { store(node->child) };
+    const size_t firstArray = arrays.size();
+    storeArray(node->spaces.spaces);
+    return storeNode(EBS::NODE_TRANSFORM,node->spaces.quaternion,node->spaces.time_range,node->name,refs,Parms(),firstArray);
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::MultiTransformNode> node)
+  {
+    const std::vector<uint32_t> refs = { store(node->child) };
+
+    std::vector<EBS::Instance> instances(node->spaces.size());
+    for (size_t i=0; i<node->spaces.size(); i++) {
+      instances[i].time_lower = node->spaces[i].time_range.lower;
+      instances[i].time_upper = node->spaces[i].time_range.upper;
+      instances[i].numTimeSteps = (uint32_t) node->spaces[i].size();
+      instances[i].quaternion = node->spaces[i].quaternion;
+    }
+
+    /* transformations of all instances are stored into a single array */
+    size_t bytes = 0;
+    for (auto& spaces : node->spaces) bytes += spaces.size()*sizeof(AffineSpace3ff);
+
+    const size_t firstArray = arrays.size();
+    storeArray(instances);
+    const size_t ofs = bytes ? beginArray() : 0;
+    for (auto& spaces : node->spaces)
+      file.write((const char*)spaces.spaces.data(),spaces.size()*sizeof(AffineSpace3ff));
+    endArray(ofs,bytes,1);
+    return storeNode(EBS::NODE_MULTI_TRANSFORM,0,BBox1f(0.0f,1.0f),node->name,refs,Parms(),firstArray);
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::GroupNode> group)
+  {
+    std::vector<uint32_t> refs;
+    for (auto& child : group->children)
+      refs.push_back(store(child));
+    return storeNode(EBS::NODE_GROUP,0,BBox1f(0.0f,1.0f),group->name,refs,Parms(),arrays.size());
+  }
+
+  uint32_t EBSWriter::store(Ref<SceneGraph::Node> node)
+  {
+    if (nodeMap.find(node) != nodeMap.end())
+      return nodeMap[node];
+
+    uint32_t id = EBS::INVALID_NODE;
+    if      (Ref<SceneGraph::AnimatedLightNode> cnode = node.dynamicCast<SceneGraph::AnimatedLightNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::LightNode> cnode = node.dynamicCast<SceneGraph::LightNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::MaterialNode> cnode = node.dynamicCast<SceneGraph::MaterialNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::TriangleMeshNode> cnode = node.dynamicCast<SceneGraph::TriangleMeshNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::QuadMeshNode> cnode = node.dynamicCast<SceneGraph::QuadMeshNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::GridMeshNode> cnode = node.dynamicCast<SceneGraph::GridMeshNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::SubdivMeshNode> cnode = node.dynamicCast<SceneGraph::SubdivMeshNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::HairSetNode> cnode = node.dynamicCast<SceneGraph::HairSetNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::PointSetNode> cnode = node.dynamicCast<SceneGraph::PointSetNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::AnimatedPerspectiveCameraNode> cnode = node.dynamicCast<SceneGraph::AnimatedPerspectiveCameraNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::PerspectiveCameraNode> cnode = node.dynamicCast<SceneGraph::PerspectiveCameraNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::TransformNode> cnode = node.dynamicCast<SceneGraph::TransformNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::MultiTransformNode> cnode = node.dynamicCast<SceneGraph::MultiTransformNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::GroupNode> cnode = node.dynamicCast<SceneGraph::GroupNode>()) id = store(cnode);
+    else THROW_RUNTIME_ERROR("unknown node type");
+
+    return nodeMap[node] = id;
+  }
+
+  EBSWriter::EBSWriter(Ref<SceneGraph::Node> root, const FileName& fileName)
+  {
+    file.exceptions (std::fstream::failbit | std::fstream::badbit);
+    file.open (fileName, std::fstream::out | std::fstream::binary);
+
+    /* header gets written last when all offsets are known */
+    EBS::Header header;
+    memset(&header,0,sizeof(header));
+    file.write((const char*)&header,sizeof(header));
+
+    store(root);
+
+    header.magic = EBS::MAGIC;
+    header.version = EBS::VERSION;
+    header.arrayTableOfs = beginArray();
+    header.numArrays = arrays.size();
+    file.write((const char*)arrays.data(),arrays.size()*sizeof(EBS::Array));
+    header.nodeTableOfs = beginArray();
+    header.numNodes = nodes.size();
+    file.write((const char*)nodes.data(),nodes.size()*sizeof(EBS::Node));
+    header.fileSize = (uint64_t) file.tellp();
+
+    file.seekp(0);
+    file.write((const char*)&header,sizeof(header));
+  }
+
+  void SceneGraph::storeEBS(Ref<SceneGraph::Node> root, const FileName& fileName) {
+    EBSWriter(root,fileName);
+  }
+}
@@ -3,6 +3,9 @@
 
 #include "obj_loader.h"
 #include "texture.h"
+#include "../../../common/sys/mapped_file.h"
+#include "../../../common/algorithms/parallel_for.h"
+#include "../../../common/algorithms/parallel_prefix_sum.h"
 
 namespace embree
 {
@@ -99,6 +102,85 @@ namespace embree
     return Vec3fa(x,y,z);
   }
 
+  /*! Copies the next line into the buffer, joins lines continued with a backslash, and returns the trimmed line. */
+  static inline const char* getLine(const char*& ptr, const char* end, std::string& line)
+  {
+    const char* eol = (const char*) memchr(ptr,'\n',end-ptr);
+    if (!eol) eol = end;
+    line.assign(ptr,eol);
+    ptr = eol < end ? eol+1 : end;
+
+    while (!line.empty() && line[line.size()-1] == '\\') {
+      line[line.size()-1] = ' ';
+      if (ptr >= end) break;
+      eol = (const char*) memchr(ptr,'\n',end-ptr);
+      if (!eol) eol = end;
+      const char* next = ptr;
+      ptr = eol < end ? eol+1 : end;
+      if (next == eol) break;
+      line.append(next,eol);
+    }
+    return trimEnd(line.c_str() + strspn(line.c_str(), " \t"));
+  }
+
+  /*! Returns the start of the first line at or after ptr that does not continue the previous line. */
+  static inline const char* findLineStart(const char* begin, const char* ptr, const char* end)
+  {
+    if (ptr <= begin) return begin;
+    for (const char* p = ptr-1; p < end; p++)
+    {
+      p = (const char*) memchr(p,'\n',end-p);
+      if (!p) break;
+      if (p == begin || p[-1] != '\\') return p+1;
+    }
+    return end;
+  }
+
+  /*! Number of positions, normals, and texture coordinates. */
+  struct OBJCounts
+  {
+    OBJCounts () : v(0), vn(0), vt(0) {}
+    OBJCounts (size_t v, size_t vn, size_t vt) : v(v), vn(vn), vt(vt) {}
+
+    friend __forceinline OBJCounts operator+ (const OBJCounts& a, const OBJCounts& b) {
+      return OBJCounts(a.v+b.v, a.vn+b.vn, a.vt+b.vt);
+    }
+
+    size_t v, vn, vt;
+  };
+
+  /*! Part of an OBJ file that gets parsed by one task. */
+  struct OBJChunk
+  {
+    /*! Statement that has to get executed in file order. */
+    struct Command
+    {
+      enum Type { USEMTL, MTLLIB, HAIR, CREASE };
+
+      Command (Type type, size_t numFaces)
+        : type(type), numFaces(numFaces) {}
+
+      Type type;
+      size_t numFaces;        //!< number of faces of the chunk preceding the command
+      std::string name;       //!< material or material library name
+      avector<Vec3ff> hair;
+      Crease crease;
+    };
+
+    const char* begin;
+    const char* end;
+    OBJCounts counts;         //!< number of vertex attributes in the chunk
+    OBJCounts base;           //!< number of vertex attributes before the chunk
+    std::vector<Vertex> faceVertices;
+    std::vector<unsigned int> faceSizes;
+    std::vector<Command> commands;
+  };
+
+  /*! handles relative indices and starts indexing from 0 */
+  static inline unsigned int fix(int index, size_t size) {
+    return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) size + index));
+  }
+
   class OBJLoader
   {
   public:
@@ -123,7 +205,8 @@ namespace embree
     std::vector<Vec2f> vt;
     std::vector<Crease> ec;
 
-    std::vector<std::vector<Vertex> > curGroup;
+    std::vector<Vertex> curGroupVertices;
+    std::vector<unsigned int> curGroupFaceSizes;
     std::vector<avector<Vec3ff> > curGroupHair;
 
     /*! Material handling. */
@@ -134,13 +217,13 @@ namespace embree
 
   private:
     void loadMTL(const FileName& fileName);
-    unsigned int fix_v (int index);
-    unsigned int fix_vt(int index);
-    unsigned int fix_vn(int index);
+    void countChunk(OBJChunk& chunk);
+    void parseChunk(OBJChunk& chunk);
+    void addFaces(const OBJChunk& chunk, size_t& face, size_t& vertex, size_t numFaces);
     void flushFaceGroup();
     void flushTriGroup();
     void flushHairGroup();
-    Vertex getUInt3(const char*& token);
+    Vertex getUInt3(const char*& token, const OBJCounts& counts);
     uint32_t getVertex(std::map<Vertex,uint32_t>& vertexMap, Ref<SceneGraph::TriangleMeshNode> mesh, const Vertex& i);
     std::shared_ptr<Texture> loadTexture(const FileName& fname);
   };
@@ -148,10 +231,9 @@ namespace embree
   OBJLoader::OBJLoader(const FileName &fileName, const bool subdivMode, const bool combineIntoSingleObject) 
     : group(new SceneGraph::GroupNode), path(fileName.path()), subdivMode(subdivMode)
   {
-    /* open file */
-    std::ifstream cin;
-    cin.open(fileName.c_str());
-    if (!cin.is_open()) {
+    /* map file */
+    MappedFile file;
+    if (!file.open(fileName)) {
       THROW_RUNTIME_ERROR("cannot open " + fileName.str());
       return;
     }
@@ -161,45 +243,116 @@ namespace embree
     curMaterialName = "default";
     curMaterial = defaultMaterial;
 
-    while (cin.peek() != -1)
+    /* split file into chunks at line boundaries */
+    const size_t chunkSize = 4*1024*1024;
+    const char* const begin = file.data();
+    const char* const end = begin + file.size();
+    const size_t numChunks = (file.size()+chunkSize-1)/chunkSize;
+    std::vector<OBJChunk> chunks(numChunks);
+    for (size_t i=0; i<numChunks; i++) {
+      chunks[i].begin = i == 0 ? begin : chunks[i-1].end;
+      chunks[i].end = findLineStart(chunks[i].begin, begin+std::min((i+1)*chunkSize,file.size()), end);
+    }
+    file.prefetch(0,file.size());
+
+    /* count vertex attributes of each chunk and calculate where each chunk stores them */
+    parallel_for(numChunks, [&] (size_t i) { countChunk(chunks[i]); });
+
+    std::vector<OBJCounts> counts(numChunks), offsets(numChunks);
+    for (size_t i=0; i<numChunks; i++) counts[i] = chunks[i].counts;
+    const OBJCounts total = parallel_prefix_sum(counts, offsets, numChunks, OBJCounts(), std::plus<OBJCounts>());
+    for (size_t i=0; i<numChunks; i++) chunks[i].base = offsets[i];
+
+    /* parse all chunks in parallel, vertex attributes are stored directly in place */
+    v.resize(total.v);
+    vn.resize(total.vn);
+    vt.resize(total.vt);
+    parallel_for(numChunks, [&] (size_t i) { parseChunk(chunks[i]); });
+
+    /* merge faces and execute commands in file order */
+    for (size_t i=0; i<numChunks; i++)
     {
-      /* load next multiline */
-      std::string line; std::getline(cin,line);
-      while (!line.empty() && line[line.size()-1] == '\\') {
-	line[line.size()-1] = ' ';
-	std::string next_line; std::getline(cin,next_line);
-	if (next_line.empty()) break;
-	line += next_line;
+      OBJChunk& chunk = chunks[i];
+      size_t face = 0, vertex = 0;
+      for (const OBJChunk::Command& command : chunk.commands)
+      {
+        addFaces(chunk, face, vertex, command.numFaces);
+        switch (command.type)
+        {
+        case OBJChunk::Command::USEMTL:
+          if (!combineIntoSingleObject) flushFaceGroup();
+          if (material.find(command.name) == material.end()) {
+            curMaterial = defaultMaterial;
+            curMaterialName = "default";
+          }
+          else {
+            curMaterial = material[command.name];
+            curMaterialName = command.name;
+          }
+          break;
+        case OBJChunk::Command::MTLLIB: loadMTL(path + command.name); break;
+        case OBJChunk::Command::HAIR  : curGroupHair.push_back(command.hair); break;
+        case OBJChunk::Command::CREASE: ec.push_back(command.crease); break;
+        }
       }
-      const char* token = trimEnd(line.c_str() + strspn(line.c_str(), " \t"));
+      addFaces(chunk, face, vertex, chunk.faceSizes.size());
+
+      /* release memory of the chunk early */
+      chunk = OBJChunk();
+    }
+    flushFaceGroup();
+  }
+
+  void OBJLoader::countChunk(OBJChunk& chunk)
+  {
+    std::string line;
+    for (const char* ptr = chunk.begin; ptr < chunk.end; )
+    {
+      const char* token = getLine(ptr,chunk.end,line);
+      if (token[0] != 'v') continue;
+      if (isSep(token[1])) chunk.counts.v++;
+      else if (token[1] == 'n' && isSep(token[2])) chunk.counts.vn++;
+      else if (token[1] == 't' && isSep(token[2])) chunk.counts.vt++;
+    }
+  }
+
+  void OBJLoader::parseChunk(OBJChunk& chunk)
+  {
+    /* number of vertex attributes parsed so far, to resolve relative indices */
+    OBJCounts cur = chunk.base;
+
+    std::string line;
+    for (const char* ptr = chunk.begin; ptr < chunk.end; )
+    {
+      const char* token = getLine(ptr,chunk.end,line);
       if (token[0] == 0) continue;
 
       /*! parse position */
       if (token[0] == 'v' && isSep(token[1])) { 
-        v.push_back(getVec3f(token += 2)); continue;
+        v[cur.v++] = getVec3f(token += 2); continue;
       }
 
       /* parse normal */
       if (token[0] == 'v' && token[1] == 'n' && isSep(token[2])) { 
-        vn.push_back(getVec3f(token += 3)); 
+        vn[cur.vn++] = getVec3f(token += 3); 
         continue; 
       }
 
       /* parse texcoord */
-      if (token[0] == 'v' && token[1] == 't' && isSep(token[2])) { vt.push_back(getVec2f(token += 3)); continue; }
+      if (token[0] == 'v' && token[1] == 't' && isSep(token[2])) { vt[cur.vt++] = getVec2f(token += 3); continue; }
 
       /*! parse face */
       if (token[0] == 'f' && isSep(token[1]))
       {
         parseSep(token += 1);
 
-        std::vector<Vertex> face;
+        unsigned int numVertices = 0;
         while (token[0]) {
-	  Vertex vtx = getUInt3(token);
-          face.push_back(vtx);
+          chunk.faceVertices.push_back(getUInt3(token,cur));
+          numVertices++;
           parseSepOpt(token);
         }
-        curGroup.push_back(face);
+        chunk.faceSizes.push_back(numVertices);
         continue;
       }
 
@@ -230,7 +383,9 @@ namespace embree
           hair[3*i+0].w = r;
           if (i != N) hair[3*i+1].w = r;
         }
-        curGroupHair.push_back(hair);
+        chunk.commands.push_back(OBJChunk::Command(OBJChunk::Command::HAIR,chunk.faceSizes.size()));
+        chunk.commands.back().hair = std::move(hair);
+        continue;
       }
       
       /*! parse edge crease */
@@ -239,41 +394,45 @@ namespace embree
 	parseSep(token += 2);
 	float w = getFloat(token);
 	parseSepOpt(token);
-	unsigned int a = fix_v(getInt(token));
+	unsigned int a = fix(getInt(token),cur.v);
 	parseSepOpt(token);
-	unsigned int b = fix_v(getInt(token));
+	unsigned int b = fix(getInt(token),cur.v);
 	parseSepOpt(token);
-	ec.push_back(Crease(w, a, b));
+        chunk.commands.push_back(OBJChunk::Command(OBJChunk::Command::CREASE,chunk.faceSizes.size()));
+        chunk.commands.back().crease = Crease(w, a, b);
 	continue;
       }
 
       /*! use material */
       if (!strncmp(token, "usemtl", 6) && isSep(token[6]))
       {
-        if (!combineIntoSingleObject) flushFaceGroup();
-        std::string name(parseSep(token += 6));
-        if (material.find(name) == material.end()) {
-          curMaterial = defaultMaterial;
-          curMaterialName = "default";
-        }
-        else {
-          curMaterial = material[name];
-          curMaterialName = name;
-        }
+        chunk.commands.push_back(OBJChunk::Command(OBJChunk::Command::USEMTL,chunk.faceSizes.size()));
+        chunk.commands.back().name = parseSep(token += 6);
         continue;
       }
 
       /* load material library */
       if (!strncmp(token, "mtllib", 6) && isSep(token[6])) {
-        loadMTL(path + std::string(parseSep(token += 6)));
+        chunk.commands.push_back(OBJChunk::Command(OBJChunk::Command::MTLLIB,chunk.faceSizes.size()));
+        chunk.commands.back().name = parseSep(token += 6);
         continue;
       }
 
       // ignore unknown stuff
     }
-    flushFaceGroup();
+  }
 
-    cin.close();
+  /*! appends the faces of the chunk up to the specified face to the current group */
+  void OBJLoader::addFaces(const OBJChunk& chunk, size_t& face, size_t& vertex, size_t numFaces)
+  {
+    size_t numVertices = 0;
+    for (size_t i=face; i<numFaces; i++)
+      numVertices += chunk.faceSizes[i];
+
+    curGroupFaceSizes.insert(curGroupFaceSizes.end(), chunk.faceSizes.begin()+face, chunk.faceSizes.begin()+numFaces);
+    curGroupVertices.insert(curGroupVertices.end(), chunk.faceVertices.begin()+vertex, chunk.faceVertices.begin()+vertex+numVertices);
+    face = numFaces;
+    vertex += numVertices;
   }
 
   struct ExtObjMaterial
@@ -488,17 +647,12 @@ namespace embree
     cin.close();
   }
 
-  /*! handles relative indices and starts indexing from 0 */
-  unsigned int OBJLoader::fix_v (int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) v .size() + index)); }
-  unsigned int OBJLoader::fix_vt(int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) vt.size() + index)); }
-  unsigned int OBJLoader::fix_vn(int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) vn.size() + index)); }
-
   /*! Parse differently formatted triplets like: n0, n0/n1/n2, n0//n2, n0/n1.          */
   /*! All indices are converted to C-style (from 0). Missing entries are assigned -1. */
-  Vertex OBJLoader::getUInt3(const char*& token)
+  Vertex OBJLoader::getUInt3(const char*& token, const OBJCounts& counts)
   {
     Vertex v(-1);
-    v.v = fix_v(atoi(token));
+    v.v = fix(atoi(token),counts.v);
     token += strcspn(token, "/ \t\r");
     if (token[0] != '/') return(v);
     token++;
@@ -506,19 +660,19 @@ namespace embree
     // it is i//n
     if (token[0] == '/') {
       token++;
-      v.vn = fix_vn(atoi(token));
+      v.vn = fix(atoi(token),counts.vn);
       token += strcspn(token, " \t\r");
       return(v);
     }
 
     // it is i/t/n or i/t
-    v.vt = fix_vt(atoi(token));
+    v.vt = fix(atoi(token),counts.vt);
     token += strcspn(token, "/ \t\r");
     if (token[0] != '/') return(v);
     token++;
 
     // it is i/t/n
-    v.vn = fix_vn(atoi(token));
+    v.vn = fix(atoi(token),counts.vn);
     token += strcspn(token, " \t\r");
     return(v);
   }
@@ -555,7 +709,7 @@ namespace embree
   /*! end current facegroup and append to mesh */
   void OBJLoader::flushTriGroup()
   {
-    if (curGroup.empty()) return;
+    if (curGroupFaceSizes.empty()) return;
 
     if (subdivMode)
     {
@@ -573,11 +727,11 @@ namespace embree
         mesh->edge_crease_weights.push_back(ec[i].w);
       }
       
-      for (size_t j=0; j<curGroup.size(); j++)
+      for (size_t j=0, ofs=0; j<curGroupFaceSizes.size(); ofs+=curGroupFaceSizes[j++])
       {
-        const std::vector<Vertex>& face = curGroup[j];
-        mesh->verticesPerFace.push_back(int(face.size()));
-        for (size_t i=0; i<face.size(); i++)
+        const Vertex* face = &curGroupVertices[ofs];
+        mesh->verticesPerFace.push_back(int(curGroupFaceSizes[j]));
+        for (size_t i=0; i<curGroupFaceSizes[j]; i++)
           mesh->position_indices.push_back(face[i].v);
       }
       if (mesh->normals[0].size() == 0)
@@ -591,14 +745,16 @@ namespace embree
       group->add(mesh.cast<SceneGraph::Node>());
       // merge three indices into one
       std::map<Vertex, uint32_t> vertexMap;
-      for (size_t j=0; j<curGroup.size(); j++)
+      for (size_t j=0, ofs=0; j<curGroupFaceSizes.size(); ofs+=curGroupFaceSizes[j++])
       {
         /* iterate over all faces */
-        const std::vector<Vertex>& face = curGroup[j];
+        const Vertex* face = &curGroupVertices[ofs];
+        const size_t faceSize = curGroupFaceSizes[j];
+        if (faceSize < 3) continue;
         
         /* triangulate the face with a triangle fan */
         Vertex i0 = face[0], i1 = Vertex(-1), i2 = face[1];
-        for (size_t k=2; k < face.size(); k++) 
+        for (size_t k=2; k < faceSize; k++) 
         {
           i1 = i2; i2 = face[k];
           uint32_t v0,v1,v2;
@@ -620,7 +776,8 @@ namespace embree
       mesh->verify();
     }
     
-    curGroup.clear();
+    curGroupVertices.clear();
+    curGroupFaceSizes.clear();
     ec.clear();
   }
 
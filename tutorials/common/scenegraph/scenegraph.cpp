@@ -4,9 +4,12 @@
 #include "scenegraph.h"
 #include "xml_loader.h"
 #include "xml_writer.h"
+#include "ebs_loader.h"
+#include "ebs_writer.h"
 #include "obj_loader.h"
 #include "ply_loader.h"
 #include "corona_loader.h"
+#include "../../../common/algorithms/parallel_for.h"
 
 namespace embree
 {
@@ -20,6 +23,7 @@ namespace embree
     else if (toLowerCase(filename.ext()) == std::string("ply" )) return loadPLY(filename);
     else if (toLowerCase(filename.ext()) == std::string("xml" )) return loadXML(filename);
     else if (toLowerCase(filename.ext()) == std::string("scn" )) return loadCorona(filename);
+    else if (toLowerCase(filename.ext()) == std::string("ebs" )) return loadEBS(filename);
     else throw std::runtime_error("unknown scene format: " + filename.ext());
   }
 
@@ -28,6 +32,9 @@ namespace embree
     if (toLowerCase(filename.ext()) == std::string("xml")) {
       storeXML(root,filename,embedTextures,referenceMaterials,binaryFormat);
     }
+    else if (toLowerCase(filename.ext()) == std::string("ebs")) {
+      storeEBS(root,filename);
+    }
     else
       throw std::runtime_error("unknown scene format: " + filename.ext());
   }
@@ -1289,26 +1296,82 @@ namespace embree
     return qmesh.dynamicCast<SceneGraph::Node>();
   }
 
-  Ref<SceneGraph::Node> SceneGraph::convert_triangles_to_quads(Ref<SceneGraph::Node> node, float prop)
+  /* collects all nodes of type T reachable from node, shared nodes are collected only once */
+  template<typename T>
+  static void collect_nodes(const Ref<SceneGraph::Node>& node, std::set<SceneGraph::Node*>& visited, std::vector<Ref<T>>& nodes)
   {
+    if (!visited.insert(node.ptr).second)
+      return;
+    
     if (Ref<SceneGraph::TransformNode> xfmNode = node.dynamicCast<SceneGraph::TransformNode>()) {
-      xfmNode->child = convert_triangles_to_quads(xfmNode->child,prop);
-    } 
+      collect_nodes(xfmNode->child,visited,nodes);
+    }
     else if (Ref<SceneGraph::MultiTransformNode> xfmNode = node.dynamicCast<SceneGraph::MultiTransformNode>()) {
-      xfmNode->child = convert_triangles_to_quads(xfmNode->child,prop);
+      collect_nodes(xfmNode->child,visited,nodes);
     }
-    else if (Ref<SceneGraph::GroupNode> groupNode = node.dynamicCast<SceneGraph::GroupNode>()) 
-    {
-      for (size_t i=0; i<groupNode->children.size(); i++) 
-        groupNode->children[i] = convert_triangles_to_quads(groupNode->children[i],prop);
+    else if (Ref<SceneGraph::GroupNode> groupNode = node.dynamicCast<SceneGraph::GroupNode>()) {
+      for (const auto& child : groupNode->children) collect_nodes(child,visited,nodes);
     }
-    else if (Ref<SceneGraph::TriangleMeshNode> tmesh = node.dynamicCast<SceneGraph::TriangleMeshNode>()) {
-      if (random<float>() <= prop) return convert_triangles_to_quads(tmesh);
-      else                         return node;
+    else if (Ref<T> t = node.dynamicCast<T>()) {
+      nodes.push_back(t);
+    }
+  }
+
+  /* replaces all references to nodes of the mapping inside the scene graph and returns the new root */
+  static Ref<SceneGraph::Node> replace_nodes(const Ref<SceneGraph::Node>& node, const std::map<SceneGraph::Node*,Ref<SceneGraph::Node>>& mapping, std::set<SceneGraph::Node*>& visited)
+  {
+    auto i = mapping.find(node.ptr);
+    if (i != mapping.end())
+      return i->second;
+
+    if (!visited.insert(node.ptr).second)
+      return node;
+    
+    if (Ref<SceneGraph::TransformNode> xfmNode = node.dynamicCast<SceneGraph::TransformNode>()) {
+      xfmNode->child = replace_nodes(xfmNode->child,mapping,visited);
+    }
+    else if (Ref<SceneGraph::MultiTransformNode> xfmNode = node.dynamicCast<SceneGraph::MultiTransformNode>()) {
+      xfmNode->child = replace_nodes(xfmNode->child,mapping,visited);
+    }
+    else if (Ref<SceneGraph::GroupNode> groupNode = node.dynamicCast<SceneGraph::GroupNode>()) {
+      for (auto& child : groupNode->children) child = replace_nodes(child,mapping,visited);
     }
     return node;
   }
 
+  /* converts all selected meshes of type Mesh in parallel, meshes shared by multiple parents get converted only once */
+  template<typename Mesh, typename Select, typename Convert>
+  static Ref<SceneGraph::Node> convert_meshes(Ref<SceneGraph::Node> node, const Select& select, const Convert& convert)
+  {
+    std::vector<Ref<Mesh>> meshes;
+    std::set<SceneGraph::Node*> visited;
+    collect_nodes(node,visited,meshes);
+
+    /* selection is done sequentially as it may draw random numbers */
+    std::vector<Ref<Mesh>> selected;
+    for (const auto& mesh : meshes)
+      if (select(mesh)) selected.push_back(mesh);
+
+    std::vector<Ref<SceneGraph::Node>> converted(selected.size());
+    parallel_for(selected.size(), [&] (size_t i) {
+      converted[i] = convert(selected[i]);
+    });
+
+    std::map<SceneGraph::Node*,Ref<SceneGraph::Node>> mapping;
+    for (size_t i=0; i<selected.size(); i++)
+      mapping[selected[i].ptr] = converted[i];
+    
+    visited.clear();
+    return replace_nodes(node,mapping,visited);
+  }
+
+  Ref<SceneGraph::Node> SceneGraph::convert_triangles_to_quads(Ref<SceneGraph::Node> node, float prop)
+  {
+    return convert_meshes<SceneGraph::TriangleMeshNode>(node,
+      [&] (const Ref<SceneGraph::TriangleMeshNode>&) { return random<float>() <= prop; },
+      [&] (const Ref<SceneGraph::TriangleMeshNode>& tmesh) { return convert_triangles_to_quads(tmesh); });
+  }
+
   Ref<SceneGraph::Node> SceneGraph::convert_quads_to_grids ( Ref<SceneGraph::QuadMeshNode> qmesh , const unsigned int resX, const unsigned int resY )
   {
     const size_t timeSteps = qmesh->positions.size();
@@ -1344,21 +1407,9 @@ namespace embree
 
   Ref<SceneGraph::Node> SceneGraph::convert_quads_to_grids(Ref<SceneGraph::Node> node, const unsigned int resX, const unsigned int resY )
   {
-    if (Ref<SceneGraph::TransformNode> xfmNode = node.dynamicCast<SceneGraph::TransformNode>()) {
-      xfmNode->child = convert_quads_to_grids(xfmNode->child, resX, resY);
-    } 
-    else if (Ref<SceneGraph::MultiTransformNode> xfmNode = node.dynamicCast<SceneGraph::MultiTransformNode>()) {
-      xfmNode->child = convert_quads_to_grids(xfmNode->child, resX, resY);
-    }
-    else if (Ref<SceneGraph::GroupNode> groupNode = node.dynamicCast<SceneGraph::GroupNode>()) 
-    {
-      for (size_t i=0; i<groupNode->children.size(); i++) 
-        groupNode->children[i] = convert_quads_to_grids(groupNode->children[i], resX, resY);
-    }
-    else if (Ref<SceneGraph::QuadMeshNode> qmesh = node.dynamicCast<SceneGraph::QuadMeshNode>()) {
-      return convert_quads_to_grids(qmesh, resX, resY);
-    }
-    return node;
+    return convert_meshes<SceneGraph::QuadMeshNode>(node,
+      [&] (const Ref<SceneGraph::QuadMeshNode>&) { return true; },
+      [&] (const Ref<SceneGraph::QuadMeshNode>& qmesh) { return convert_quads_to_grids(qmesh,resX,resY); });
   }
 
   Ref<SceneGraph::Node> SceneGraph::convert_grids_to_quads ( Ref<SceneGraph::GridMeshNode> gmesh )
@@ -1392,21 +1443,9 @@ namespace embree
 
   Ref<SceneGraph::Node> SceneGraph::convert_grids_to_quads(Ref<SceneGraph::Node> node)
   {
-    if (Ref<SceneGraph::TransformNode> xfmNode = node.dynamicCast<SceneGraph::TransformNode>()) {
-      xfmNode->child = convert_grids_to_quads(xfmNode->child);
-    }
-    else if (Ref<SceneGraph::MultiTransformNode> xfmNode = node.dynamicCast<SceneGraph::MultiTransformNode>()) {
-      xfmNode->child = convert_grids_to_quads(xfmNode->child);
-    }
-    else if (Ref<SceneGraph::GroupNode> groupNode = node.dynamicCast<SceneGraph::GroupNode>()) 
-    {
-      for (size_t i=0; i<groupNode->children.size(); i++) 
-        groupNode->children[i] = convert_grids_to_quads(groupNode->children[i]);
-    }
-    else if (Ref<SceneGraph::GridMeshNode> gmesh = node.dynamicCast<SceneGraph::GridMeshNode>()) {
-      return convert_grids_to_quads(gmesh);
-    }
-    return node;
+    return convert_meshes<SceneGraph::GridMeshNode>(node,
+      [&] (const Ref<SceneGraph::GridMeshNode>&) { return true; },
+      [&] (const Ref<SceneGraph::GridMeshNode>& gmesh) { return convert_grids_to_quads(gmesh); });
   }
   
   bool extend_grid(RTCGeometry geom, std::vector<bool>& visited, std::deque<unsigned int>& left, std::deque<unsigned int>& top, std::deque<unsigned int>& right)
@@ -1888,9 +1927,23 @@ namespace embree
 
   struct SceneGraphFlattener
   {
+    /* transformation of a geometry, gets recorded during traversal and executed in parallel */
+    struct GeometryJob
+    {
+      GeometryJob (std::vector<Ref<SceneGraph::Node>>* group, size_t index, const Ref<SceneGraph::Node>& node, const SceneGraph::Transformations& spaces)
+        : group(group), index(index), node(node), spaces(spaces) {}
+
+      std::vector<Ref<SceneGraph::Node>>* group;  //!< group to store the transformed geometry into
+      size_t index;                               //!< index in the group
+      Ref<SceneGraph::Node> node;                 //!< geometry to transform
+      SceneGraph::Transformations spaces;         //!< transformations to apply
+    };
+
     Ref<SceneGraph::Node> node;
     std::map<Ref<SceneGraph::Node>,Ref<SceneGraph::Node>> object_mapping;
     std::map<std::string,int> unique_id;
+    std::vector<GeometryJob> jobs;
+    std::map<Ref<SceneGraph::Node>,size_t> numReached;  //!< number of times each geometry is reached during traversal
     
     SceneGraphFlattener (Ref<SceneGraph::Node> in, SceneGraph::InstancingMode instancing)
     {
@@ -1911,10 +1964,47 @@ namespace embree
         convertLightsAndCameras(geometries,in,one);
       }
       in->resetInDegree();
+
+      /* transform all geometries in parallel, a geometry reached exactly once with identity transformation is reused instead of copied */
+      parallel_for(jobs.size(), [&] (size_t i) {
+        const GeometryJob& job = jobs[i];
+        if (numReached.find(job.node)->second == 1 && job.spaces.size() == 1 && SceneGraph::Transformations::isIdentity(job.spaces[0],job.spaces.quaternion))
+          (*job.group)[job.index] = job.node;
+        else
+          (*job.group)[job.index] = transformGeometry(job.node,job.spaces);
+      });
+      jobs.clear();
       
       node = new SceneGraph::GroupNode(geometries);
     }
 
+    static bool isGeometry(const Ref<SceneGraph::Node>& node)
+    {
+      return node.dynamicCast<SceneGraph::TriangleMeshNode>() ||
+             node.dynamicCast<SceneGraph::QuadMeshNode>() ||
+             node.dynamicCast<SceneGraph::GridMeshNode>() ||
+             node.dynamicCast<SceneGraph::SubdivMeshNode>() ||
+             node.dynamicCast<SceneGraph::HairSetNode>() ||
+             node.dynamicCast<SceneGraph::PointSetNode>();
+    }
+
+    static Ref<SceneGraph::Node> transformGeometry(const Ref<SceneGraph::Node>& node, const SceneGraph::Transformations& spaces)
+    {
+      if (Ref<SceneGraph::TriangleMeshNode> mesh = node.dynamicCast<SceneGraph::TriangleMeshNode>())
+        return new SceneGraph::TriangleMeshNode(mesh,spaces);
+      else if (Ref<SceneGraph::QuadMeshNode> mesh = node.dynamicCast<SceneGraph::QuadMeshNode>())
+        return new SceneGraph::QuadMeshNode(mesh,spaces);
+      else if (Ref<SceneGraph::GridMeshNode> mesh = node.dynamicCast<SceneGraph::GridMeshNode>())
+        return new SceneGraph::GridMeshNode(mesh,spaces);
+      else if (Ref<SceneGraph::SubdivMeshNode> mesh = node.dynamicCast<SceneGraph::SubdivMeshNode>())
+        return new SceneGraph::SubdivMeshNode(mesh,spaces);
+      else if (Ref<SceneGraph::HairSetNode> mesh = node.dynamicCast<SceneGraph::HairSetNode>())
+        return new SceneGraph::HairSetNode(mesh,spaces);
+      else if (Ref<SceneGraph::PointSetNode> mesh = node.dynamicCast<SceneGraph::PointSetNode>())
+        return new SceneGraph::PointSetNode(mesh,spaces);
+      return nullptr;
+    }
+
     std::string makeUniqueID(std::string id) 
     {
       if (id == "") id = "camera";
@@ -1988,23 +2078,11 @@ namespace embree
       else if (Ref<SceneGraph::GroupNode> groupNode = node.dynamicCast<SceneGraph::GroupNode>()) {
         for (const auto& child : groupNode->children) convertGeometries(group,child,spaces);
       }
-      else if (Ref<SceneGraph::TriangleMeshNode> mesh = node.dynamicCast<SceneGraph::TriangleMeshNode>()) {
-        group.push_back(new SceneGraph::TriangleMeshNode(mesh,spaces));
-      }
-      else if (Ref<SceneGraph::QuadMeshNode> mesh = node.dynamicCast<SceneGraph::QuadMeshNode>()) {
-        group.push_back(new SceneGraph::QuadMeshNode(mesh,spaces));
-      }
-      else if (Ref<SceneGraph::GridMeshNode> mesh = node.dynamicCast<SceneGraph::GridMeshNode>()) {
-        group.push_back(new SceneGraph::GridMeshNode(mesh,spaces));
-      }
-      else if (Ref<SceneGraph::SubdivMeshNode> mesh = node.dynamicCast<SceneGraph::SubdivMeshNode>()) {
-        group.push_back(new SceneGraph::SubdivMeshNode(mesh,spaces));
-      }
-      else if (Ref<SceneGraph::HairSetNode> mesh = node.dynamicCast<SceneGraph::HairSetNode>()) {
-        group.push_back(new SceneGraph::HairSetNode(mesh,spaces));
-      }
-      else if (Ref<SceneGraph::PointSetNode> mesh = node.dynamicCast<SceneGraph::PointSetNode>()) {
-        group.push_back(new SceneGraph::PointSetNode(mesh,spaces));
+      else if (isGeometry(node))
+      {
+        numReached[node]++;
+        jobs.push_back(GeometryJob(&group,group.size(),node,spaces));
+        group.push_back(nullptr);
       }
     }
 
@@ -2012,9 +2090,10 @@ namespace embree
     {
       if (object_mapping.find(node) == object_mapping.end())
       {
-        std::vector<Ref<SceneGraph::Node>> geometries;
-        convertGeometries(geometries,node,one);
-        object_mapping[node] = new SceneGraph::GroupNode(geometries);
+        /* geometries get transformed later directly into the children of the group */
+        Ref<SceneGraph::GroupNode> group = new SceneGraph::GroupNode;
+        convertGeometries(group->children,node,one);
+        object_mapping[node] = group.dynamicCast<SceneGraph::Node>();
       }
       
       return object_mapping[node];
@@ -2126,4 +2205,147 @@ namespace embree
   Ref<SceneGraph::GroupNode> SceneGraph::flatten(Ref<SceneGraph::GroupNode> node, SceneGraph::InstancingMode mode) {
     return flatten(node.dynamicCast<SceneGraph::Node>(),mode).dynamicCast<SceneGraph::GroupNode>();
   }
+
+  /* parameters and data arrays that define a geometry */
+  struct GeometryKey
+  {
+    GeometryKey (const Ref<SceneGraph::Node>& node)
+    {
+      if (Ref<SceneGraph::TriangleMeshNode> mesh = node.dynamicCast<SceneGraph::TriangleMeshNode>()) {
+        addParms(0,mesh->material,mesh->time_range);
+        addArrays(mesh->positions); addArrays(mesh->normals); addArray(mesh->texcoords); addArray(mesh->triangles);
+      }
+      else if (Ref<SceneGraph::QuadMeshNode> mesh = node.dynamicCast<SceneGraph::QuadMeshNode>()) {
+        addParms(1,mesh->material,mesh->time_range);
+        addArrays(mesh->positions); addArrays(mesh->normals); addArray(mesh->texcoords); addArray(mesh->quads);
+      }
+      else if (Ref<SceneGraph::GridMeshNode> mesh = node.dynamicCast<SceneGraph::GridMeshNode>()) {
+        addParms(2,mesh->material,mesh->time_range);
+        addArrays(mesh->positions); addArray(mesh->grids);
+      }
+      else if (Ref<SceneGraph::SubdivMeshNode> mesh = node.dynamicCast<SceneGraph::SubdivMeshNode>()) {
+        addParms(3,mesh->material,mesh->time_range);
+        parms.push_back(mesh->position_subdiv_mode);
+        parms.push_back(mesh->normal_subdiv_mode);
+        parms.push_back(mesh->texcoord_subdiv_mode);
+        parms.push_back(*(uint32_t*)&mesh->tessellationRate);
+        addArrays(mesh->positions); addArrays(mesh->normals); addArray(mesh->texcoords);
+        addArray(mesh->position_indices); addArray(mesh->normal_indices); addArray(mesh->texcoord_indices);
+        addArray(mesh->verticesPerFace); addArray(mesh->holes);
+        addArray(mesh->edge_creases); addArray(mesh->edge_crease_weights);
+        addArray(mesh->vertex_creases); addArray(mesh->vertex_crease_weights);
+      }
+      else if (Ref<SceneGraph::HairSetNode> mesh = node.dynamicCast<SceneGraph::HairSetNode>()) {
+        addParms(4,mesh->material,mesh->time_range);
+        parms.push_back(mesh->type);
+        parms.push_back(mesh->tessellation_rate);
+        addArrays(mesh->positions); addArrays(mesh->normals); addArrays(mesh->tangents); addArrays(mesh->dnormals);
+        addArray(mesh->hairs); addArray(mesh->flags);
+      }
+      else if (Ref<SceneGraph::PointSetNode> mesh = node.dynamicCast<SceneGraph::PointSetNode>()) {
+        addParms(5,mesh->material,mesh->time_range);
+        parms.push_back(mesh->type);
+        addArrays(mesh->positions); addArrays(mesh->normals);
+      }
+    }
+
+    void addParms(uint64_t type, const Ref<SceneGraph::MaterialNode>& material, const BBox1f& time_range)
+    {
+      parms.push_back(type);
+      parms.push_back((uint64_t)material.ptr);
+      parms.push_back(*(uint32_t*)&time_range.lower);
+      parms.push_back(*(uint32_t*)&time_range.upper);
+    }
+
+    template<typename Vector>
+    void addArray(const Vector& v) {
+      arrays.push_back(std::make_pair((const char*)v.data(),v.size()*sizeof(v[0])));
+    }
+
+    template<typename Vector>
+    void addArrays(const std::vector<Vector>& v)
+    {
+      parms.push_back(v.size());
+      for (const auto& a : v) addArray(a);
+    }
+
+    /* 64 bit FNV-1a style hash over the parameters, array sizes, and array data */
+    uint64_t hash() const
+    {
+      uint64_t h = 0xcbf29ce484222325ull;
+      auto add = [&] (uint64_t x) { h = (h ^ x) * 0x100000001b3ull; };
+
+      for (uint64_t p : parms) add(p);
+      for (const auto& a : arrays)
+      {
+        add(a.second);
+        const size_t N = a.second/8;
+        for (size_t i=0; i<N; i++) {
+          uint64_t x; memcpy(&x,a.first+8*i,8); add(x);
+        }
+        for (size_t i=8*N; i<a.second; i++)
+          add((unsigned char)a.first[i]);
+      }
+      return h;
+    }
+
+    bool operator== (const GeometryKey& other) const
+    {
+      if (parms != other.parms) return false;
+      if (arrays.size() != other.arrays.size()) return false;
+      for (size_t i=0; i<arrays.size(); i++) {
+        if (arrays[i].second != other.arrays[i].second) return false;
+        if (arrays[i].second && memcmp(arrays[i].first,other.arrays[i].first,arrays[i].second) != 0) return false;
+      }
+      return true;
+    }
+
+    std::vector<uint64_t> parms;
+    std::vector<std::pair<const char*,size_t>> arrays;
+  };
+
+  Ref<SceneGraph::Node> SceneGraph::deduplicate_geometries(Ref<SceneGraph::Node> node)
+  {
+    std::vector<Ref<SceneGraph::Node>> nodes, geometries;
+    std::set<SceneGraph::Node*> visited;
+    collect_nodes(node,visited,nodes);
+    for (const auto& n : nodes)
+      if (SceneGraphFlattener::isGeometry(n)) geometries.push_back(n);
+    
+    /* hash all geometries in parallel */
+    std::vector<uint64_t> hashes(geometries.size());
+    parallel_for(geometries.size(), [&] (size_t i) {
+      hashes[i] = GeometryKey(geometries[i]).hash();
+    });
+
+    /* geometries with the same hash are candidates for deduplication */
+    std::map<uint64_t,std::vector<size_t>> buckets;
+    for (size_t i=0; i<geometries.size(); i++)
+      buckets[hashes[i]].push_back(i);
+
+    /* map each geometry to the first identical geometry of its bucket */
+    std::vector<size_t> representative(geometries.size());
+    parallel_for(geometries.size(), [&] (size_t i)
+    {
+      representative[i] = i;
+      const std::vector<size_t>& bucket = buckets.find(hashes[i])->second;
+      if (bucket.size() == 1) return;
+      
+      const GeometryKey key(geometries[i]);
+      for (size_t j : bucket) {
+        if (j >= i) break;
+        if (GeometryKey(geometries[j]) == key) {
+          representative[i] = j;
+          break;
+        }
+      }
+    });
+
+    std::map<SceneGraph::Node*,Ref<SceneGraph::Node>> mapping;
+    for (size_t i=0; i<geometries.size(); i++)
+      if (representative[i] != i) mapping[geometries[i].ptr] = geometries[representative[i]];
+
+    visited.clear();
+    return replace_nodes(node,mapping,visited);
+  }
 }
@@ -863,20 +863,17 @@ namespace embree
 
       void triangles_to_quads(float prop = inf)
       {
-        for (size_t i=0; i<children.size(); i++)
-          children[i] = convert_triangles_to_quads(children[i],prop);
+        convert_triangles_to_quads(this,prop);
       }
 
       void quads_to_grids(unsigned int resX, unsigned int resY)
       {
-        for (size_t i=0; i<children.size(); i++)
-          children[i] = convert_quads_to_grids(children[i],resX, resY);
+        convert_quads_to_grids(this,resX,resY);
       }
 
       void grids_to_quads()
       {
-        for (size_t i=0; i<children.size(); i++)
-          children[i] = convert_grids_to_quads(children[i]);
+        convert_grids_to_quads(this);
       }
 
       void quads_to_subdivs()
@@ -1639,6 +1636,9 @@ namespace embree
     Ref<Node> flatten(Ref<Node> node, InstancingMode mode);
     Ref<GroupNode> flatten(Ref<GroupNode> node, InstancingMode mode);
 
+    /* makes all geometries with identical data reference a single geometry, which gets instanced when flattening with INSTANCING_GEOMETRY */
+    Ref<Node> deduplicate_geometries(Ref<Node> node);
+
     Statistics calculateStatistics(Ref<Node> node);
 
     enum CurveSubtype
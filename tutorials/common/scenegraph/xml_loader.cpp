@@ -4,6 +4,8 @@
 #include "xml_loader.h"
 #include "xml_parser.h"
 #include "obj_loader.h"
+#include "../../../common/sys/mapped_file.h"
+#include "../../../common/algorithms/parallel_for.h"
 
 namespace embree
 {
@@ -266,6 +268,7 @@ namespace embree
     template<typename T> T load(const Ref<XML>& xml) { assert(false); return T(zero); }
     template<typename T> T load(const Ref<XML>& xml, const T& opt) { assert(false); return T(zero); }
     template<typename Vector> Vector loadBinary(const Ref<XML>& xml);
+    void copyBinary(void* dst, size_t ofs, size_t bytes);
 
     std::vector<float> loadFloatArray(const Ref<XML>& xml);
     std::vector<Vec2f> loadVec2fArray(const Ref<XML>& xml);
@@ -283,9 +286,9 @@ namespace embree
 
   private:
     FileName path;         //!< path to XML file
-    FILE* binFile;         //!< .bin file for reading binary data
+    MappedFile binFile;    //!< memory mapped .bin file for reading binary data
     FileName binFileName;  //!< name of the .bin file
-    size_t binFileSize;
+    size_t binFileOfs;     //!< end of the last array read from the .bin file
 
   private:
     SharedState& state;
@@ -448,28 +451,52 @@ namespace embree
     return res;
   }
 
+  void XMLLoader::copyBinary(void* dst, size_t ofs, size_t bytes)
+  {
+    /* perform security check that we stay in the file */
+    if (ofs > binFile.size() || bytes > binFile.size()-ofs)
+      THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+
+    const char* src = binFile.data()+ofs;
+    binFileOfs = ofs+bytes;
+
+    /* small arrays are copied directly */
+    const size_t blockSize = 4*1024*1024;
+    if (bytes <= blockSize) {
+      if (bytes) memcpy(dst,src,bytes);
+      return;
+    }
+
+    /* large arrays are read ahead by the OS and copied in parallel to fault in pages concurrently */
+    binFile.prefetch(ofs,bytes);
+    parallel_for(size_t(0), (bytes+blockSize-1)/blockSize, [&] (const range<size_t>& r) {
+      for (size_t i=r.begin(); i<r.end(); i++) {
+        const size_t begin = i*blockSize;
+        const size_t end = std::min(begin+blockSize,bytes);
+        memcpy((char*)dst+begin,src+begin,end-begin);
+      }
+    });
+  }
+
   template<typename Vector>
   Vector XMLLoader::loadBinary(const Ref<XML>& xml)
   {
-    if (!binFile) 
+    if (!binFile.isOpen())
       THROW_RUNTIME_ERROR("cannot open file "+binFileName.str()+" for reading");
 
-    size_t ofs = atol(xml->parm("ofs").c_str());
-    fseek(binFile,long(ofs),SEEK_SET);
+    size_t ofs = strtoull(xml->parm("ofs").c_str(),nullptr,10);
 
     /* read size of array */
-    size_t size = atol(xml->parm("size").c_str());
-    if (size == 0) size = atol(xml->parm("num").c_str()); // version for BGF format
+    size_t size = strtoull(xml->parm("size").c_str(),nullptr,10);
+    if (size == 0) size = strtoull(xml->parm("num").c_str(),nullptr,10); // version for BGF format
 
-    /* perform security check that we stay in the file */
-    if (ofs + size*sizeof(typename Vector::value_type) > binFileSize)
+    /* perform security check that the size does not overflow */
+    if (size > binFile.size()/sizeof(typename Vector::value_type))
       THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
 
-    /* read data from file */
+    /* copy data from mapped file */
     Vector data(size);
-    if (size != fread(data.data(), sizeof(typename Vector::value_type), data.size(), binFile)) 
-      THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
-
+    copyBinary(data.data(), ofs, size*sizeof(typename Vector::value_type));
     return data;
   }
 
@@ -819,13 +846,15 @@ namespace embree
       const unsigned height = stoi(xml->parm("height"));
       const Texture::Format format = Texture::string_to_format(xml->parm("format"));
       const unsigned bytesPerTexel = Texture::getFormatBytesPerTexel(format);
-      if (ftell(binFile) + width*height*bytesPerTexel > (unsigned)binFileSize)
-        THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+      if (!binFile.isOpen())
+        THROW_RUNTIME_ERROR("cannot open file "+binFileName.str()+" for reading");
       
       //texture = std::make_shared<Texture>(width,height,format);
       texture = std::shared_ptr<Texture>(new Texture(width,height,format));
-      if (width*height != fread(texture->data, bytesPerTexel, width*height, binFile)) 
-        THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+
+      /* texel data is stored at the specified offset, or follows the previously read array */
+      const size_t ofs = xml->parm("ofs") != "" ? strtoull(xml->parm("ofs").c_str(),nullptr,10) : binFileOfs;
+      copyBinary(texture->data, ofs, size_t(width)*size_t(height)*size_t(bytesPerTexel));
     }
     
     if (id != "") state.textureMap[id] = texture;
@@ -1967,19 +1996,13 @@ namespace embree
   }
 
   XMLLoader::XMLLoader(const FileName& fileName, const AffineSpace3fa& space, SharedState& state)
-    : binFile(nullptr), binFileSize(0), state(state), currentNodeID(0)
+    : binFileOfs(0), state(state), currentNodeID(0)
   {
     path = fileName.path();
     binFileName = fileName.setExt(".bin");
-    binFile = fopen(binFileName.c_str(),"rb");
-    if (!binFile) {
+    if (!binFile.open(binFileName)) {
       binFileName = fileName.addExt(".bin");
-      binFile = fopen(binFileName.c_str(),"rb");
-    }
-    if (binFile) {
-      fseek(binFile, 0L, SEEK_END);
-      binFileSize = ftell(binFile);
-      fseek(binFile, 0L, SEEK_SET);
+      binFile.open(binFileName);
     }
 
 
@@ -2009,7 +2032,6 @@ namespace embree
   }
 
   XMLLoader::~XMLLoader() {
-    if (binFile) fclose(binFile);
   }
 
   /*! read from disk */
@@ -12,6 +12,8 @@
 #include <sstream>
 #include <fstream>
 #include <memory>
+#include <limits>
+#include <mutex>
 
 #include "benchmark.h"
 
@@ -101,11 +103,302 @@ void printCommandLine(int argc, char** argv)
 //////////////////////////////////////////////
 //////////////////////////////////////////////
 
+///////////////////////////////////////////
+// storage, output, and comparison of    //
+// per iteration benchmark samples       //
+///////////////////////////////////////////
+static std::mutex g_bench_results_mutex;
+static std::vector<BenchResult> g_bench_results;
+
+void BenchResults::add(const std::string& name, const std::string& metric, const std::string& unit, bool higher_is_better, const SampleStatistics& stat)
+{
+  std::lock_guard<std::mutex> lock(g_bench_results_mutex);
+  BenchResult result;
+  result.name = name;
+  result.metric = metric;
+  result.unit = unit;
+  result.higher_is_better = higher_is_better;
+  result.samples = stat.getSamples();
+  g_bench_results.push_back(result);
+}
+
+static std::string jsonString(std::string const& str)
+{
+  std::string res = "\"";
+  for (char c : str) {
+    if      (c == '"' ) res += "\\\"";
+    else if (c == '\\') res += "\\\\";
+    else if (c == '\n') res += "\\n";
+    else if (c == '\t') res += "\\t";
+    else res += c;
+  }
+  return res + "\"";
+}
+
+void BenchResults::write(const FileName& fileName, const std::string& commandLine)
+{
+  std::ofstream out(fileName.str());
+  if (!out.is_open())
+    throw std::runtime_error("cannot open file " + fileName.str());
+  out.precision(std::numeric_limits<float>::max_digits10);
+
+  std::lock_guard<std::mutex> lock(g_bench_results_mutex);
+  out << "{" << std::endl;
+  out << "  \"version\": " << jsonString(RTC_VERSION_STRING) << "," << std::endl;
+  out << "  \"command_line\": " << jsonString(commandLine) << "," << std::endl;
+  out << "  \"logical_threads\": " << getNumberOfLogicalThreads() << "," << std::endl;
+  out << "  \"benchmarks\": [";
+  for (size_t i = 0; i < g_bench_results.size(); ++i)
+  {
+    BenchResult const& r = g_bench_results[i];
+    SampleStatistics all(r.samples);
+    SampleStatistics stat = all.skipWarmup();
+    std::pair<float,float> avgCI = stat.getAvgConfidenceInterval();
+    std::pair<float,float> medianCI = stat.getMedianConfidenceInterval();
+
+    out << (i ? "," : "") << std::endl;
+    out << "    {" << std::endl;
+    out << "      \"name\": " << jsonString(r.name) << "," << std::endl;
+    out << "      \"metric\": " << jsonString(r.metric) << "," << std::endl;
+    out << "      \"unit\": " << jsonString(r.unit) << "," << std::endl;
+    out << "      \"higher_is_better\": " << (r.higher_is_better ? "true" : "false") << "," << std::endl;
+    out << "      \"iterations\": " << all.size() << "," << std::endl;
+    out << "      \"warmup\": " << all.getWarmup() << "," << std::endl;
+    out << "      \"min\": " << stat.getMin() << "," << std::endl;
+    out << "      \"max\": " << stat.getMax() << "," << std::endl;
+    out << "      \"mean\": " << stat.getAvg() << "," << std::endl;
+    out << "      \"sigma\": " << stat.getSigma() << "," << std::endl;
+    out << "      \"mean_ci95\": [" << avgCI.first << ", " << avgCI.second << "]," << std::endl;
+    out << "      \"median\": " << stat.getMedian() << "," << std::endl;
+    out << "      \"median_ci95\": [" << medianCI.first << ", " << medianCI.second << "]," << std::endl;
+    out << "      \"p5\": " << stat.getPercentile(5.0f) << "," << std::endl;
+    out << "      \"p25\": " << stat.getPercentile(25.0f) << "," << std::endl;
+    out << "      \"p75\": " << stat.getPercentile(75.0f) << "," << std::endl;
+    out << "      \"p95\": " << stat.getPercentile(95.0f) << "," << std::endl;
+    out << "      \"samples\": [";
+    for (size_t j = 0; j < r.samples.size(); ++j)
+      out << (j ? ", " : "") << r.samples[j];
+    out << "]" << std::endl;
+    out << "    }";
+  }
+  out << std::endl << "  ]" << std::endl;
+  out << "}" << std::endl;
+}
+
+/* minimal reader for the JSON files written by BenchResults::write */
+struct BenchResultsReader
+{
+  BenchResultsReader(const FileName& fileName) : fileName(fileName)
+  {
+    std::ifstream in(fileName.str());
+    if (!in.is_open())
+      throw std::runtime_error("cannot open file " + fileName.str());
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    str = buffer.str();
+  }
+
+  std::vector<BenchResult> parse()
+  {
+    std::vector<BenchResult> results;
+    expect('{');
+    if (peek() != '}') do
+    {
+      std::string key = parseString();
+      expect(':');
+      if (key != "benchmarks") {
+        skipValue();
+        continue;
+      }
+      expect('[');
+      if (peek() != ']') do {
+        results.push_back(parseResult());
+      } while (accept(','));
+      expect(']');
+    } while (accept(','));
+    expect('}');
+    return results;
+  }
+
+private:
+
+  BenchResult parseResult()
+  {
+    BenchResult result;
+    result.higher_is_better = true;
+    expect('{');
+    if (peek() != '}') do
+    {
+      std::string key = parseString();
+      expect(':');
+      if      (key == "name"            ) result.name = parseString();
+      else if (key == "metric"          ) result.metric = parseString();
+      else if (key == "unit"            ) result.unit = parseString();
+      else if (key == "higher_is_better") result.higher_is_better = parseBool();
+      else if (key == "samples") {
+        expect('[');
+        if (peek() != ']') do {
+          result.samples.push_back(float(parseNumber()));
+        } while (accept(','));
+        expect(']');
+      }
+      else skipValue();
+    } while (accept(','));
+    expect('}');
+    return result;
+  }
+
+  char peek()
+  {
+    while (pos < str.size() && isspace((unsigned char)str[pos])) pos++;
+    if (pos >= str.size()) error("unexpected end of file");
+    return str[pos];
+  }
+
+  bool accept(char c)
+  {
+    if (peek() != c) return false;
+    pos++;
+    return true;
+  }
+
+  void expect(char c)
+  {
+    if (!accept(c)) error(std::string("expected '") + c + "'");
+  }
+
+  std::string parseString()
+  {
+    expect('"');
+    std::string res;
+    while (pos < str.size() && str[pos] != '"') {
+      if (str[pos] == '\\' && pos+1 < str.size()) {
+        pos++;
+        if      (str[pos] == 'n') res += '\n';
+        else if (str[pos] == 't') res += '\t';
+        else res += str[pos];
+      }
+      else res += str[pos];
+      pos++;
+    }
+    expect('"');
+    return res;
+  }
+
+  double parseNumber()
+  {
+    peek();
+    const char* begin = str.c_str() + pos;
+    char* end = nullptr;
+    const double d = strtod(begin, &end);
+    if (end == begin) error("expected number");
+    pos += end - begin;
+    return d;
+  }
+
+  bool parseBool()
+  {
+    peek();
+    if (str.compare(pos, 4, "true") == 0) { pos += 4; return true; }
+    if (str.compare(pos, 5, "false") == 0) { pos += 5; return false; }
+    error("expected boolean");
+    return false;
+  }
+
+  void skipValue()
+  {
+    const char c = peek();
+    if (c == '"') parseString();
+    else if (c == '{' || c == '[') {
+      const char close = c == '{' ? '}' : ']';
+      pos++;
+      if (peek() != close) do {
+        if (c == '{') { parseString(); expect(':'); }
+        skipValue();
+      } while (accept(','));
+      expect(close);
+    }
+    else if (c == 't' || c == 'f') parseBool();
+    else if (str.compare(pos, 4, "null") == 0) pos += 4;
+    else parseNumber();
+  }
+
+  void error(std::string const& msg) {
+    throw std::runtime_error(fileName.str() + ": " + msg + " at offset " + std::to_string(pos));
+  }
+
+  FileName fileName;
+  std::string str;
+  size_t pos = 0;
+};
+
+std::vector<BenchResult> BenchResults::read(const FileName& fileName)
+{
+  return BenchResultsReader(fileName).parse();
+}
+
+size_t BenchResults::compare(const FileName& baseFileName, const FileName& newFileName, float threshold, float alpha)
+{
+  std::vector<BenchResult> baseResults = read(baseFileName);
+  std::vector<BenchResult> newResults = read(newFileName);
+
+  IOStreamStateRestorer cout_state(std::cout);
+  std::cout.setf(std::ios::fixed, std::ios::floatfield);
+  std::cout.precision(4);
+
+  size_t numRegressions = 0;
+  for (BenchResult const& n : newResults)
+  {
+    std::string const name = n.name + "." + n.metric;
+    auto b = std::find_if(baseResults.begin(), baseResults.end(), [&] (BenchResult const& r) {
+        return r.name == n.name && r.metric == n.metric;
+      });
+    if (b == baseResults.end()) {
+      std::cout << name << ": not found in " << baseFileName << std::endl;
+      continue;
+    }
+
+    /* compare the medians of the steady state samples */
+    SampleStatistics baseStat = SampleStatistics(b->samples).skipWarmup();
+    SampleStatistics newStat = SampleStatistics(n.samples).skipWarmup();
+    const double p = mannWhitneyU(baseStat.getSamples(), newStat.getSamples());
+    const double baseMedian = baseStat.getMedian();
+    const double newMedian = newStat.getMedian();
+    double change = 0.0;
+    if (baseMedian != 0.0) change = (newMedian-baseMedian)/baseMedian;
+    const double slowdown = n.higher_is_better ? -change : change;
+
+    std::string verdict = "[SAME]";
+    if (p < alpha) {
+      if (slowdown > threshold) verdict = "[REGRESSION]";
+      else if (slowdown < -threshold) verdict = "[IMPROVEMENT]";
+    }
+    if (verdict == "[REGRESSION]") numRegressions++;
+
+    std::cout << name << ": "
+              << baseMedian << " -> " << newMedian << " " << n.unit << " "
+              << "(" << std::showpos << 100.0*change << std::noshowpos << "%, p = " << p << ") "
+              << verdict << std::endl;
+  }
+
+  std::cout << "BENCHMARK_COMPARE_REGRESSIONS " << numRegressions << std::endl;
+  return numRegressions;
+}
+//////////////////////////////////////////////
+//////////////////////////////////////////////
+
 int TutorialBenchmark::main(int argc, char** argv, std::string name)
 {
+  std::string fullCommandLine;
+  for (int i = 0; i < argc; ++i)
+    fullCommandLine += std::string(i ? " " : "") + argv[i];
+
   commandLineParser.parseCommandLine(argc, argv);
   updateCommandLine(argc, argv);
 
+  if (compareFiles.first.str() != "")
+    return BenchResults::compare(compareFiles.first, compareFiles.second, compareThreshold, compareAlpha) ? 1 : 0;
+
   CommandLine commandLine(argc, argv);
 
 #if USE_GOOGLE_BENCHMARK
@@ -124,6 +417,8 @@ int TutorialBenchmark::main(int argc, char** argv, std::string name)
 #endif
 
   commandLine = CommandLine(argc, argv);
+  if (pinThreads)
+    commandLine.add({"--set_affinity", "1"});
 
   postParseCommandLine();
 
@@ -145,6 +440,9 @@ int TutorialBenchmark::main(int argc, char** argv, std::string name)
     ::benchmark::RunSpecifiedBenchmarks();
 #endif
 
+  if (jsonFile.str() != "")
+    BenchResults::write(jsonFile, fullCommandLine);
+
   return 0;
 }
 
@@ -184,6 +482,7 @@ void callBenchFunc(benchmark::State& state, int argc, char** argv, BenchParams b
 
 void TutorialBenchmark::registerBenchmark(std::string const& name, int argc, char** argv)
 {
+  params.name = name;
 #ifdef USE_GOOGLE_BENCHMARK
   if (params.legacy) {
     std::cout << "BENCHMARK SCENE: " << name << std::endl;
@@ -215,6 +514,7 @@ void TutorialBuildBenchmark::registerBuildBenchmark(std::string name, BuildBench
     if (attach) name += "_" + getBuildBenchTypeString(buildBenchType);
     BuildBenchParams p = buildParams;
     p.buildBenchType = buildBenchType;
+    params.name = name;
 #ifdef USE_GOOGLE_BENCHMARK
     if (params.legacy) {
       std::cout << "BENCHMARK SCENE: " << name << std::endl;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "application.h"
+#include "statistics.h"
 
 namespace benchmark
 {
@@ -70,6 +71,33 @@ struct BuildBenchParams {
   int userThreads = 0;
 };
 
+/* per iteration samples of one metric of a benchmark */
+struct BenchResult
+{
+  std::string name;       //!< name of the benchmark
+  std::string metric;     //!< name of the measured metric (e.g. fps)
+  std::string unit;       //!< unit of the samples
+  bool higher_is_better;  //!< true if larger samples are better
+  std::vector<float> samples;
+};
+
+/* collects the results of all benchmarks of a run */
+struct BenchResults
+{
+  static void add(const std::string& name, const std::string& metric, const std::string& unit, bool higher_is_better, const SampleStatistics& stat);
+
+  /* writes all results in JSON format */
+  static void write(const FileName& fileName, const std::string& commandLine);
+
+  /* reads results from a JSON file written by write */
+  static std::vector<BenchResult> read(const FileName& fileName);
+
+  /* compares the results of two runs, returns the number of
+   * statistically significant regressions of more than
+   * threshold (relative) of the median */
+  static size_t compare(const FileName& baseFileName, const FileName& newFileName, float threshold, float alpha);
+};
+
 using BenchFunc = void(*)(BenchState& state, BenchParams& params, int argc, char** argv);
 using BuildBenchFunc = void(*)(BenchState& state, BenchParams& params, BuildBenchParams& buildParams, int argc, char** argv);
 
@@ -77,7 +105,7 @@ struct TutorialBenchmark
 {
   static bool benchmark(int argc, char** argv) {
     for (int i = 0; i < argc; ++i)
-      if (std::string(argv[i]) == "--benchmark")
+      if (std::string(argv[i]) == "--benchmark" || std::string(argv[i]) == "--benchmark_compare")
         return true;
     return false;
   }
@@ -113,6 +141,27 @@ struct TutorialBenchmark
         params.name = cin->getString();
         processedCommandLineOptions.push_back("--benchmark_name");
       }, "--benchmark_name <string>: override name of the benchmark");
+    commandLineParser.registerOption("benchmark_json", [&] (Ref<ParseStream> cin, const FileName& path) {
+        jsonFile = cin->getFileName();
+        processedCommandLineOptions.push_back("--benchmark_json");
+      }, "--benchmark_json <filename>: writes per iteration samples and statistics of all benchmarks to a JSON file");
+    commandLineParser.registerOption("benchmark_pin_threads", [&] (Ref<ParseStream> cin, const FileName& path) {
+        pinThreads = true;
+        processedCommandLineOptions.push_back("--benchmark_pin_threads");
+      }, "--benchmark_pin_threads: pins the rendering and build threads to hardware threads");
+    commandLineParser.registerOption("benchmark_compare", [&] (Ref<ParseStream> cin, const FileName& path) {
+        compareFiles.first = cin->getFileName();
+        compareFiles.second = cin->getFileName();
+        processedCommandLineOptions.push_back("--benchmark_compare");
+      }, "--benchmark_compare <base.json> <new.json>: compares two JSON result files and reports statistically significant regressions");
+    commandLineParser.registerOption("benchmark_threshold", [&] (Ref<ParseStream> cin, const FileName& path) {
+        compareThreshold = cin->getFloat();
+        processedCommandLineOptions.push_back("--benchmark_threshold");
+      }, "--benchmark_threshold <float>: relative slowdown of the median to report as regression (default 0.02)");
+    commandLineParser.registerOption("benchmark_alpha", [&] (Ref<ParseStream> cin, const FileName& path) {
+        compareAlpha = cin->getFloat();
+        processedCommandLineOptions.push_back("--benchmark_alpha");
+      }, "--benchmark_alpha <float>: significance level of the regression test (default 0.05)");
   }
 
   TutorialBenchmark() : TutorialBenchmark(nullptr)
@@ -131,6 +180,11 @@ protected:
   std::string inputFile = "";
   std::vector<std::string> processedCommandLineOptions;
   BenchParams params;
+  FileName jsonFile;
+  bool pinThreads = false;
+  std::pair<FileName,FileName> compareFiles;
+  float compareThreshold = 0.02f;
+  float compareAlpha = 0.05f;
 
   virtual void registerBenchmark(std::string const& name, int argc, char** argv);
 
@@ -45,12 +45,17 @@ static void renderBenchFunc(BenchState& state, BenchParams& params ,int argc, ch
   }
 
   size_t numRays = 0;
+  SampleStatistics fpsSamples;
   for (auto _ : *state.state)
   {
     tutorial.initRayStats();
+    double t0 = getSeconds();
     tutorial.render(tutorial.pixels,tutorial.width,tutorial.height,0.0f,ispccamera);
+    double t1 = getSeconds();
+    fpsSamples.add(float(1.0/(t1-t0)));
     numRays += tutorial.getNumRays();
   }
+  BenchResults::add(params.name,"fps","1/s",true,fpsSamples);
 
   state.state->SetItemsProcessed(state.state->iterations());
   state.state->counters["Rays/s"] = benchmark::Counter(numRays, benchmark::Counter::kIsRate);
@@ -76,6 +81,8 @@ static void renderBenchmarkLegacy(BenchState& state, BenchParams& params ,int ar
   //Statistics stat;
   FilteredStatistics fpsStat(0.5f,0.0f);
   FilteredStatistics mraypsStat(0.5f,0.0f);
+  SampleStatistics fpsSamples;
+  SampleStatistics mraypsSamples;
   {
     size_t numTotalFrames = params.skipIterations + params.minTimeOrIterations;
     for (size_t i=0; i<params.skipIterations; i++)
@@ -102,9 +109,11 @@ static void renderBenchmarkLegacy(BenchState& state, BenchParams& params ,int ar
 
       float fps = float(1.0/dt);
       fpsStat.add(fps);
+      fpsSamples.add(fps);
 
       float mrayps = float(double(tutorial.getNumRays())/(1000000.0*dt));
       mraypsStat.add(mrayps);
+      mraypsSamples.add(mrayps);
 
       if (numTotalFrames >= 1024 && (i % 64 == 0))
       {
@@ -137,12 +146,22 @@ static void renderBenchmarkLegacy(BenchState& state, BenchParams& params ,int ar
   std::cout << "BENCHMARK_RENDER_SIGMA " << fpsStat.getSigma() << std::endl;
   std::cout << "BENCHMARK_RENDER_AVG_SIGMA " << fpsStat.getAvgSigma() << std::endl;
 
+  /* order statistics of the samples after the detected warm-up phase */
+  SampleStatistics fpsSteady = fpsSamples.skipWarmup();
+  std::pair<float,float> fpsMedianCI = fpsSteady.getMedianConfidenceInterval();
+  std::cout << "BENCHMARK_RENDER_WARMUP " << fpsSamples.getWarmup() << std::endl;
+  std::cout << "BENCHMARK_RENDER_MEDIAN " << fpsSteady.getMedian() << std::endl;
+  std::cout << "BENCHMARK_RENDER_MEDIAN_CI95 " << fpsMedianCI.first << " " << fpsMedianCI.second << std::endl;
+  BenchResults::add(params.name,"fps","1/s",true,fpsSamples);
+
 #if defined(RAY_STATS)
   std::cout << "BENCHMARK_RENDER_MRAYPS_MIN " << mraypsStat.getMin() << std::endl;
   std::cout << "BENCHMARK_RENDER_MRAYPS_AVG " << mraypsStat.getAvg() << std::endl;
   std::cout << "BENCHMARK_RENDER_MRAYPS_MAX " << mraypsStat.getMax() << std::endl;
   std::cout << "BENCHMARK_RENDER_MRAYPS_SIGMA " << mraypsStat.getSigma() << std::endl;
   std::cout << "BENCHMARK_RENDER_MRAYPS_AVG_SIGMA " << mraypsStat.getAvgSigma() << std::endl;
+  std::cout << "BENCHMARK_RENDER_MRAYPS_MEDIAN " << mraypsSamples.skipWarmup().getMedian() << std::endl;
+  BenchResults::add(params.name,"mrayps","Mrays/s",true,mraypsSamples);
 #endif
 
   std::cout << std::flush;
@@ -5,6 +5,7 @@
 
 #include "../default.h"
 #include <algorithm>
+#include <cmath>
 
 namespace embree
 {
@@ -85,4 +86,177 @@ namespace embree
     std::vector<float> v;
     Statistics stat;
   };
+
+  /* stores all samples to calculate order statistics, confidence
+   * intervals, and to detect the end of the warm-up phase */
+  struct SampleStatistics
+  {
+  public:
+    SampleStatistics() {}
+
+    SampleStatistics(const std::vector<float>& samples)
+      : v(samples) {}
+
+    void add(float a) {
+      v.push_back(a);
+    }
+
+    size_t size() const { return v.size(); }
+    const std::vector<float>& getSamples() const { return v; }
+
+    /* number of initial samples belonging to the warm-up phase, uses
+     * the MSER-5 truncation rule: samples are averaged in batches of
+     * 5 and the truncation point minimizes the standard error of the
+     * mean of the remaining batches */
+    size_t getWarmup() const
+    {
+      const size_t B = 5;
+      const size_t numBatches = v.size()/B;
+      if (numBatches < 2) return 0;
+
+      std::vector<double> batches(numBatches);
+      for (size_t i=0; i<numBatches; i++) {
+        double sum = 0.0;
+        for (size_t j=0; j<B; j++) sum += v[i*B+j];
+        batches[i] = sum/B;
+      }
+
+      size_t best_d = 0;
+      double best_mser = double(pos_inf);
+      for (size_t d=0; d<=numBatches/2; d++)
+      {
+        const size_t n = numBatches-d;
+        double mean = 0.0;
+        for (size_t i=d; i<numBatches; i++) mean += batches[i];
+        mean /= n;
+        double var = 0.0;
+        for (size_t i=d; i<numBatches; i++) var += sqr(batches[i]-mean);
+        const double mser = var/sqr(double(n));
+        if (mser < best_mser) { best_mser = mser; best_d = d; }
+      }
+      return best_d*B;
+    }
+
+    /* returns the samples after the warm-up phase */
+    SampleStatistics skipWarmup() const {
+      return SampleStatistics(std::vector<float>(v.begin()+getWarmup(),v.end()));
+    }
+
+    float getMin() const { return v.size() ? *std::min_element(v.begin(),v.end()) : 0.0f; }
+    float getMax() const { return v.size() ? *std::max_element(v.begin(),v.end()) : 0.0f; }
+
+    float getAvg() const
+    {
+      if (v.size() == 0) return 0.0f;
+      double sum = 0.0;
+      for (float a : v) sum += a;
+      return float(sum/v.size());
+    }
+
+    float getSigma() const // sample standard deviation
+    {
+      if (v.size() < 2) return 0.0f;
+      const double avg = getAvg();
+      double sum = 0.0;
+      for (float a : v) sum += sqr(a-avg);
+      return float(sqrt(sum/(v.size()-1)));
+    }
+
+    /* returns the p-th percentile (0 <= p <= 100) using linear interpolation */
+    float getPercentile(float p) const
+    {
+      if (v.size() == 0) return 0.0f;
+      std::vector<float> s = sorted();
+      const double x = clamp(double(p)/100.0,0.0,1.0)*(s.size()-1);
+      const size_t i = min(size_t(x),s.size()-1);
+      const size_t j = min(i+1,s.size()-1);
+      return float(s[i] + (x-i)*(s[j]-s[i]));
+    }
+
+    float getMedian() const { return getPercentile(50.0f); }
+
+    /* 95% confidence interval of the mean using Student's t-distribution */
+    std::pair<float,float> getAvgConfidenceInterval() const
+    {
+      const float avg = getAvg();
+      if (v.size() < 2) return std::make_pair(avg,avg);
+      const float d = float(t95(v.size()-1)*getSigma()/sqrt(double(v.size())));
+      return std::make_pair(avg-d,avg+d);
+    }
+
+    /* distribution free 95% confidence interval of the median using order statistics */
+    std::pair<float,float> getMedianConfidenceInterval() const
+    {
+      if (v.size() == 0) return std::make_pair(0.0f,0.0f);
+      std::vector<float> s = sorted();
+      const double n = double(s.size());
+      const double d = 1.96*sqrt(n)/2.0;
+      const ssize_t j = clamp(ssize_t(floor(n/2.0-d)),ssize_t(1),ssize_t(s.size()));
+      const ssize_t k = clamp(ssize_t(ceil(1.0+n/2.0+d)),ssize_t(1),ssize_t(s.size()));
+      return std::make_pair(s[j-1],s[k-1]);
+    }
+
+  private:
+
+    std::vector<float> sorted() const
+    {
+      std::vector<float> s = v;
+      std::sort(s.begin(),s.end());
+      return s;
+    }
+
+    /* two sided 97.5% quantile of Student's t-distribution */
+    static double t95(size_t dof)
+    {
+      static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+      if (dof == 0) return double(pos_inf);
+      if (dof <= 30) return table[dof-1];
+      if (dof <= 60) return 2.000;
+      if (dof <= 120) return 1.980;
+      return 1.960;
+    }
+
+  private:
+    std::vector<float> v; // all values
+  };
+
+  /* two sided Mann-Whitney U test, returns the probability that the
+   * samples a and b are from the same distribution, uses the normal
+   * approximation with tie correction */
+  inline double mannWhitneyU(const std::vector<float>& a, const std::vector<float>& b)
+  {
+    const size_t n1 = a.size();
+    const size_t n2 = b.size();
+    if (n1 == 0 || n2 == 0) return 1.0;
+
+    std::vector<std::pair<float,int>> all;
+    for (float x : a) all.push_back(std::make_pair(x,0));
+    for (float x : b) all.push_back(std::make_pair(x,1));
+    std::sort(all.begin(),all.end());
+
+    /* rank samples and average the ranks of ties */
+    const double n = double(all.size());
+    double R1 = 0.0, ties = 0.0;
+    for (size_t i=0; i<all.size();)
+    {
+      size_t j = i+1;
+      while (j < all.size() && all[j].first == all[i].first) j++;
+      const double rank = 0.5*double(i+1+j);
+      for (size_t k=i; k<j; k++)
+        if (all[k].second == 0) R1 += rank;
+      const double t = double(j-i);
+      ties += t*t*t-t;
+      i = j;
+    }
+
+    const double U = R1 - 0.5*double(n1)*double(n1+1);
+    const double mu = 0.5*double(n1)*double(n2);
+    const double sigma = sqrt(double(n1)*double(n2)/12.0*((n+1.0) - ties/(n*(n-1.0))));
+    if (sigma == 0.0) return 1.0;
+    const double z = max(0.0,std::abs(U-mu)-0.5)/sigma;
+    return std::erfc(z/sqrt(2.0));
+  }
 }
@@ -405,6 +405,10 @@ namespace embree
     registerOption("convert-mblur-to-nonmblur", [this] (Ref<ParseStream> cin, const FileName& path) {
          sgop.push_back(CONVERT_MBLUR_TO_NONMBLUR);
       }, "--convert-mblur-to-nonmblur: converts all motion blur geometry to non-motion blur geometry");
+
+    registerOption("deduplicate-geometries", [this] (Ref<ParseStream> cin, const FileName& path) {
+         sgop.push_back(DEDUPLICATE_GEOMETRIES);
+      }, "--deduplicate-geometries: replaces geometries with identical data by a single geometry that gets instanced (use with --instancing geometry)");
     
     registerOption("remove-mblur", [this] (Ref<ParseStream> cin, const FileName& path) {
          remove_mblur = true;
@@ -1261,6 +1265,7 @@ namespace embree
       case CONVERT_QUADS_TO_GRIDS       : scene->quads_to_grids(grid_resX,grid_resY); break;
       case CONVERT_GRIDS_TO_QUADS       : scene->grids_to_quads(); break;
       case CONVERT_MBLUR_TO_NONMBLUR    : convert_mblur_to_nonmblur(scene.dynamicCast<SceneGraph::Node>()); break;
+      case DEDUPLICATE_GEOMETRIES       : deduplicate_geometries(scene.dynamicCast<SceneGraph::Node>()); break;
       default : throw std::runtime_error("unsupported scene graph operation");
       }
     }
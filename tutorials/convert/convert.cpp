@@ -192,6 +192,11 @@ namespace embree
         g_scene->bspline_to_bezier();
       }
 
+      /* share geometries with identical data */
+      else if (tag == "-deduplicate-geometries") {
+        g_scene = SceneGraph::deduplicate_geometries(g_scene.dynamicCast<SceneGraph::Node>()).dynamicCast<SceneGraph::GroupNode>();
+      }
+
       /* flatten scene */
       else if (tag == "-flatten-group") {
         g_scene = SceneGraph::flatten(g_scene,SceneGraph::INSTANCING_GROUP);
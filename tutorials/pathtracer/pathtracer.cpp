@@ -19,6 +19,11 @@ namespace embree
     int g_max_path_length = 8;
     bool g_accumulate = 1;
   }
+
+  typedef void (* renderFrameFunc)(int* pixels, const unsigned int width, const unsigned int height, const float time, const ISPCCamera& camera);
+  extern renderFrameFunc renderFrame;
+  
+  extern "C" void renderFrameWavefront(int* pixels, const unsigned int width, const unsigned int height, const float time, const ISPCCamera& camera);
   
   struct Tutorial : public SceneLoadingTutorialApplication
   {
@@ -36,6 +41,10 @@ namespace embree
       registerOption("accumulate", [] (Ref<ParseStream> cin, const FileName& path) {
           g_accumulate = cin->getInt();
         }, "--accumulate <bool>: accumulate samples (on by default)");
+
+      registerOption("wavefront", [] (Ref<ParseStream> cin, const FileName& path) {
+          renderFrame = renderFrameWavefront;
+        }, "--wavefront: renders in wavefronts that trace all rays of a bounce sorted by material and direction in packets of 16 rays, prints the ray throughput of each bounce at exit");
     }
     
     void postParseCommandLine() override
@@ -9,6 +9,10 @@
 #include "../common/lights/quad_light.cpp"
 #include "../common/lights/spot_light.cpp"
 
+#if !defined(EMBREE_SYCL_TUTORIAL)
+#include "../../common/algorithms/parallel_sort.h"
+#endif
+
 namespace embree {
 
 #define USE_ARGUMENT_CALLBACKS 1
@@ -1660,6 +1664,473 @@ void renderTileTask (int taskIndex, int threadIndex, int* pixels,
 }
 
 
+/***************************************************************************************/
+/*                              Wavefront Path Tracer                                  */
+/***************************************************************************************/
+
+#if !defined(EMBREE_SYCL_TUTORIAL)
+
+/* maximal number of paths traced together */
+#define WAVEFRONT_SIZE (256*1024)
+
+/* state of a path that gets traced by the wavefront */
+struct WavefrontPath
+{
+  Ray ray;                  //!< ray of the current bounce
+  Vec3fa L;                 //!< radiance accumulator
+  Vec3fa Lw;                //!< radiance weight
+  Medium medium;            //!< medium the ray travels through
+  RandomSampler sampler;    //!< random number generator of the path
+  unsigned int materialID;  //!< material the ray starts at, used for sorting
+};
+
+/* shadow ray of a light sample, the contribution is added to the path if the light is visible */
+struct WavefrontShadowRay
+{
+  Vec3ff org;               //!< origin and tnear
+  Vec3ff dir;               //!< direction and time
+  Vec3fa contribution;      //!< radiance added to the path
+  float tfar;
+  bool valid;
+};
+
+/* statistics of a single bounce of the wavefront */
+struct WavefrontBounceStats
+{
+  size_t numRays;
+  size_t numShadowRays;
+  double rayTime;
+  double shadowRayTime;
+};
+
+/* buffers of the wavefront, get reused across frames */
+struct Wavefront
+{
+  size_t numPaths;
+  size_t numShadowRays;
+  WavefrontPath* paths;
+  unsigned int* queue;
+  uint64_t* keys;
+  uint64_t* keys_tmp;
+  bool* active;
+  WavefrontShadowRay* shadows;
+  unsigned int* shadowQueue;
+
+  std::vector<WavefrontBounceStats> stats;
+};
+
+Wavefront g_wavefront = { 0, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+
+void Wavefront_free(Wavefront& wf)
+{
+  alignedFree(wf.paths); wf.paths = nullptr;
+  alignedFree(wf.queue); wf.queue = nullptr;
+  alignedFree(wf.keys); wf.keys = nullptr;
+  alignedFree(wf.keys_tmp); wf.keys_tmp = nullptr;
+  alignedFree(wf.active); wf.active = nullptr;
+  alignedFree(wf.shadows); wf.shadows = nullptr;
+  alignedFree(wf.shadowQueue); wf.shadowQueue = nullptr;
+  wf.numPaths = wf.numShadowRays = 0;
+}
+
+void Wavefront_resize(Wavefront& wf, size_t numPaths, size_t numShadowRays)
+{
+  if (wf.numPaths == numPaths && wf.numShadowRays == numShadowRays)
+    return;
+
+  Wavefront_free(wf);
+  wf.paths       = (WavefrontPath*) alignedMalloc(numPaths*sizeof(WavefrontPath),64);
+  wf.queue       = (unsigned int*) alignedMalloc(numPaths*sizeof(unsigned int),64);
+  wf.keys        = (uint64_t*) alignedMalloc(numPaths*sizeof(uint64_t),64);
+  wf.keys_tmp    = (uint64_t*) alignedMalloc(numPaths*sizeof(uint64_t),64);
+  wf.active      = (bool*) alignedMalloc(numPaths*sizeof(bool),64);
+  wf.shadows     = (WavefrontShadowRay*) alignedMalloc(numShadowRays*sizeof(WavefrontShadowRay),64);
+  wf.shadowQueue = (unsigned int*) alignedMalloc(numShadowRays*sizeof(unsigned int),64);
+  wf.numPaths = numPaths;
+  wf.numShadowRays = numShadowRays;
+}
+
+/* sorts the queue by material the rays start at and direction octant */
+void sortWavefrontQueue(Wavefront& wf, size_t numActive)
+{
+  parallel_for(size_t(0),numActive,size_t(4096),[&](const range<size_t>& r) {
+    for (size_t i=r.begin(); i<r.end(); i++)
+    {
+      const WavefrontPath& path = wf.paths[wf.queue[i]];
+      const unsigned int octant = (path.ray.dir.x < 0.0f ? 1 : 0) | (path.ray.dir.y < 0.0f ? 2 : 0) | (path.ray.dir.z < 0.0f ? 4 : 0);
+      const uint64_t key = 8*uint64_t(path.materialID) + octant;
+      wf.keys[i] = (key << 32) | wf.queue[i];
+    }
+  });
+
+  radix_sort_u64(wf.keys,wf.keys_tmp,numActive);
+
+  parallel_for(size_t(0),numActive,size_t(4096),[&](const range<size_t>& r) {
+    for (size_t i=r.begin(); i<r.end(); i++)
+      wf.queue[i] = (unsigned int) wf.keys[i];
+  });
+}
+
+/* traces the rays of all queued paths in packets of 16 rays */
+void traceWavefrontRays(const TutorialData& data, Wavefront& wf, size_t numActive, RTCRayQueryFlags flags, const RTCFeatureFlags features)
+{
+  parallel_for(size_t(0),(numActive+15)/16,[&](const range<size_t>& r)
+  {
+    const int threadIndex = (int)TaskScheduler::threadIndex();
+    
+    RayQueryContext context;
+    InitIntersectionContext(&context);
+    context.tutorialData = (void*) &data;
+    
+    RTCIntersectArguments args;
+    rtcInitIntersectArguments(&args);
+    args.context = &context.context;
+    args.flags = flags;
+    args.feature_mask = features;
+#if USE_ARGUMENT_CALLBACKS && ENABLE_FILTER_FUNCTION
+    args.filter = nullptr;
+#endif
+
+    for (size_t b=r.begin(); b<r.end(); b++)
+    {
+      __aligned(64) int valid[16];
+      RTCRayHit16 rayhit;
+      const size_t begin = 16*b;
+      const size_t N = min(numActive-begin,size_t(16));
+
+      for (size_t j=0; j<16; j++)
+      {
+        /* inactive lanes get a copy of the first ray */
+        valid[j] = j < N ? -1 : 0;
+        const Ray& ray = wf.paths[wf.queue[begin + (j < N ? j : 0)]].ray;
+        rayhit.ray.org_x[j] = ray.org.x;
+        rayhit.ray.org_y[j] = ray.org.y;
+        rayhit.ray.org_z[j] = ray.org.z;
+        rayhit.ray.tnear[j] = ray.tnear();
+        rayhit.ray.dir_x[j] = ray.dir.x;
+        rayhit.ray.dir_y[j] = ray.dir.y;
+        rayhit.ray.dir_z[j] = ray.dir.z;
+        rayhit.ray.time[j]  = ray.time();
+        rayhit.ray.tfar[j]  = ray.tfar;
+        rayhit.ray.mask[j]  = ray.mask;
+        rayhit.ray.id[j]    = (unsigned int) j;
+        rayhit.ray.flags[j] = 0;
+        rayhit.hit.geomID[j] = RTC_INVALID_GEOMETRY_ID;
+        rayhit.hit.instID[0][j] = RTC_INVALID_GEOMETRY_ID;
+      }
+
+      rtcIntersect16(valid,data.scene,&rayhit,&args);
+
+      for (size_t j=0; j<N; j++)
+      {
+        Ray& ray = wf.paths[wf.queue[begin+j]].ray;
+        ray.tfar = rayhit.ray.tfar[j];
+        ray.geomID = rayhit.hit.geomID[j];
+        if (ray.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        ray.primID = rayhit.hit.primID[j];
+        ray.Ng = Vec3f(rayhit.hit.Ng_x[j],rayhit.hit.Ng_y[j],rayhit.hit.Ng_z[j]);
+        ray.u = rayhit.hit.u[j];
+        ray.v = rayhit.hit.v[j];
+        for (int l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+          ray.instID[l] = rayhit.hit.instID[l][j];
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+          ray.instPrimID[l] = rayhit.hit.instPrimID[l][j];
+#endif
+        }
+      }
+      for (size_t j=0; j<N; j++)
+        RayStats_addRay(g_stats[threadIndex]);
+    }
+  });
+}
+
+/* traces the queued shadow rays in packets of 16 rays, occluded shadow rays get invalidated */
+void traceWavefrontShadowRays(const TutorialData& data, Wavefront& wf, size_t numShadowRays, const RTCFeatureFlags features)
+{
+  parallel_for(size_t(0),(numShadowRays+15)/16,[&](const range<size_t>& r)
+  {
+    const int threadIndex = (int)TaskScheduler::threadIndex();
+    
+    RayQueryContext context;
+    InitIntersectionContext(&context);
+    context.tutorialData = (void*) &data;
+    
+    RTCOccludedArguments sargs;
+    rtcInitOccludedArguments(&sargs);
+    sargs.context = &context.context;
+    sargs.flags = data.iflags_incoherent;
+    sargs.feature_mask = features;
+#if USE_ARGUMENT_CALLBACKS && ENABLE_FILTER_FUNCTION
+    sargs.filter = nullptr;
+#endif
+
+    for (size_t b=r.begin(); b<r.end(); b++)
+    {
+      __aligned(64) int valid[16];
+      RTCRay16 ray16;
+      const size_t begin = 16*b;
+      const size_t N = min(numShadowRays-begin,size_t(16));
+
+      for (size_t j=0; j<16; j++)
+      {
+        valid[j] = j < N ? -1 : 0;
+        const WavefrontShadowRay& shadow = wf.shadows[wf.shadowQueue[begin + (j < N ? j : 0)]];
+        ray16.org_x[j] = shadow.org.x;
+        ray16.org_y[j] = shadow.org.y;
+        ray16.org_z[j] = shadow.org.z;
+        ray16.tnear[j] = shadow.org.w;
+        ray16.dir_x[j] = shadow.dir.x;
+        ray16.dir_y[j] = shadow.dir.y;
+        ray16.dir_z[j] = shadow.dir.z;
+        ray16.time[j]  = shadow.dir.w;
+        ray16.tfar[j]  = shadow.tfar;
+        ray16.mask[j]  = -1;
+        ray16.id[j]    = (unsigned int) j;
+        ray16.flags[j] = 0;
+      }
+
+      rtcOccluded16(valid,data.scene,&ray16,&sargs);
+
+      for (size_t j=0; j<N; j++) {
+        if (ray16.tfar[j] < 0.0f) wf.shadows[wf.shadowQueue[begin+j]].valid = false;
+        RayStats_addShadowRay(g_stats[threadIndex]);
+      }
+    }
+  });
+}
+
+/* shades the hit of a path, generates its shadow rays and the ray of the next bounce, returns false if the path terminates */
+bool shadeWavefrontPath(const TutorialData& data, WavefrontPath& path, WavefrontShadowRay* shadows)
+{
+  Ray& ray = path.ray;
+  const float time = ray.time();
+  const Vec3fa wo = neg(ray.dir);
+
+  for (unsigned int i=0; i<data.ispc_scene->numLights; i++)
+    shadows[i].valid = false;
+
+  DifferentialGeometry dg;
+  
+  /* invoke environment lights if nothing hit */
+  if (ray.geomID == RTC_INVALID_GEOMETRY_ID)
+  {
+    dg.P = Vec3fa(ray.org);
+    for (unsigned int i=0; i<data.ispc_scene->numLights; i++)
+    {
+      const Light* l = data.ispc_scene->lights[i];
+      Light_EvalRes le = Lights_eval(l,dg,ray.dir);
+      path.L = path.L + path.Lw*le.value;
+    }
+    return false;
+  }
+
+  /* compute differential geometry */
+  for (int i=0; i<RTC_MAX_INSTANCE_LEVEL_COUNT; i++)
+    dg.instIDs[i] = ray.instID[i];
+  
+  dg.geomID = ray.geomID;
+  dg.primID = ray.primID;
+  dg.u = ray.u;
+  dg.v = ray.v;
+  dg.P  = ray.org+ray.tfar*ray.dir;
+  dg.Ng = ray.Ng;
+  dg.Ns = normalize(ray.Ng);
+  int materialID = postIntersect(data,ray,dg);
+  dg.Ng = face_forward(ray.dir,normalize(dg.Ng));
+  dg.Ns = face_forward(ray.dir,normalize(dg.Ns));
+
+  /*! Compute  simple volumetric effect. */
+  Vec3fa c = Vec3fa(1.0f);
+  const Vec3fa transmission = path.medium.transmission;
+  if (ne(transmission,Vec3fa(1.0f)))
+    c = c * pow(transmission,ray.tfar);
+
+  /* calculate BRDF */
+  BRDF brdf;
+  int numMaterials = data.ispc_scene->numMaterials;
+  ISPCMaterial** material_array = &data.ispc_scene->materials[0];
+  Material__preprocess(material_array,materialID,numMaterials,brdf,wo,dg,path.medium);
+
+  /* sample BRDF at hit point */
+  Sample3f wi1;
+  c = c * Material__sample(material_array,materialID,numMaterials,brdf,path.Lw,wo,dg,wi1,path.medium,RandomSampler_get2D(path.sampler));
+
+  /* generate a shadow ray for each light */
+  for (unsigned int i=0; i<data.ispc_scene->numLights; i++)
+  {
+    const Light* l = data.ispc_scene->lights[i];
+    Light_SampleRes ls = Lights_sample(l,dg,RandomSampler_get2D(path.sampler));
+    if (ls.pdf <= 0.0f) continue;
+    WavefrontShadowRay& shadow = shadows[i];
+    shadow.org = Vec3ff(dg.P,dg.eps);
+    shadow.dir = Vec3ff(ls.dir,time);
+    shadow.tfar = ls.dist;
+    shadow.contribution = path.Lw*ls.weight*Material__eval(material_array,materialID,numMaterials,brdf,wo,dg,ls.dir);
+    shadow.valid = true;
+  }
+
+  if (wi1.pdf <= 1E-4f /* 0.0f */) return false;
+  path.Lw = path.Lw*c/wi1.pdf;
+
+  /* terminate if contribution too low */
+  if (max(path.Lw.x,max(path.Lw.y,path.Lw.z)) < 0.01f)
+    return false;
+
+  /* setup secondary ray */
+  float sign = dot(wi1.v,dg.Ng) < 0.0f ? -1.0f : 1.0f;
+  dg.P = dg.P + sign*dg.eps*dg.Ng;
+  init_Ray(ray,dg.P,normalize(wi1.v),dg.eps,inf,time);
+  path.materialID = materialID;
+  return true;
+}
+
+/* renders the frame in wavefronts: all paths of a wavefront are advanced bounce by bounce, each bounce sorts
+   the rays by material and direction and traces them in packets of 16 rays */
+extern "C" void renderFrameWavefront (int* pixels,
+                                      const unsigned int width,
+                                      const unsigned int height,
+                                      const float time,
+                                      const ISPCCamera& camera)
+{
+  Wavefront& wf = g_wavefront;
+  const unsigned int numLights = data.ispc_scene->numLights;
+  const RTCFeatureFlags features = RTC_FEATURE_FLAG_ALL;
+  const size_t spp = data.spp;
+  const size_t numPixels = size_t(width)*size_t(height);
+
+  /* scenes with many lights use smaller wavefronts to bound the memory for the shadow rays */
+  const size_t wavePixels = min(numPixels,max(size_t(1024),size_t(WAVEFRONT_SIZE/spp/max(1u,numLights))));
+  Wavefront_resize(wf,wavePixels*spp,wavePixels*spp*max(1u,numLights));
+  if (wf.stats.size() < size_t(data.max_path_length))
+    wf.stats.resize(data.max_path_length,WavefrontBounceStats{0,0,0.0,0.0});
+  
+  for (size_t pixel0=0; pixel0<numPixels; pixel0+=wavePixels)
+  {
+    const size_t numPaths = min(wavePixels,numPixels-pixel0)*spp;
+
+    /* generate primary rays */
+    parallel_for(size_t(0),numPaths,size_t(4096),[&](const range<size_t>& r) {
+      for (size_t i=r.begin(); i<r.end(); i++)
+      {
+        const unsigned int pixel = (unsigned int) (pixel0 + i/spp);
+        const unsigned int x = pixel % width;
+        const unsigned int y = pixel / width;
+        WavefrontPath& path = wf.paths[i];
+        RandomSampler_init(path.sampler, x, y, data.accu_count*data.spp + int(i%spp));
+        const float fx = x + RandomSampler_get1D(path.sampler);
+        const float fy = y + RandomSampler_get1D(path.sampler);
+        const float time = RandomSampler_get1D(path.sampler);
+        init_Ray(path.ray,Vec3fa(camera.xfm.p),Vec3fa(normalize(fx*camera.xfm.l.vx + fy*camera.xfm.l.vy + camera.xfm.l.vz)),0.0f,inf,time);
+        path.L = Vec3fa(0.0f);
+        path.Lw = Vec3fa(1.0f);
+        path.medium = make_Medium_Vacuum();
+        path.materialID = 0;
+        wf.queue[i] = (unsigned int) i;
+      }
+    });
+    
+    size_t numActive = numPaths;
+    for (int bounce=0; bounce<data.max_path_length && numActive; bounce++)
+    {
+      WavefrontBounceStats& stats = wf.stats[bounce];
+      sortWavefrontQueue(wf,numActive);
+      
+      /* trace rays */
+      double t0 = getSeconds();
+      traceWavefrontRays(data,wf,numActive,bounce == 0 ? data.iflags_coherent : data.iflags_incoherent,features);
+      stats.rayTime += getSeconds()-t0;
+      stats.numRays += numActive;
+      
+      /* shade hits */
+      parallel_for(size_t(0),numActive,size_t(256),[&](const range<size_t>& r) {
+        for (size_t i=r.begin(); i<r.end(); i++)
+          wf.active[i] = shadeWavefrontPath(data,wf.paths[wf.queue[i]],&wf.shadows[i*numLights]);
+      });
+
+      /* trace shadow rays */
+      size_t numShadowRays = 0;
+      for (size_t i=0; i<numActive*numLights; i++)
+        if (wf.shadows[i].valid) wf.shadowQueue[numShadowRays++] = (unsigned int) i;
+      
+      t0 = getSeconds();
+      traceWavefrontShadowRays(data,wf,numShadowRays,features);
+      stats.shadowRayTime += getSeconds()-t0;
+      stats.numShadowRays += numShadowRays;
+
+      /* add contribution of visible lights */
+      parallel_for(size_t(0),numActive,size_t(4096),[&](const range<size_t>& r) {
+        for (size_t i=r.begin(); i<r.end(); i++)
+        {
+          WavefrontPath& path = wf.paths[wf.queue[i]];
+          for (size_t l=0; l<numLights; l++) {
+            const WavefrontShadowRay& shadow = wf.shadows[i*numLights+l];
+            if (shadow.valid) path.L = path.L + shadow.contribution;
+          }
+        }
+      });
+
+      /* compact queue */
+      size_t numNextActive = 0;
+      for (size_t i=0; i<numActive; i++)
+        if (wf.active[i]) wf.queue[numNextActive++] = wf.queue[i];
+      numActive = numNextActive;
+    }
+
+    /* write color to framebuffer */
+    parallel_for(size_t(0),numPaths/spp,size_t(4096),[&](const range<size_t>& r) {
+      for (size_t i=r.begin(); i<r.end(); i++)
+      {
+        Vec3fa L = Vec3fa(0.0f);
+        for (size_t s=0; s<spp; s++)
+          L = L + wf.paths[i*spp+s].L;
+        L = L/(float)spp;
+        
+        const size_t pixel = pixel0+i;
+        Vec3ff accu_color = data.accu[pixel] + Vec3ff(L.x,L.y,L.z,1.0f); data.accu[pixel] = accu_color;
+        float f = rcp(max(0.001f,accu_color.w));
+        unsigned int r = (unsigned int) (255.01f * clamp(accu_color.x*f,0.0f,1.0f));
+        unsigned int g = (unsigned int) (255.01f * clamp(accu_color.y*f,0.0f,1.0f));
+        unsigned int b = (unsigned int) (255.01f * clamp(accu_color.z*f,0.0f,1.0f));
+        pixels[pixel] = (b << 16) + (g << 8) + r;
+      }
+    });
+  }
+}
+
+/* prints the ray throughput of each bounce of the wavefront path tracer */
+void printWavefrontStats(const Wavefront& wf)
+{
+  if (wf.stats.size() == 0 || wf.stats[0].numRays == 0)
+    return;
+  
+  std::cout << "wavefront statistics:" << std::endl;
+  for (size_t i=0; i<wf.stats.size(); i++)
+  {
+    const WavefrontBounceStats& stats = wf.stats[i];
+    if (stats.numRays == 0) break;
+    std::cout << "  bounce " << std::setw(2) << i << ": "
+              << std::fixed << std::setprecision(2)
+              << std::setw(8) << 1E-6*stats.numRays << " M rays, "
+              << std::setw(8) << 1E-6*stats.numRays/max(stats.rayTime,1E-9) << " Mrays/s, "
+              << std::setw(8) << 1E-6*stats.numShadowRays << " M shadow rays, "
+              << std::setw(8) << 1E-6*stats.numShadowRays/max(stats.shadowRayTime,1E-9) << " Mrays/s" << std::endl;
+  }
+}
+
+#else
+
+/* the SYCL version always renders with the standard renderer */
+extern "C" void renderFrameWavefront (int* pixels,
+                                      const unsigned int width,
+                                      const unsigned int height,
+                                      const float time,
+                                      const ISPCCamera& camera)
+{
+  renderFrameStandard(pixels,width,height,time,camera);
+}
+
+#endif
+
 /***************************************************************************************/
 
 inline float updateEdgeLevel( ISPCSubdivMesh* mesh, const Vec3fa& cam_pos, const unsigned int e0, const unsigned int e1)
@@ -1844,6 +2315,10 @@ extern "C" void device_render (int* pixels,
 extern "C" void device_cleanup ()
 {
   TutorialData_Destructor(&data);
+#if !defined(EMBREE_SYCL_TUTORIAL)
+  printWavefrontStats(g_wavefront);
+  Wavefront_free(g_wavefront);
+#endif
   
 } // device_cleanup
 
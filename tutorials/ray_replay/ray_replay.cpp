@@ -0,0 +1,86 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ray_replay.h"
+
+#include "../common/tutorial/tutorial.h"
+
+#include <thread>
+
+#define NAME "ray_replay"
+#define FEATURES FEATURE_RTCORE
+
+RTC_NAMESPACE_USE;
+
+namespace embree
+{
+  ReplayParams g_replay_params;
+
+  struct Tutorial : public SceneLoadingTutorialApplication
+  {
+    Tutorial()
+      : SceneLoadingTutorialApplication(NAME,FEATURES)
+    {
+      interactive = false;
+
+      registerOption("rays", [] (Ref<ParseStream> cin, const FileName& path) {
+          g_replay_params.rayFile = path + cin->getFileName();
+        }, "--rays <filename>: ray dump to replay, recorded with --rtcore ray_dump=<filename>");
+
+      registerOption("replay_widths", [] (Ref<ParseStream> cin, const FileName& path) {
+          g_replay_params.widths.clear();
+          while (cin->peek() != "" && cin->peek()[0] != '-') {
+            const int width = cin->getInt();
+            if (width != 1 && width != 4 && width != 8 && width != 16)
+              throw std::runtime_error("invalid ray packet width " + toString(width));
+            g_replay_params.widths.push_back(width);
+          }
+        }, "--replay_widths <int> ...: ray packet widths to replay with (default 1 4 8 16)");
+
+      registerOption("replay_threads", [] (Ref<ParseStream> cin, const FileName& path) {
+          g_replay_params.threads.clear();
+          while (cin->peek() != "" && cin->peek()[0] != '-')
+            g_replay_params.threads.push_back(max(1,cin->getInt()));
+        }, "--replay_threads <int> ...: thread counts to replay with (default 1 2 4 ... up to the number of hardware threads)");
+    }
+
+    void postParseCommandLine() override
+    {
+      /* load default scene if none specified */
+      if (scene_empty_post_parse()) {
+        FileName file = FileName::executableFolder() + FileName("models/cornell_box.ecs");
+        parseCommandLine(new ParseStream(new LineCommentFilter(file, "#")), file.path());
+      }
+    }
+  };
+
+  std::unique_ptr<Tutorial> tutorial {};
+
+  static void replayBench(BenchState& state, BenchParams& params, int argc, char** argv)
+  {
+    if (!tutorial) {
+      tutorial.reset(new Tutorial());
+      tutorial->main(argc,argv);
+    }
+
+    if (g_replay_params.rayFile.str() == "")
+      throw std::runtime_error("no ray dump specified, use --rays <filename>");
+
+    if (g_replay_params.widths.empty())
+      g_replay_params.widths = { 1, 4, 8, 16 };
+
+    if (g_replay_params.threads.empty()) {
+      const unsigned int numThreads = max(1u,std::thread::hardware_concurrency());
+      for (unsigned int t=1; t<numThreads; t*=2)
+        g_replay_params.threads.push_back(t);
+      g_replay_params.threads.push_back(numThreads);
+    }
+
+    Benchmark_Replay(state, params, g_replay_params, tutorial->ispc_scene.get());
+  }
+}
+
+int main(int argc, char **argv)
+{
+  return embree::TutorialBenchmark(embree::replayBench).main(argc, argv, NAME);
+}
@@ -0,0 +1,19 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "../common/tutorial/benchmark.h"
+
+namespace embree {
+  struct ISPCScene;
+
+  struct ReplayParams
+  {
+    FileName rayFile;                 //!< ray dump recorded with the ray_dump=<file> device configuration
+    std::vector<unsigned int> widths; //!< ray packet widths to replay with
+    std::vector<unsigned int> threads; //!< thread counts to replay with
+  };
+
+  void Benchmark_Replay(BenchState& state, BenchParams& params, ReplayParams& replayParams, ISPCScene* ispc_scene);
+}
@@ -0,0 +1,337 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ray_replay.h"
+
+#include "../common/tutorial/tutorial_device.h"
+#include "../common/tutorial/scene_device.h"
+#include "../../kernels/common/ray_dump_format.h"
+
+#ifdef USE_GOOGLE_BENCHMARK
+#include <benchmark/benchmark.h>
+#endif
+
+#include <thread>
+
+namespace embree {
+
+  RTCScene g_scene = nullptr;
+
+  /* number of packets a thread fetches at once */
+  static const size_t PACKETS_PER_TASK = 64;
+
+  /* default number of replays of the legacy benchmark */
+  static const size_t iterations_replay = 10;
+
+  /* rays of the dump that are traced with one query */
+  struct ReplayPacket
+  {
+    uint32_t query;
+    uint32_t query_flags;
+    uint32_t feature_mask;
+    uint32_t begin;  //!< first ray in the ray order of the packets
+    uint32_t count;
+  };
+
+  std::vector<RayDumpFormat::Ray> g_rays;
+  std::vector<uint32_t> g_ray_order;
+
+  std::vector<RayDumpFormat::Ray> loadRays(const FileName& fileName)
+  {
+    std::ifstream file(fileName.str().c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+      throw std::runtime_error("cannot open file " + fileName.str());
+
+    RayDumpFormat::Header header;
+    file.read((char*)&header,sizeof(header));
+    if (!file.good() || header.magic != RayDumpFormat::MAGIC)
+      throw std::runtime_error(fileName.str() + " is not a ray dump");
+    if (header.version != RayDumpFormat::VERSION || header.rayBytes != sizeof(RayDumpFormat::Ray))
+      throw std::runtime_error(fileName.str() + " has unsupported ray dump version " + toString(header.version));
+
+    file.seekg(0,std::ios::end);
+    const size_t bytes = size_t(file.tellg()) - sizeof(header);
+    file.seekg(sizeof(header),std::ios::beg);
+
+    std::vector<RayDumpFormat::Ray> rays(bytes/sizeof(RayDumpFormat::Ray));
+    file.read((char*)rays.data(),rays.size()*sizeof(RayDumpFormat::Ray));
+    if (!file.good())
+      throw std::runtime_error("error reading file " + fileName.str());
+    return rays;
+  }
+
+  /* groups the rays into packets of up to K rays with the same query
+   * arguments, e.g. applications typically alternate between
+   * rtcIntersect and rtcOccluded calls, thus each query kind fills its
+   * own packet, keeping the order of the rays within each kind */
+  std::vector<ReplayPacket> createPackets(const std::vector<RayDumpFormat::Ray>& rays, unsigned int K)
+  {
+    std::vector<ReplayPacket> packets;
+    std::vector<ReplayPacket> open;
+    std::vector<std::vector<uint32_t>> openRays;
+    g_ray_order.clear();
+
+    auto emit = [&] (size_t j) {
+      open[j].begin = (uint32_t) g_ray_order.size();
+      open[j].count = (uint32_t) openRays[j].size();
+      g_ray_order.insert(g_ray_order.end(),openRays[j].begin(),openRays[j].end());
+      packets.push_back(open[j]);
+      openRays[j].clear();
+    };
+
+    for (size_t i=0; i<rays.size(); i++)
+    {
+      const RayDumpFormat::Ray& ray = rays[i];
+      size_t j = 0;
+      while (j < open.size() && (open[j].query != ray.query ||
+                                 open[j].query_flags != ray.query_flags ||
+                                 open[j].feature_mask != ray.feature_mask))
+        j++;
+
+      if (j == open.size()) {
+        ReplayPacket packet;
+        packet.query = ray.query;
+        packet.query_flags = ray.query_flags;
+        packet.feature_mask = ray.feature_mask;
+        packet.begin = packet.count = 0;
+        open.push_back(packet);
+        openRays.push_back(std::vector<uint32_t>());
+      }
+
+      openRays[j].push_back((uint32_t) i);
+      if (openRays[j].size() == K) emit(j);
+    }
+
+    for (size_t j=0; j<open.size(); j++)
+      if (!openRays[j].empty()) emit(j);
+
+    return packets;
+  }
+
+  template<int K>
+  void tracePacket(const ReplayPacket& packet)
+  {
+    alignas(64) int valid[K];
+    alignas(64) RTCRayHitNt<K> rayhit;
+
+    /* copy the rays into SOA layout, RTCRay and RTCRayN store the same 12 fields */
+    uint32_t* dst = (uint32_t*) &rayhit.ray;
+    for (int i=0; i<K; i++)
+    {
+      valid[i] = i < (int)packet.count ? -1 : 0;
+      if (!valid[i]) continue;
+      const uint32_t* src = (const uint32_t*) &g_rays[g_ray_order[packet.begin+i]];
+      for (int f=0; f<12; f++)
+        dst[f*K+i] = src[f];
+      rayhit.hit.geomID[i] = RTC_INVALID_GEOMETRY_ID;
+      rayhit.hit.instID[0][i] = RTC_INVALID_GEOMETRY_ID;
+    }
+
+    if (packet.query == RayDumpFormat::QUERY_INTERSECT)
+    {
+      RTCIntersectArguments args;
+      rtcInitIntersectArguments(&args);
+      args.flags = (RTCRayQueryFlags) packet.query_flags;
+      args.feature_mask = (RTCFeatureFlags) packet.feature_mask;
+      if (K == 1)       rtcIntersect1(g_scene,(RTCRayHit*)&rayhit,&args);
+      else if (K == 4)  rtcIntersect4(valid,g_scene,(RTCRayHit4*)&rayhit,&args);
+      else if (K == 8)  rtcIntersect8(valid,g_scene,(RTCRayHit8*)&rayhit,&args);
+      else if (K == 16) rtcIntersect16(valid,g_scene,(RTCRayHit16*)&rayhit,&args);
+    }
+    else
+    {
+      RTCOccludedArguments args;
+      rtcInitOccludedArguments(&args);
+      args.flags = (RTCRayQueryFlags) packet.query_flags;
+      args.feature_mask = (RTCFeatureFlags) packet.feature_mask;
+      if (K == 1)       rtcOccluded1(g_scene,(RTCRay*)&rayhit.ray,&args);
+      else if (K == 4)  rtcOccluded4(valid,g_scene,(RTCRay4*)&rayhit.ray,&args);
+      else if (K == 8)  rtcOccluded8(valid,g_scene,(RTCRay8*)&rayhit.ray,&args);
+      else if (K == 16) rtcOccluded16(valid,g_scene,(RTCRay16*)&rayhit.ray,&args);
+    }
+  }
+
+  template<int K>
+  void tracePackets(const std::vector<ReplayPacket>& packets, std::atomic<size_t>& next)
+  {
+    while (true)
+    {
+      const size_t begin = next.fetch_add(PACKETS_PER_TASK);
+      if (begin >= packets.size()) return;
+      const size_t end = min(begin+PACKETS_PER_TASK,packets.size());
+      for (size_t i=begin; i<end; i++)
+        tracePacket<K>(packets[i]);
+    }
+  }
+
+  /* threads that replay the packets, the threads are started once per
+   * configuration and synchronized with a barrier, thus thread startup
+   * is not part of the measured time */
+  struct ReplayThreads
+  {
+    const std::vector<ReplayPacket>& packets;
+    const unsigned int width;
+    std::atomic<size_t> next;
+    BarrierSys barrier;
+    volatile bool term = false;
+    std::vector<std::thread> threads;
+
+    ReplayThreads (const std::vector<ReplayPacket>& packets, unsigned int width, unsigned int numThreads)
+      : packets(packets), width(width), next(0), barrier(numThreads)
+    {
+      for (unsigned int t=1; t<numThreads; t++)
+        threads.push_back(std::thread(&ReplayThreads::perform_work, this));
+    }
+
+    ~ReplayThreads ()
+    {
+      /* terminate task loop */
+      term = true;
+      barrier.wait();
+      for (auto& thread : threads)
+        thread.join();
+    }
+
+    void trace()
+    {
+      switch (width) {
+      case 1 : tracePackets<1> (packets,next); break;
+      case 4 : tracePackets<4> (packets,next); break;
+      case 8 : tracePackets<8> (packets,next); break;
+      case 16: tracePackets<16>(packets,next); break;
+      }
+    }
+
+    void perform_work()
+    {
+      while (true) {
+        barrier.wait();
+        if (term)
+          return;
+        trace();
+        barrier.wait();
+      }
+    }
+
+    /* traces all packets once and returns the time in seconds */
+    double replay()
+    {
+      next = 0;
+      double t0 = getSeconds();
+      barrier.wait();
+      trace();
+      barrier.wait();
+      double t1 = getSeconds();
+      return t1-t0;
+    }
+  };
+
+  void Benchmark_Replay_Legacy(BenchParams& params, ReplayParams& replayParams)
+  {
+    size_t benchmark_iterations = params.minTimeOrIterations;
+    if (benchmark_iterations <= 0)
+      benchmark_iterations = iterations_replay;
+
+    for (unsigned int width : replayParams.widths)
+    {
+      const std::vector<ReplayPacket> packets = createPackets(g_rays,width);
+
+      for (unsigned int numThreads : replayParams.threads)
+      {
+        ReplayThreads threads(packets,width,numThreads);
+        SampleStatistics samples;
+        for (size_t i=0; i<benchmark_iterations+params.skipIterations; i++)
+        {
+          const double dt = threads.replay();
+          if (i >= size_t(params.skipIterations))
+            samples.add(float(double(g_rays.size())/dt/1000000.0));
+        }
+
+        const std::string metric = "w" + toString(width) + "_t" + toString(numThreads);
+        BenchResults::add(params.name,metric,"Mrays/s",true,samples);
+
+        std::cout << "BENCHMARK_REPLAY width " << width << ", " << numThreads << " threads, "
+                  << g_rays.size() << " rays, " << packets.size() << " packets, "
+                  << samples.getMedian() << " Mrays/s (min " << samples.getMin() << ", max " << samples.getMax() << ")" << std::endl;
+      }
+    }
+  }
+
+  void Benchmark_Replay(BenchState& state, BenchParams& params, ReplayParams& replayParams, ISPCScene* ispc_scene)
+  {
+    if (g_rays.empty()) {
+      g_rays = loadRays(replayParams.rayFile);
+      if (g_rays.empty())
+        throw std::runtime_error(replayParams.rayFile.str() + " contains no rays");
+    }
+
+    if (!g_scene) {
+      g_scene = ConvertScene(g_device, ispc_scene, RTC_BUILD_QUALITY_MEDIUM);
+      rtcCommitScene(g_scene);
+    }
+
+#ifdef USE_GOOGLE_BENCHMARK
+    if (params.legacy) {
+      Benchmark_Replay_Legacy(params, replayParams);
+      return;
+    }
+
+    /* google benchmark measures the widest packets with the most threads */
+    const unsigned int width = replayParams.widths.back();
+    const unsigned int numThreads = replayParams.threads.back();
+    const std::vector<ReplayPacket> packets = createPackets(g_rays,width);
+    ReplayThreads threads(packets,width,numThreads);
+
+    for (int i = 0; i < params.skipIterations; ++i)
+      threads.replay();
+
+    for (auto _ : *state.state)
+      threads.replay();
+
+    state.state->SetItemsProcessed(state.state->iterations() * g_rays.size());
+    state.state->counters["Rays"] = ::benchmark::Counter(double(g_rays.size()));
+#else
+    Benchmark_Replay_Legacy(params, replayParams);
+#endif
+  }
+
+  extern "C" void device_init (char* cfg)
+  {
+  }
+
+  void renderFrameStandard (int* pixels,
+                            const unsigned int width,
+                            const unsigned int height,
+                            const float time,
+                            const ISPCCamera& camera)
+  {
+  }
+
+  /* called by the C++ code to render */
+  extern "C" void device_render (int* pixels,
+                                 const unsigned int width,
+                                 const unsigned int height,
+                                 const float time,
+                                 const ISPCCamera& camera)
+  {
+  }
+
+  /* renders a single screen tile */
+  void renderTileStandard(int taskIndex,
+                          int threadIndex,
+                          int* pixels,
+                          const unsigned int width,
+                          const unsigned int height,
+                          const float time,
+                          const ISPCCamera& camera,
+                          const int numTilesX,
+                          const int numTilesY)
+  {
+  }
+
+  /* called by the C++ code for cleanup */
+  extern "C" void device_cleanup ()
+  {
+    rtcReleaseScene (g_scene); g_scene = nullptr;
+  }
+} // namespace embree
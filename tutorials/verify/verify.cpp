@@ -516,7 +516,7 @@ namespace embree
     plot.close();
   }
 
-  Statistics VerifyApplication::Benchmark::benchmark_loop(VerifyApplication* state)
+  Statistics VerifyApplication::Benchmark::benchmark_loop(VerifyApplication* state, SampleStatistics* samples)
   {
     //sleepSeconds(0.1);
     const size_t skipBenchmarkFrames = 1;
@@ -527,7 +527,9 @@ namespace embree
       benchmark(state);
     }  
     for (size_t i=skipBenchmarkFrames; i<numTotalFrames; i++) {
-      stat.add(benchmark(state));
+      const float v = benchmark(state);
+      stat.add(v);
+      if (samples) samples->add(v);
     }
     return stat.getStatistics();
   }
@@ -553,6 +555,7 @@ namespace embree
     /* execute benchmark */
     Statistics curStat;
     Statistics bestStat;
+    SampleStatistics bestSamples;
     bool passed = false;
     
     /* retry if benchmark failed */
@@ -568,12 +571,13 @@ namespace embree
       }
 
       try {
-        curStat = benchmark_loop(state);
-        if (i == 0) bestStat = curStat;
+        SampleStatistics curSamples;
+        curStat = benchmark_loop(state,&curSamples);
+        if (i == 0) { bestStat = curStat; bestSamples = curSamples; }
         if (higher_is_better) {
-          if (curStat.getAvg() > bestStat.getAvg()) bestStat = curStat;
+          if (curStat.getAvg() > bestStat.getAvg()) { bestStat = curStat; bestSamples = curSamples; }
         } else {
-          if (curStat.getAvg() < bestStat.getAvg()) bestStat = curStat;
+          if (curStat.getAvg() < bestStat.getAvg()) { bestStat = curStat; bestSamples = curSamples; }
         }
       } catch (TestReturnValue v) {
         return v;
@@ -596,6 +600,10 @@ namespace embree
     /* update database */
     if (state->database != "" && state->update_database)
       updateDatabase(state,bestStat,avgdb);
+
+    /* record samples for JSON output */
+    if (state->benchmark_json.str() != "")
+      BenchResults::add(name,"value",unit,higher_is_better,bestSamples);
       
     /* print test result */
     double rate0 = 0; if (bestStat.getAvg()) rate0 = 100.0f*bestStat.getAvgSigma()/bestStat.getAvg();
@@ -1697,6 +1705,232 @@ namespace embree
     }
   };
   
+  struct TessellationViewTest : public VerifyApplication::Test
+  {
+    TessellationViewTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      AssertNoError(device);
+
+      /* plane that is only partially inside the view frustum */
+      unsigned geomID = scene.addSubdivPlane(sampler,RTC_BUILD_QUALITY_MEDIUM,8,Vec3fa(-2,-2,0),Vec3fa(4,0,0),Vec3fa(0,4,0)).first;
+      RTCGeometry hgeom = rtcGetGeometry(scene,geomID);
+      AssertNoError(device);
+
+      /* identity view maps the frustum to [-1,1] in x and y */
+      const float xfm[16] = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+      rtcSetGeometryTessellationView(hgeom,xfm,0.0f,512.0f,0.25f);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      rtcSetGeometryTessellationView(hgeom,xfm,512.0f,512.0f,0.25f);
+      rtcCommitGeometry(hgeom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* surface has to stay watertight between differently tessellated faces */
+      for (int y=-15; y<=15; y++)
+      {
+        for (int x=-15; x<=15; x++)
+        {
+          RTCRayHit ray = makeRay(Vec3fa(0.1f*x+0.01f,0.1f*y+0.01f,10.0f),Vec3fa(0,0,-1));
+          rtcIntersect1(scene,&ray);
+          if (ray.hit.geomID != geomID) return VerifyApplication::FAILED;
+        }
+      }
+
+      /* removing the view falls back to the uniform tessellation rate */
+      rtcSetGeometryTessellationView(hgeom,nullptr,0.0f,0.0f,0.0f);
+      rtcCommitGeometry(hgeom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      RTCRayHit ray = makeRay(Vec3fa(0.01f,0.01f,10.0f),Vec3fa(0,0,-1));
+      rtcIntersect1(scene,&ray);
+      if (ray.hit.geomID != geomID) return VerifyApplication::FAILED;
+
+      /* only subdivision geometries support a tessellation view */
+      unsigned geomID2 = scene.addPlane(sampler,RTC_BUILD_QUALITY_MEDIUM,4,Vec3fa(-2,-2,-1),Vec3fa(4,0,0),Vec3fa(0,4,0)).first;
+      rtcSetGeometryTessellationView(rtcGetGeometry(scene,geomID2),xfm,512.0f,512.0f,0.25f);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct DisplacementBoundTest : public VerifyApplication::Test
+  {
+    DisplacementBoundTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static void displacementFunction(const RTCDisplacementFunctionNArguments* args)
+    {
+      std::atomic<size_t>* counter = (std::atomic<size_t>*) args->geometryUserPtr;
+      *counter += args->N;
+      for (unsigned int i=0; i<args->N; i++)
+        args->P_z[i] += 0.25f*sinf(3.0f*args->P_x[i])*cosf(3.0f*args->P_y[i]);
+    }
+
+    unsigned addDisplacedPlane(VerifyScene& scene, std::atomic<size_t>* counter, float maxDisplacement)
+    {
+      unsigned geomID = scene.addSubdivPlane(sampler,RTC_BUILD_QUALITY_MEDIUM,8,Vec3fa(-2,-2,0),Vec3fa(4,0,0),Vec3fa(0,4,0)).first;
+      RTCGeometry hgeom = rtcGetGeometry(scene,geomID);
+      rtcSetGeometryUserData(hgeom,counter);
+      rtcSetGeometryDisplacementFunction(hgeom,displacementFunction);
+      rtcSetGeometryMaxDisplacement(hgeom,maxDisplacement);
+      rtcCommitGeometry(hgeom);
+      return geomID;
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* the reference scene invokes the displacement function at commit */
+      std::atomic<size_t> eagerCalls(0);
+      VerifyScene eagerScene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      addDisplacedPlane(eagerScene,&eagerCalls,inf);
+      rtcCommitScene(eagerScene);
+      AssertNoError(device);
+
+      /* with a displacement bound the displacement is deferred to traversal */
+      std::atomic<size_t> lazyCalls(0);
+      VerifyScene lazyScene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      unsigned geomID = addDisplacedPlane(lazyScene,&lazyCalls,0.25f);
+      rtcSetGeometryMaxDisplacement(rtcGetGeometry(lazyScene,geomID),-1.0f);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      rtcCommitScene(lazyScene);
+      AssertNoError(device);
+
+      bool passed = eagerCalls > 0 && lazyCalls == 0;
+      for (int y=-19; y<=19; y++)
+      {
+        for (int x=-19; x<=19; x++)
+        {
+          RTCRayHit ray0 = makeRay(Vec3fa(0.1f*x+0.01f,0.1f*y+0.01f,10.0f),Vec3fa(0,0,-1));
+          RTCRayHit ray1 = ray0;
+          rtcIntersect1(eagerScene,&ray0);
+          rtcIntersect1(lazyScene,&ray1);
+          passed &= ray0.hit.geomID == ray1.hit.geomID;
+          passed &= ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID || fabsf(ray0.ray.tfar-ray1.ray.tfar) < 1E-4f;
+        }
+      }
+      passed &= lazyCalls > 0;
+      AssertNoError(device);
+      
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct CurveSubsegmentsTest : public VerifyApplication::Test
+  {
+    CurveSubsegmentsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    unsigned addBentCurves(VerifyScene& scene, RTCDevice device, RTCGeometryType type, unsigned int maxSubsegments, const Vec3fa& pos)
+    {
+      const size_t numCurves = 16;
+      RTCGeometry geom = rtcNewGeometry(device, type);
+      Vec3ff* vertices = (Vec3ff*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT4, sizeof(Vec3ff), 4*numCurves);
+      unsigned int* indices = (unsigned int*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, sizeof(unsigned int), numCurves);
+      for (size_t i=0; i<numCurves; i++)
+      {
+        /* long, twisted U-shaped curve segments are bounded poorly by a single box */
+        const float z = 0.1f*float(i);
+        const float s = 1.0f+0.1f*float(i);
+        vertices[4*i+0] = Vec3ff(pos+Vec3fa(-s,-2.0f,z),0.05f);
+        vertices[4*i+1] = Vec3ff(pos+Vec3fa(-s,+4.0f,z+2.0f),0.05f);
+        vertices[4*i+2] = Vec3ff(pos+Vec3fa(+s,+4.0f,z-2.0f),0.05f);
+        vertices[4*i+3] = Vec3ff(pos+Vec3fa(+s,-2.0f,z),0.05f);
+        indices[i] = unsigned(4*i);
+      }
+      rtcSetGeometryMaxSubsegments(geom,maxSubsegments);
+      rtcSetGeometryTessellationRate(geom,16.0f); // keeps flat curves close to the exact curve
+      rtcCommitGeometry(geom);
+      unsigned int geomID = rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      return geomID;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const RTCGeometryType types[] = {
+        RTC_GEOMETRY_TYPE_ROUND_BEZIER_CURVE, RTC_GEOMETRY_TYPE_FLAT_BEZIER_CURVE,
+        RTC_GEOMETRY_TYPE_ROUND_BSPLINE_CURVE, RTC_GEOMETRY_TYPE_FLAT_CATMULL_ROM_CURVE
+      };
+
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<4; i++) {
+        const Vec3fa pos(0.0f,0.0f,4.0f*float(i));
+        addBentCurves(scene0,device,types[i],1,pos);
+        addBentCurves(scene1,device,types[i],8,pos);
+      }
+      rtcCommitScene(scene0);
+      rtcCommitScene(scene1);
+      AssertNoError(device);
+
+      /* splitting must not change the hits of round curves, while flat curves get
+       * tessellated per sub-segment and may deviate slightly from the unsplit curve
+       * near silhouettes */
+      bool passed = true;
+      size_t numHits = 0, numFlatDeviations = 0;
+      for (size_t i=0; i<4096; i++)
+      {
+        const Vec3fa org(8.0f*random_float()-4.0f,8.0f*random_float()-4.0f,-4.0f);
+        const Vec3fa dir = normalize(Vec3fa(0.2f*random_float()-0.1f,0.2f*random_float()-0.1f,1.0f));
+        RTCRayHit ray0 = makeRay(org,dir);
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&ray0);
+        rtcIntersect1(scene1,&ray1);
+        numHits += ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+
+        if (ray1.hit.geomID != RTC_INVALID_GEOMETRY_ID) {
+          RTCRay shadow = makeRay(org,dir).ray;
+          rtcOccluded1(scene1,&shadow);
+          passed &= shadow.tfar < 0.0f;
+        }
+
+        const unsigned int geomID = min(ray0.hit.geomID,ray1.hit.geomID);
+        if (geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        const bool flat = types[geomID] == RTC_GEOMETRY_TYPE_FLAT_BEZIER_CURVE || types[geomID] == RTC_GEOMETRY_TYPE_FLAT_CATMULL_ROM_CURVE;
+        const bool equal = ray0.hit.geomID == ray1.hit.geomID && ray0.hit.primID == ray1.hit.primID;
+        if (flat) {
+          numFlatDeviations += !equal || fabsf(ray0.hit.u-ray1.hit.u) > 0.05f;
+          continue;
+        }
+        passed &= equal;
+        passed &= fabsf(ray0.ray.tfar-ray1.ray.tfar) < 1E-2f;
+        passed &= fabsf(ray0.hit.u-ray1.hit.u) < 1E-3f;
+      }
+      passed &= numHits > 0;
+      passed &= numFlatDeviations < numHits/16;
+      
+      RTCGeometry hgeom = rtcGetGeometry(scene1,0);
+      rtcSetGeometryMaxSubsegments(hgeom,0);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      rtcSetGeometryMaxSubsegments(hgeom,9);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      
+      RTCGeometry triangles = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryMaxSubsegments(triangles,2);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+      rtcReleaseGeometry(triangles);
+      AssertNoError(device);
+      
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct DisableAndDetachGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -2122,6 +2356,136 @@ namespace embree
     }
   };
 
+  struct TessellationCacheStatsTest : public VerifyApplication::Test
+  {
+    TessellationCacheStatsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_SUBDIVISION);
+      AssertNoError(device);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, interpolation_quad_indices, 0, sizeof(unsigned int), num_interpolation_quad_faces*4);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_FACE,  0, RTC_FORMAT_UINT, interpolation_quad_faces,   0, sizeof(unsigned int), num_interpolation_quad_faces);
+      std::vector<float> vertices(3*num_interpolation_vertices+16);
+      for (size_t i=0; i<vertices.size(); i++) vertices[i] = random_float();
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices.data(), 0, 3*sizeof(float), num_interpolation_vertices);
+      rtcCommitGeometry(geom);
+      AssertNoError(device);
+
+      /* counters can only get reset */
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS,1);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS,0);
+      AssertNoError(device);
+
+      /* first evaluation of a patch misses, the second one hits */
+      float P[3];
+      rtcInterpolate1(geom,5,0.5f,0.5f,RTC_BUFFER_TYPE_VERTEX,0,P,nullptr,nullptr,3);
+      rtcInterpolate1(geom,5,0.25f,0.75f,RTC_BUFFER_TYPE_VERTEX,0,P,nullptr,nullptr,3);
+      AssertNoError(device);
+
+      bool passed = true;
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE) > 0;
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES) >= 1;
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS) >= 1;
+      AssertNoError(device);
+
+      rtcReleaseGeometry(geom);
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct InterpolateNSubdivTest : public VerifyApplication::Test
+  {
+    InterpolateNSubdivTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      const unsigned int V = 5; // crosses a SIMD slot boundary of the interpolation
+      
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_SUBDIVISION);
+      AssertNoError(device);
+      rtcSetGeometryVertexAttributeCount(geom,1);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, interpolation_quad_indices, 0, sizeof(unsigned int), num_interpolation_quad_faces*4);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_FACE,  0, RTC_FORMAT_UINT, interpolation_quad_faces,   0, sizeof(unsigned int), num_interpolation_quad_faces);
+      std::vector<float> vertices(3*num_interpolation_vertices+16);
+      for (size_t i=0; i<vertices.size(); i++) vertices[i] = random_float();
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices.data(), 0, 3*sizeof(float), num_interpolation_vertices);
+      std::vector<float> user_vertices(V*num_interpolation_vertices+16);
+      for (size_t i=0; i<user_vertices.size(); i++) user_vertices[i] = random_float();
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, 0, RTCFormat(RTC_FORMAT_FLOAT+V), user_vertices.data(), 0, V*sizeof(float), num_interpolation_vertices);
+      rtcCommitGeometry(geom);
+      AssertNoError(device);
+
+      /* queries in random primitive order, many of them on the same patch */
+      const unsigned int N = 300;
+      std::vector<int> valid(N);
+      std::vector<unsigned int> primIDs(N);
+      std::vector<float> u(N), v(N);
+      for (unsigned int i=0; i<N; i++) {
+        valid[i] = random_int() % 8 ? -1 : 0;
+        primIDs[i] = random_int() % num_interpolation_quad_faces;
+        u[i] = random_float();
+        v[i] = random_float();
+      }
+
+      std::vector<float> P(V*N,-1.0f), dPdu(V*N,-1.0f), dPdv(V*N,-1.0f);
+      RTCInterpolateNArguments args;
+      args.geometry = geom;
+      args.valid = valid.data();
+      args.primIDs = primIDs.data();
+      args.u = u.data();
+      args.v = v.data();
+      args.N = N;
+      args.bufferType = RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE;
+      args.bufferSlot = 0;
+      args.P = P.data();
+      args.dPdu = dPdu.data();
+      args.dPdv = dPdv.data();
+      args.ddPdudu = nullptr;
+      args.ddPdvdv = nullptr;
+      args.ddPdudv = nullptr;
+      args.valueCount = V;
+      rtcInterpolateN(&args);
+      AssertNoError(device);
+
+      /* batched results have to match single evaluations, invalid queries are untouched */
+      bool passed = true;
+      for (unsigned int i=0; i<N; i++)
+      {
+        float P1[V], dPdu1[V], dPdv1[V];
+        rtcInterpolate1(geom,primIDs[i],u[i],v[i],RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE,0,P1,dPdu1,dPdv1,V);
+        for (unsigned int j=0; j<V; j++)
+        {
+          if (valid[i] == 0) {
+            passed &= P[j*N+i] == -1.0f && dPdu[j*N+i] == -1.0f && dPdv[j*N+i] == -1.0f;
+          } else {
+            passed &= fabsf(P[j*N+i]-P1[j]) < 1E-4f;
+            passed &= fabsf(dPdu[j*N+i]-dPdu1[j]) < 1E-3f;
+            passed &= fabsf(dPdv[j*N+i]-dPdv1[j]) < 1E-3f;
+          }
+        }
+      }
+      AssertNoError(device);
+
+      rtcReleaseGeometry(geom);
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct InterpolateTrianglesTest : public VerifyApplication::Test
   {
     size_t N;
@@ -2699,34 +3063,678 @@ namespace embree
       }
       AssertNoError(device);
 
-      return (VerifyApplication::TestReturnValue) passed;
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct BackfaceCullingFlagTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+    GeometryType gtype;
+    std::string tri_accel;
+
+    BackfaceCullingFlagTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, GeometryType gtype, IntersectMode imode, IntersectVariant ivariant, std::string tri_accel = "")
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), gtype(gtype), tri_accel(tri_accel) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      if (tri_accel != "") cfg += ",tri_accel="+tri_accel;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+       
+      /* create geometry that is front facing for a right handed 
+         coordinate system if looking along the z direction */
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+      const Vec3fa p0 = Vec3fa(0.0f);
+      const Vec3fa dx = Vec3fa(0.0f,1.0f,0.0f);
+      const Vec3fa dy = Vec3fa(1.0f,0.0f,0.0f);
+      switch (gtype) {
+      case TRIANGLE_MESH: scene.addGeometry(quality,SceneGraph::createTrianglePlane(p0,dx,dy,1,1)); break;
+      case QUAD_MESH:     scene.addGeometry(quality,SceneGraph::createQuadPlane(p0,dx,dy,1,1)); break;
+      default:            throw std::runtime_error("unsupported geometry type: "+to_string(gtype)); 
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* the flag is only guaranteed to be honored by the default acceleration structures */
+      const bool cullingEnabled = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_BACKFACE_CULLING_ENABLED);
+      const bool specialized = (sflags.sflags & (RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT)) == 0;
+
+      bool passed = true;
+      for (unsigned int cull=0; cull<2; cull++)
+      {
+        RTCIntersectArguments args;
+        rtcInitIntersectArguments(&args);
+        if (cull) args.flags = (RTCRayQueryFlags) (args.flags | RTC_RAY_QUERY_FLAG_CULL_BACKFACES);
+
+        const size_t numRays = 256;
+        RTCRayHit rays[numRays];
+        for (size_t i=0; i<numRays; i++) {
+          const float rx = random_float();
+          const float ry = random_float();
+          if (i%2) rays[i] = makeRay(Vec3fa(rx,ry,+1),Vec3fa(0,0,-1)); 
+          else     rays[i] = makeRay(Vec3fa(rx,ry,-1),Vec3fa(0,0,+1)); 
+        }
+        IntersectWithMode(imode,ivariant,scene,rays,numRays,&args);
+      
+        for (size_t i=0; i<numRays; i++) 
+        {
+          const bool hit = (ivariant & VARIANT_INTERSECT) ? (rays[i].hit.geomID == 0) : (rays[i].ray.tfar == float(neg_inf));
+          if (i%2 == 0) passed &= hit;
+          else if (cullingEnabled) passed &= !hit;
+          else if (!cull) passed &= hit;
+          else if (specialized) passed &= !hit;
+        }
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct IntersectionFilterTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+    bool subdiv;
+
+    IntersectionFilterTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, bool subdiv, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), subdiv(subdiv) {}
+    
+    static void intersectionFilterN(const RTCFilterFunctionNArguments* const args)
+    {
+      if ((size_t)args->geometryUserPtr != 123) 
+        return;
+
+      for (unsigned int i=0; i<args->N; i++)
+      {
+	if (args->valid[i] != -1) continue;
+
+        /* reject hit */
+        if (RTCHitN_primID(args->hit,args->N,i) & 2) {
+          args->valid[i] = 0;
+        }
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,sflags);
+      Vec3fa p0(-0.75f,-0.25f,-10.0f), dx(4,0,0), dy(0,4,0);
+      unsigned int geomID0 = 0;
+      if (subdiv) geomID0 = scene.addSubdivPlane (sampler,quality, 4, p0, dx, dy).first;
+      else        geomID0 = scene.addPlane       (sampler,quality, 4, p0, dx, dy).first;
+      RTCGeometry geom0 = rtcGetGeometry(scene,geomID0);
+      rtcSetGeometryUserData(geom0,(void*)123);
+      rtcSetGeometryIntersectFilterFunction (geom0,intersectionFilterN);
+      rtcSetGeometryOccludedFilterFunction (geom0,intersectionFilterN);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+      
+      RTCRayHit rays[16];
+      for (unsigned int iy=0; iy<4; iy++) 
+      {
+        for (unsigned int ix=0; ix<4; ix++) 
+        {
+          //unsigned int primID = iy*4+ix;
+          //if (!subdiv) primID *= 2;
+          rays[iy*4+ix] = makeRay(Vec3fa(float(ix),float(iy),0.0f),Vec3fa(0,0,-1));
+        }
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,16);
+      
+      bool passed = true;
+      for (unsigned int iy=0; iy<4; iy++) 
+      {
+        for (unsigned int ix=0; ix<4; ix++) 
+        {
+          unsigned int primID = iy*4+ix;
+          if (!subdiv) primID *= 2;
+          RTCRayHit& ray = rays[iy*4+ix];
+          bool ok = true;
+          if (ivariant & VARIANT_INTERSECT)
+            ok = (primID & 2) ? (ray.hit.geomID == RTC_INVALID_GEOMETRY_ID) : (ray.hit.geomID == 0);
+          else
+            ok = ((primID & 2) != 0) == (ray.ray.tfar != float(neg_inf));
+          if (!ok) passed = false;
+        }
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct FeatureMaskTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    FeatureMaskTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    static void intersectionFilterN(const RTCFilterFunctionNArguments* const args)
+    {
+      for (unsigned int i=0; i<args->N; i++)
+      {
+	if (args->valid[i] != -1) continue;
+
+        /* reject hit */
+        if (RTCHitN_primID(args->hit,args->N,i) & 2) {
+          args->valid[i] = 0;
+        }
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* all geometries share the same mask, thus the scene qualifies for the nofilter intersectors */
+      VerifyScene scene(device,sflags);
+      Vec3fa p0(-0.75f,-0.25f,-10.0f), dx(4,0,0), dy(0,4,0);
+      unsigned int geomID0 = scene.addPlane(sampler,quality, 4, p0, dx, dy).first;
+      RTCGeometry geom0 = rtcGetGeometry(scene,geomID0);
+      rtcSetGeometryMask(geom0,2);
+      rtcSetGeometryIntersectFilterFunction (geom0,intersectionFilterN);
+      rtcSetGeometryOccludedFilterFunction (geom0,intersectionFilterN);
+      rtcCommitGeometry(geom0);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* only the default triangle layout has specialized intersectors,
+         for other configurations the filter may still get invoked */
+      const bool specialized = (sflags.sflags & (RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT)) == 0;
+
+      bool passed = true;
+      for (unsigned int useFilter=0; useFilter<2; useFilter++)
+      {
+        for (unsigned int rayMask=1; rayMask<4; rayMask++)
+        {
+          RTCIntersectArguments args;
+          rtcInitIntersectArguments(&args);
+          if (!useFilter)
+            args.feature_mask = (RTCFeatureFlags) (RTC_FEATURE_FLAG_ALL & ~RTC_FEATURE_FLAG_FILTER_FUNCTION);
+
+          RTCRayHit rays[16];
+          for (unsigned int iy=0; iy<4; iy++) {
+            for (unsigned int ix=0; ix<4; ix++) {
+              rays[iy*4+ix] = makeRay(Vec3fa(float(ix),float(iy),0.0f),Vec3fa(0,0,-1));
+              rays[iy*4+ix].ray.mask = rayMask;
+            }
+          }
+          IntersectWithMode(imode,ivariant,scene,rays,16,&args);
+
+          for (unsigned int iy=0; iy<4; iy++) 
+          {
+            for (unsigned int ix=0; ix<4; ix++) 
+            {
+              const unsigned int primID = 2*(iy*4+ix);
+              const bool filtered = primID & 2;
+              RTCRayHit& ray = rays[iy*4+ix];
+              const bool hit = (ivariant & VARIANT_INTERSECT) ? (ray.hit.geomID == geomID0) : (ray.ray.tfar == float(neg_inf));
+
+              bool expected = (rayMask & 2) != 0;
+              if (expected && filtered) {
+                if (useFilter) expected = false;
+                else if (!specialized) expected = hit;
+              }
+              passed &= hit == expected;
+            }
+          }
+        }
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct SceneStatisticsTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    SceneStatisticsTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    static void acceptAllFilterN(const RTCFilterFunctionNArguments* const args) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,sflags);
+      Vec3fa p0(-0.75f,-0.25f,-10.0f), dx(4,0,0), dy(0,4,0);
+      unsigned int geomID0 = scene.addPlane(sampler,quality, 4, p0, dx, dy).first;
+      RTCGeometry geom0 = rtcGetGeometry(scene,geomID0);
+      rtcSetGeometryIntersectFilterFunction (geom0,acceptAllFilterN);
+      rtcSetGeometryOccludedFilterFunction (geom0,acceptAllFilterN);
+      rtcCommitGeometry(geom0);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      auto trace = [&] ()
+      {
+        RTCRayHit rays[16];
+        for (unsigned int iy=0; iy<4; iy++) 
+          for (unsigned int ix=0; ix<4; ix++) 
+            rays[iy*4+ix] = makeRay(Vec3fa(float(ix),float(iy),0.0f),Vec3fa(0,0,-1));
+        IntersectWithMode(imode,ivariant,scene,rays,16);
+      };
+      const size_t numQueries = ((ivariant & VARIANT_INTERSECT_OCCLUDED) == VARIANT_INTERSECT_OCCLUDED) ? 2 : 1;
+
+      bool passed = true;
+      RTCSceneStatistics stats;
+
+      /* nothing is counted while disabled */
+      trace();
+      rtcGetSceneStatistics(scene,&stats);
+      passed &= stats.numRays == 0 && stats.numNodes == 0 && stats.numLeaves == 0 && stats.numFilterCalls == 0;
+
+      /* every ray enters traversal and hits the plane */
+      rtcSetSceneEnableStatistics(scene,true);
+      trace();
+      rtcGetSceneStatistics(scene,&stats);
+      passed &= stats.numRays == 16*numQueries;
+      passed &= stats.numLeaves > 0 && stats.numFilterCalls >= 16*numQueries;
+
+      /* counters accumulate until reset */
+      trace();
+      RTCSceneStatistics stats2;
+      rtcGetSceneStatistics(scene,&stats2);
+      passed &= stats2.numRays == 2*stats.numRays && stats2.numLeaves == 2*stats.numLeaves;
+
+      rtcResetSceneStatistics(scene);
+      rtcGetSceneStatistics(scene,&stats);
+      passed &= stats.numRays == 0 && stats.numNodes == 0 && stats.numLeaves == 0 && stats.numFilterCalls == 0;
+
+      /* per query statistics get counted into the struct passed through the arguments */
+      RTCSceneStatistics qstats = { 0, 0, 0, 0 };
+      RTCIntersectArguments args;
+      rtcInitIntersectArguments(&args);
+      args.stats = &qstats;
+      RTCRayHit ray = makeRay(Vec3fa(1.0f,1.0f,0.0f),Vec3fa(0,0,-1));
+      rtcIntersect1(scene,&ray,&args);
+      passed &= qstats.numRays == 1 && qstats.numLeaves > 0 && qstats.numFilterCalls >= 1;
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct IgnorePrimitiveTest : public VerifyApplication::Test
+  {
+    GeometryType gtype;
+    bool instanced;
+    IntersectMode imode;
+
+    IgnorePrimitiveTest (std::string name, int isa, GeometryType gtype, bool instanced, IntersectMode imode)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), gtype(gtype), instanced(instanced), imode(imode) {}
+
+    struct IgnoreQueryContext {
+      RTCRayQueryContext context;
+      unsigned int ignorePrimID;
+      size_t numIgnoredFilterCalls;
+    };
+
+    static void countIgnoredFilterN(const RTCFilterFunctionNArguments* const args)
+    {
+      IgnoreQueryContext* context = (IgnoreQueryContext*) args->context;
+      for (unsigned int i=0; i<args->N; i++)
+        if (args->valid[i] && RTCHitN_primID(args->hit,args->N,i) == context->ignorePrimID)
+          context->numIgnoredFilterCalls++;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene mesh_scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      unsigned int geomID = 0;
+      switch (gtype) {
+      case TRIANGLE_MESH: geomID = mesh_scene.addSphere    (sampler,RTC_BUILD_QUALITY_MEDIUM,zero,1.0f,50).first; break;
+      case QUAD_MESH    : geomID = mesh_scene.addQuadSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,zero,1.0f,50).first; break;
+      case GRID_MESH    : geomID = mesh_scene.addGridSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,zero,1.0f,4).first; break;
+      default           : return VerifyApplication::FAILED;
+      }
+      RTCGeometry geom = rtcGetGeometry(mesh_scene,geomID);
+      rtcSetGeometryIntersectFilterFunction(geom,countIgnoredFilterN);
+      rtcSetGeometryOccludedFilterFunction(geom,countIgnoredFilterN);
+      rtcCommitGeometry(geom);
+      rtcCommitScene(mesh_scene);
+
+      VerifyScene instance_scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      if (instanced) {
+        RTCGeometry instance = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(instance,mesh_scene);
+        rtcCommitGeometry(instance);
+        rtcAttachGeometry(instance_scene,instance);
+        rtcReleaseGeometry(instance);
+        rtcCommitScene(instance_scene);
+      }
+      RTCScene scene = instanced ? (RTCScene) instance_scene : (RTCScene) mesh_scene;
+      AssertNoError(device);
+
+      /* the ignored primitive is shared by all rays of a packet, thus each packet starts at the same hit point */
+      const unsigned int K = imode == MODE_INTERSECT1 ? 1 : imode == MODE_INTERSECT4 ? 4 : imode == MODE_INTERSECT8 ? 8 : 16;
+      RTCRayHit rays[16];
+
+      for (size_t i=0; i<256; i++)
+      {
+        /* primary ray towards the sphere center */
+        const Vec3fa org = 4.0f*normalize(random_Vec3fa()-Vec3fa(0.5f));
+        const Vec3fa dir = normalize(0.1f*(random_Vec3fa()-Vec3fa(0.5f))-org);
+        RTCRayHit primary = makeRay(org,dir);
+        rtcIntersect1(scene,&primary);
+        if (primary.hit.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+
+        const Vec3fa p = org + primary.ray.tfar*dir;
+        Vec3fa Ng = normalize(Vec3fa(primary.hit.Ng_x,primary.hit.Ng_y,primary.hit.Ng_z));
+        if (dot(Ng,dir) > 0.0f) Ng = -Ng;
+
+        IgnoreQueryContext context;
+        rtcInitRayQueryContext(&context.context);
+        context.ignorePrimID = primary.hit.primID;
+        context.numIgnoredFilterCalls = 0;
+
+        RTCIntersectArguments iargs;
+        rtcInitIntersectArguments(&iargs);
+        iargs.context = &context.context;
+        iargs.ignoreGeomID = primary.hit.geomID;
+        iargs.ignorePrimID = primary.hit.primID;
+        for (unsigned int l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          iargs.ignoreInstID[l] = primary.hit.instID[l];
+
+        /* transmitted rays starting exactly at the hit point have to pass the ignored primitive */
+        for (unsigned int k=0; k<K; k++)
+          rays[k] = makeRay(p,normalize(dir+0.01f*(random_Vec3fa()-Vec3fa(0.5f))));
+        IntersectWithMode(imode,VARIANT_INTERSECT,scene,rays,K,&iargs);
+        for (unsigned int k=0; k<K; k++) {
+          if (rays[k].hit.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          if (rays[k].hit.primID == primary.hit.primID) return VerifyApplication::FAILED;
+          if (rays[k].ray.tfar < 0.1f) return VerifyApplication::FAILED;
+        }
+
+        /* shadow rays leaving the convex sphere from the offset hit point are not occluded */
+        float hit_p[3] = { p.x, p.y, p.z };
+        float hit_Ng[3] = { Ng.x, Ng.y, Ng.z };
+        float shadow_org[3];
+        rtcOffsetRayOrigin(hit_p,hit_Ng,shadow_org);
+
+        for (unsigned int k=0; k<K; k++)
+          rays[k] = makeRay(Vec3fa(shadow_org[0],shadow_org[1],shadow_org[2]),normalize(-dir+0.01f*(random_Vec3fa()-Vec3fa(0.5f))));
+        IntersectWithMode(imode,VARIANT_OCCLUDED,scene,rays,K,&iargs);
+        for (unsigned int k=0; k<K; k++)
+          if (rays[k].ray.tfar < 0.0f) return VerifyApplication::FAILED;
+
+        /* the ignored primitive never reaches the filter functions */
+        if (context.numIgnoredFilterCalls) return VerifyApplication::FAILED;
+
+        /* ignoring a different instance does not skip the primitive */
+        if (instanced) {
+          iargs.ignoreInstID[0] = 1;
+          for (unsigned int k=0; k<K; k++)
+            rays[k] = makeRay(org,dir);
+          IntersectWithMode(imode,VARIANT_INTERSECT,scene,rays,K,&iargs);
+          for (unsigned int k=0; k<K; k++)
+            if (rays[k].hit.primID != primary.hit.primID) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct MultiHitTest : public VerifyApplication::Test
+  {
+    RTCBuildQuality quality;
+    unsigned int maxHits;
+
+    MultiHitTest (std::string name, int isa, RTCBuildQuality quality, unsigned int maxHits)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), quality(quality), maxHits(maxHits) {}
+
+    struct MultiHitQueryContext {
+      RTCRayQueryContext context;
+      unsigned int rejectGeomID;
+    };
+
+    static void rejectGeometryFilterN(const RTCFilterFunctionNArguments* const args)
+    {
+      MultiHitQueryContext* context = (MultiHitQueryContext*) args->context;
+      for (unsigned int i=0; i<args->N; i++)
+        if (RTCHitN_geomID(args->hit,args->N,i) == context->rejectGeomID)
+          args->valid[i] = 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* stack of triangle and quad planes attached in shuffled depth order */
+      const unsigned int numPlanes = 10;
+      std::vector<unsigned int> planeOfDepth(numPlanes);
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_FILTER_FUNCTION_IN_ARGUMENTS,quality));
+      for (unsigned int i=0; i<numPlanes; i++)
+      {
+        const unsigned int depth = (7*i) % numPlanes;
+        const Vec3fa p0(-10.0f,-10.0f,-1.0f-float(depth)), dx(20,0,0), dy(0,20,0);
+        if (i%2) planeOfDepth[depth] = scene.addGeometry2(quality,SceneGraph::createQuadPlane(p0,dx,dy,4,4)).first;
+        else     planeOfDepth[depth] = scene.addPlane(sampler,quality,4,p0,dx,dy).first;
+      }
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      std::vector<float> tfar(maxHits);
+      std::vector<RTCHit> hits(maxHits);
+      RTCMultiHitBuffer buffer;
+      buffer.maxHits = maxHits;
+      buffer.numHits = 0;
+      buffer.tfar = tfar.data();
+      buffer.hit = hits.data();
+
+      MultiHitQueryContext context;
+      rtcInitRayQueryContext(&context.context);
+      context.rejectGeomID = RTC_INVALID_GEOMETRY_ID;
+
+      RTCIntersectArguments args;
+      rtcInitIntersectArguments(&args);
+      args.context = &context.context;
+      args.multiHit = &buffer;
+
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa org(8.0f*random_float()-4.0f,8.0f*random_float()-4.0f,0.0f);
+        const Vec3fa dir = normalize(Vec3fa(0.2f*random_float()-0.1f,0.2f*random_float()-0.1f,-1.0f));
+
+        /* all planes are collected front to back exactly once, even with spatial split references */
+        RTCRayHit ray = makeRay(org,dir);
+        rtcIntersect1(scene,&ray,&args);
+        const unsigned int expected = std::min(maxHits,numPlanes);
+        if (buffer.numHits != expected) return VerifyApplication::FAILED;
+        for (unsigned int j=0; j<expected; j++) {
+          if (hits[j].geomID != planeOfDepth[j]) return VerifyApplication::FAILED;
+          if (j > 0 && !(tfar[j-1] < tfar[j])) return VerifyApplication::FAILED;
+        }
+
+        /* the ray reports the closest hit like a regular query */
+        RTCRayHit reference = makeRay(org,dir);
+        rtcIntersect1(scene,&reference);
+        if (ray.hit.geomID != reference.hit.geomID || ray.hit.primID != reference.hit.primID) return VerifyApplication::FAILED;
+        if (ray.ray.tfar != reference.ray.tfar || tfar[0] != reference.ray.tfar) return VerifyApplication::FAILED;
+
+        /* hits rejected by the filter function are not collected */
+        context.rejectGeomID = planeOfDepth[0];
+        args.filter = rejectGeometryFilterN;
+        args.flags = RTC_RAY_QUERY_FLAG_INVOKE_ARGUMENT_FILTER;
+        RTCRayHit filtered = makeRay(org,dir);
+        rtcIntersect1(scene,&filtered,&args);
+        args.filter = nullptr;
+        args.flags = RTC_RAY_QUERY_FLAG_INCOHERENT;
+        context.rejectGeomID = RTC_INVALID_GEOMETRY_ID;
+        if (buffer.numHits != std::min(maxHits,numPlanes-1)) return VerifyApplication::FAILED;
+        if (hits[0].geomID != planeOfDepth[1] || filtered.hit.geomID != planeOfDepth[1]) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      /* ray packets do not support multi hit queries */
+      RTCRayHit4 ray4;
+      __aligned(16) int valid4[4] = { -1,-1,-1,-1 };
+      for (size_t j=0; j<4; j++) setRay(ray4,j,makeRay(Vec3fa(0.0f),Vec3fa(0,0,-1)));
+      rtcIntersect4(valid4,scene,&ray4,&args);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct DeferredSceneTest : public VerifyApplication::Test
+  {
+    bool parallel;
+
+    DeferredSceneTest (std::string name, int isa, bool parallel)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), parallel(parallel) {}
+
+    struct DeferredChild
+    {
+      RTCDevice device;
+      Ref<SceneGraph::TriangleMeshNode> mesh;
+      unsigned int geomID = RTC_INVALID_GEOMETRY_ID;
+      std::atomic<size_t> numBuilds{0};
+      std::atomic<size_t> numEvicts{0};
+    };
+
+    static void deferredSceneFunc(void* userPtr, RTCScene scene, RTCDeferredSceneEvent event)
+    {
+      DeferredChild* child = (DeferredChild*) userPtr;
+      if (event == RTC_DEFERRED_SCENE_EVENT_BUILD)
+      {
+        child->numBuilds++;
+        RTCGeometry geom = rtcNewGeometry(child->device, RTC_GEOMETRY_TYPE_TRIANGLE);
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,child->mesh->triangles.data(),0,sizeof(SceneGraph::TriangleMeshNode::Triangle),child->mesh->triangles.size());
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,child->mesh->positions[0].data(),0,sizeof(SceneGraph::TriangleMeshNode::Vertex),child->mesh->positions[0].size());
+        rtcCommitGeometry(geom);
+        child->geomID = rtcAttachGeometry(scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      else if (event == RTC_DEFERRED_SCENE_EVENT_EVICT)
+      {
+        child->numEvicts++;
+        rtcDetachGeometry(scene,child->geomID);
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* unit spheres instanced along the x axis, each populated on first access */
+      const size_t numChildren = 4;
+      Ref<SceneGraph::TriangleMeshNode> mesh = SceneGraph::createTriangleSphere(zero,1.0f,20).dynamicCast<SceneGraph::TriangleMeshNode>();
+      RTCBounds bounds = { -1.1f,-1.1f,-1.1f,0.0f, +1.1f,+1.1f,+1.1f,0.0f };
+
+      DeferredChild children[numChildren];
+      std::vector<Ref<VerifyScene>> child_scenes;
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<numChildren; i++)
+      {
+        children[i].device = device;
+        children[i].mesh = mesh;
+        child_scenes.push_back(new VerifyScene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM)));
+        rtcSetSceneDeferred(*child_scenes[i],&bounds,deferredSceneFunc,&children[i]);
+
+        AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(4.0f*float(i),0.0f,0.0f));
+        RTCGeometry instance = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(instance,*child_scenes[i]);
+        rtcSetGeometryTransform(instance,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+        rtcCommitGeometry(instance);
+        rtcAttachGeometryByID(scene,instance,(unsigned int)i);
+        rtcReleaseGeometry(instance);
+      }
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* committing the parent scene does not build the children */
+      for (size_t i=0; i<numChildren; i++)
+        if (children[i].numBuilds != 0) return VerifyApplication::FAILED;
+
+      std::atomic<size_t> numFailed(0);
+      auto traceChild = [&] (size_t child, size_t numRays)
+      {
+        auto trace = [&] (size_t j) {
+          RandomSampler ray_sampler;
+          RandomSampler_init(ray_sampler, (int)j);
+          const Vec3fa org(4.0f*float(child)+0.5f*RandomSampler_get1D(ray_sampler)-0.25f,0.5f*RandomSampler_get1D(ray_sampler)-0.25f,4.0f);
+          RTCRayHit ray = makeRay(org,Vec3fa(0,0,-1));
+          rtcIntersect1(scene,&ray);
+          if (ray.hit.instID[0] != child || ray.hit.geomID != children[child].geomID || std::abs(ray.ray.tfar-3.0f) > 0.1f)
+            numFailed++;
+          RTCRay shadow = makeRay(org,Vec3fa(0,0,-1)).ray;
+          rtcOccluded1(scene,&shadow);
+          if (shadow.tfar >= 0.0f)
+            numFailed++;
+        };
+        if (parallel) parallel_for(numRays,trace);
+        else for (size_t j=0; j<numRays; j++) trace(j);
+      };
+
+      /* rays entering two of the children build each of them exactly once */
+      traceChild(0,256);
+      traceChild(1,256);
+      AssertNoError(device);
+      if (numFailed) return VerifyApplication::FAILED;
+      if (children[0].numBuilds != 1 || children[1].numBuilds != 1) return VerifyApplication::FAILED;
+      if (children[2].numBuilds != 0 || children[3].numBuilds != 0) return VerifyApplication::FAILED;
+
+      /* usage is reported once per access period */
+      if (!rtcGetSceneUsed(*child_scenes[0]) || !rtcGetSceneUsed(*child_scenes[1])) return VerifyApplication::FAILED;
+      if (rtcGetSceneUsed(*child_scenes[0]) || rtcGetSceneUsed(*child_scenes[2])) return VerifyApplication::FAILED;
+      if (rtcGetSceneUsed(scene)) return VerifyApplication::FAILED;
+
+      /* evicted children get rebuilt on the next access, unbuilt children are not evicted */
+      rtcEvictScene(*child_scenes[0]);
+      rtcEvictScene(*child_scenes[2]);
+      AssertNoError(device);
+      if (children[0].numEvicts != 1 || children[2].numEvicts != 0) return VerifyApplication::FAILED;
+
+      traceChild(0,64);
+      traceChild(2,64);
+      AssertNoError(device);
+      if (numFailed) return VerifyApplication::FAILED;
+      if (children[0].numBuilds != 2 || children[1].numBuilds != 1 || children[2].numBuilds != 1) return VerifyApplication::FAILED;
+
+      /* only deferred scenes can get evicted */
+      rtcEvictScene(scene);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      return VerifyApplication::PASSED;
     }
   };
 
-  struct IntersectionFilterTest : public VerifyApplication::IntersectTest
+  struct SceneBuildStatisticsTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
     RTCBuildQuality quality;
-    bool subdiv;
-
-    IntersectionFilterTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, bool subdiv, IntersectMode imode, IntersectVariant ivariant)
-      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), subdiv(subdiv) {}
-    
-    static void intersectionFilterN(const RTCFilterFunctionNArguments* const args)
-    {
-      if ((size_t)args->geometryUserPtr != 123) 
-        return;
-
-      for (unsigned int i=0; i<args->N; i++)
-      {
-	if (args->valid[i] != -1) continue;
 
-        /* reject hit */
-        if (RTCHitN_primID(args->hit,args->N,i) & 2) {
-          args->valid[i] = 0;
-        }
-      }
-    }
+    SceneBuildStatisticsTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
 
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
@@ -2734,48 +3742,36 @@ namespace embree
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
 
-      VerifyScene scene(device,sflags);
-      Vec3fa p0(-0.75f,-0.25f,-10.0f), dx(4,0,0), dy(0,4,0);
-      unsigned int geomID0 = 0;
-      if (subdiv) geomID0 = scene.addSubdivPlane (sampler,quality, 4, p0, dx, dy).first;
-      else        geomID0 = scene.addPlane       (sampler,quality, 4, p0, dx, dy).first;
-      RTCGeometry geom0 = rtcGetGeometry(scene,geomID0);
-      rtcSetGeometryUserData(geom0,(void*)123);
-      rtcSetGeometryIntersectFilterFunction (geom0,intersectionFilterN);
-      rtcSetGeometryOccludedFilterFunction (geom0,intersectionFilterN);
-      rtcCommitScene (scene);
-      AssertNoError(device);
-      
-      RTCRayHit rays[16];
-      for (unsigned int iy=0; iy<4; iy++) 
-      {
-        for (unsigned int ix=0; ix<4; ix++) 
-        {
-          //unsigned int primID = iy*4+ix;
-          //if (!subdiv) primID *= 2;
-          rays[iy*4+ix] = makeRay(Vec3fa(float(ix),float(iy),0.0f),Vec3fa(0,0,-1));
-        }
-      }
-      IntersectWithMode(imode,ivariant,scene,rays,16);
-      
       bool passed = true;
-      for (unsigned int iy=0; iy<4; iy++) 
-      {
-        for (unsigned int ix=0; ix<4; ix++) 
-        {
-          unsigned int primID = iy*4+ix;
-          if (!subdiv) primID *= 2;
-          RTCRayHit& ray = rays[iy*4+ix];
-          bool ok = true;
-          if (ivariant & VARIANT_INTERSECT)
-            ok = (primID & 2) ? (ray.hit.geomID == RTC_INVALID_GEOMETRY_ID) : (ray.hit.geomID == 0);
-          else
-            ok = ((primID & 2) != 0) == (ray.ray.tfar != float(neg_inf));
-          if (!ok) passed = false;
-        }
-      }
+      RTCSceneBuildStatistics stats;
+
+      /* nothing is gathered while disabled */
+      VerifyScene scene0(device,sflags);
+      scene0.addSphere(sampler,quality,zero,1.0f,50);
+      rtcCommitScene (scene0);
+      rtcGetSceneBuildStatistics(scene0,&stats);
+      passed &= stats.numBuilds == 0 && stats.numNodes == 0 && stats.commitTime == 0.0;
       AssertNoError(device);
 
+      /* the report describes the BVH of the last commit */
+      VerifyScene scene1(device,sflags);
+      rtcSetSceneEnableStatistics(scene1,true);
+      scene1.addSphere(sampler,quality,zero,1.0f,50);
+      scene1.addSphere(sampler,quality,Vec3fa(4,0,0),1.0f,50);
+      rtcCommitScene (scene1);
+      rtcGetSceneBuildStatistics(scene1,&stats);
+      AssertNoError(device);
+
+      const size_t nodeBytes = stats.nodeBytesAABB + stats.nodeBytesMotionBlur + stats.nodeBytesOBB + stats.nodeBytesQuantized;
+      passed &= stats.numBuilds >= 1;
+      passed &= stats.numPrimitives > 0;
+      passed &= stats.numNodes > 0 && nodeBytes > 0;
+      passed &= stats.numLeaves > 0 && stats.leafBytes > 0;
+      passed &= stats.allocatorBytesUsed >= nodeBytes;
+      passed &= stats.commitTime > 0.0 && stats.sah > 0.0;
+      passed &= stats.primRefTime + stats.presplitTime + stats.topLevelTime > 0.0;
+      passed &= stats.hierarchyTime + stats.topLevelTime > 0.0;
+
       return (VerifyApplication::TestReturnValue) passed;
     }
   };
@@ -2883,6 +3879,95 @@ namespace embree
     }
   };
 
+  struct InstanceOriginTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    unsigned int numTimeSteps;
+
+    InstanceOriginTest (std::string name, int isa, SceneFlags sflags, unsigned int numTimeSteps, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), numTimeSteps(numTimeSteps) {}
+
+    /* moves the instance by 0.5 along x per time step */
+    void setTransforms(RTCGeometry instance)
+    {
+      if (numTimeSteps == 1) return;
+      rtcSetGeometryTimeStepCount(instance,numTimeSteps);
+      for (unsigned int t=0; t<numTimeSteps; t++) {
+        const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(0.5f*t,0.0f,0.0f));
+        rtcSetGeometryTransform(instance,t,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene bl_scene(device,sflags);
+      bl_scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(0,0,0),1.0f,50);
+      rtcCommitScene(bl_scene);
+
+      /* reference instance at the world space origin */
+      VerifyScene scene0(device,sflags);
+      RTCGeometry instance0 = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(instance0,bl_scene);
+      setTransforms(instance0);
+      rtcCommitGeometry(instance0);
+      rtcAttachGeometry(scene0,instance0);
+      rtcReleaseGeometry(instance0);
+      rtcCommitScene(scene0);
+
+      /* instance placed far away using a double precision origin, all coordinates are multiples of 1/16 */
+      const double ox = 1000000.5, oy = -200000.25, oz = 300000.0;
+      VerifyScene scene1(device,sflags);
+      RTCGeometry instance1 = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(instance1,bl_scene);
+      rtcSetGeometryTransformOrigin(instance1,ox,oy,oz);
+      setTransforms(instance1);
+      rtcCommitGeometry(instance1);
+      rtcAttachGeometry(scene1,instance1);
+      rtcCommitScene(scene1);
+      AssertNoError(device);
+
+      float xfm[12];
+      rtcGetGeometryTransform(instance1,0.0f,RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR,xfm);
+      if (xfm[9] != float(ox) || xfm[10] != float(oy) || xfm[11] != float(oz)) return VerifyApplication::FAILED;
+      RTCBounds bounds; rtcGetSceneBounds(scene1,&bounds);
+      const double dx = 0.5*(numTimeSteps-1);
+      if (bounds.lower_x > float(ox-1.0) || bounds.upper_x < float(ox+dx+1.0)) return VerifyApplication::FAILED;
+      if (bounds.lower_x < float(ox-2.0) || bounds.upper_x > float(ox+dx+2.0)) return VerifyApplication::FAILED;
+
+      /* rays rebased to the origin have to produce the same hits as the reference */
+      const size_t numRays = 256;
+      RTCRayHit rays0[numRays];
+      RTCRayHit rays1[numRays];
+      for (size_t i=0; i<numRays; i++) {
+        const Vec3fa org(floorf(32.0f*random_float()-16.0f)/16.0f,floorf(32.0f*random_float()-16.0f)/16.0f,-4.0f);
+        const Vec3fa dir = Vec3fa(0,0,1) + 0.2f*(random_Vec3fa()-Vec3fa(0.5f));
+        rays0[i] = makeRay(org,dir);
+        rays1[i] = makeRay(org+Vec3fa(float(ox),float(oy),float(oz)),dir);
+        rays0[i].ray.time = rays1[i].ray.time = floorf(16.0f*random_float())/16.0f;
+      }
+      IntersectWithMode(imode,ivariant,scene0,rays0,numRays);
+      IntersectWithMode(imode,ivariant,scene1,rays1,numRays);
+      rtcReleaseGeometry(instance1);
+      AssertNoError(device);
+
+      for (size_t i=0; i<numRays; i++)
+      {
+        if (ivariant & VARIANT_INTERSECT) {
+          if (rays0[i].hit.geomID != rays1[i].hit.geomID) return VerifyApplication::FAILED;
+          if (rays0[i].hit.primID != rays1[i].hit.primID) return VerifyApplication::FAILED;
+          if (rays0[i].ray.tfar != rays1[i].ray.tfar) return VerifyApplication::FAILED;
+        }
+        else if (rays0[i].ray.tfar != rays1[i].ray.tfar)
+          return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
   #if defined(EMBREE_GEOMETRY_INSTANCE_ARRAY)
 
   struct InstanceArrayTest : public VerifyApplication::IntersectTest
@@ -3906,6 +4991,121 @@ namespace embree
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
   
+  struct QuantizedNodeIntersectTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    std::string tri_accel;
+
+    QuantizedNodeIntersectTest (std::string name, int isa, SceneFlags sflags, std::string tri_accel, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), tri_accel(tri_accel) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + ",tri_accel="+tri_accel;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,sflags);
+      scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(-1,0,0),1.0f,50);
+      scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(+1,0,0),0.5f,50);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* packet traversal through quantized nodes has to match single ray traversal */
+      const size_t numRays = 1000;
+      RTCRayHit rays[numRays];
+      RTCRayHit refs[numRays];
+      for (size_t i=0; i<numRays; i++) {
+        Vec3fa org = Vec3fa(0,0,-4) + 0.5f*random_Vec3fa();
+        Vec3fa dir = Vec3fa(0,0,1) + Vec3fa(random_float()-0.5f,0.5f*random_float()-0.25f,0.0f);
+        rays[i] = refs[i] = makeRay(org,dir);
+        rtcIntersect1(scene,&refs[i]);
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,numRays);
+      AssertNoError(device);
+
+      for (size_t i=0; i<numRays; i++)
+      {
+        const bool hit = refs[i].hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        if (ivariant & VARIANT_INTERSECT) {
+          if (rays[i].hit.geomID != refs[i].hit.geomID) return VerifyApplication::FAILED;
+          if (hit && abs(rays[i].ray.tfar-refs[i].ray.tfar) > 1E-4f*refs[i].ray.tfar) return VerifyApplication::FAILED;
+        }
+        else if (hit != (rays[i].ray.tfar == float(neg_inf)))
+          return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TrianglePairIntersectTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    std::string tri_accel;
+
+    TrianglePairIntersectTest (std::string name, int isa, SceneFlags sflags, std::string tri_accel, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), tri_accel(tri_accel) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      std::string cfg1 = cfg + ",tri_accel="+tri_accel;
+      RTCDeviceRef device1 = rtcNewDevice(cfg1.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      /* the randomly resized sphere leaves some triangles without partner, and
+       * the shuffled sphere has no adjacent triangles next to each other */
+      VerifyScene scene(device,sflags);
+      Ref<SceneGraph::Node> node0 = scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(-1,0,0),1.0f,50).second;
+      Ref<SceneGraph::Node> node1 = scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(+1,0,0),0.5f,50,1001).second;
+      Ref<SceneGraph::Node> node2 = SceneGraph::createTriangleSphere(Vec3fa(0,0,-2),0.5f,50);
+      std::vector<SceneGraph::TriangleMeshNode::Triangle>& triangles2 = node2.dynamicCast<SceneGraph::TriangleMeshNode>()->triangles;
+      for (size_t i=triangles2.size(); i>1; i--)
+        std::swap(triangles2[i-1],triangles2[RandomSampler_getInt(sampler)%i]);
+      scene.addGeometry2(RTC_BUILD_QUALITY_MEDIUM,node2);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      VerifyScene scene1(device1,sflags);
+      scene1.addGeometry2(RTC_BUILD_QUALITY_MEDIUM,node0);
+      scene1.addGeometry2(RTC_BUILD_QUALITY_MEDIUM,node1);
+      scene1.addGeometry2(RTC_BUILD_QUALITY_MEDIUM,node2);
+      rtcCommitScene (scene1);
+      AssertNoError(device1);
+
+      /* hits on paired triangles have to report the primID and u/v of the original triangle */
+      const size_t numRays = 1000;
+      RTCRayHit rays[numRays];
+      RTCRayHit refs[numRays];
+      for (size_t i=0; i<numRays; i++) {
+        Vec3fa org = Vec3fa(0,0,-4) + 0.5f*random_Vec3fa();
+        Vec3fa dir = Vec3fa(0,0,1) + Vec3fa(random_float()-0.5f,0.5f*random_float()-0.25f,0.0f);
+        rays[i] = refs[i] = makeRay(org,dir);
+        rtcIntersect1(scene,&refs[i]);
+      }
+      IntersectWithMode(imode,ivariant,scene1,rays,numRays);
+      AssertNoError(device1);
+
+      for (size_t i=0; i<numRays; i++)
+      {
+        const bool hit = refs[i].hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        if (ivariant & VARIANT_INTERSECT) {
+          if (rays[i].hit.geomID != refs[i].hit.geomID) return VerifyApplication::FAILED;
+          if (!hit) continue;
+          if (rays[i].hit.primID != refs[i].hit.primID) return VerifyApplication::FAILED;
+          if (abs(rays[i].ray.tfar-refs[i].ray.tfar) > 1E-4f*refs[i].ray.tfar) return VerifyApplication::FAILED;
+          if (abs(rays[i].hit.u-refs[i].hit.u) > 1E-3f) return VerifyApplication::FAILED;
+          if (abs(rays[i].hit.v-refs[i].hit.v) > 1E-3f) return VerifyApplication::FAILED;
+        }
+        else if (hit != (rays[i].ray.tfar == float(neg_inf)))
+          return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct PointQueryAPICallsTest : public VerifyApplication::Test
   {
     SceneFlags sflags; 
@@ -5895,34 +7095,82 @@ namespace embree
     size_t numMeshes;
     bool update;
     bool dobenchmark; // true = measure build performance, false = measure memory consumption
+    bool instanced;   // true = two-level build over numMeshes instances of a single mesh
     size_t numPrimitives;
     RTCDeviceRef device;
     Ref<VerifyScene> scene;
+    Ref<VerifyScene> exemplar;
     std::vector<Ref<SceneGraph::Node>> geometries;
     
-    CreateGeometryBenchmark (std::string name, int isa, GeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, size_t numPhi, size_t numMeshes, bool update, bool dobenchmark)
+    CreateGeometryBenchmark (std::string name, int isa, GeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, size_t numPhi, size_t numMeshes, bool update, bool dobenchmark, bool instanced = false)
       : VerifyApplication::Benchmark(name,isa,dobenchmark ? "Mprims/s" : "MB",dobenchmark,dobenchmark?10:1), gtype(gtype), sflags(sflags), quality(quality), 
-        numPhi(numPhi), numMeshes(numMeshes), update(update), dobenchmark(dobenchmark),
-        numPrimitives(0), device(nullptr), scene(nullptr) {}
+        numPhi(numPhi), numMeshes(numMeshes), update(update), dobenchmark(dobenchmark), instanced(instanced),
+        numPrimitives(0), device(nullptr), scene(nullptr), exemplar(nullptr) {}
 
     size_t setNumPrimitives(size_t N) 
     { 
+      if (instanced) {
+        numMeshes = max(N,size_t(1));
+        return numMeshes;
+      }
       numPhi = (size_t) ceilf(sqrtf(N/4.0f));
       return 4*numPhi*numPhi;
     }
 
+    /* grids count as the number of quads the builder operates on */
+    static size_t numBuildPrimitives(const Ref<SceneGraph::Node>& node)
+    {
+      if (Ref<SceneGraph::GridMeshNode> mesh = node.dynamicCast<SceneGraph::GridMeshNode>()) {
+        size_t N = 0;
+        for (auto& grid : mesh->grids) N += size_t(grid.resX-1)*size_t(grid.resY-1);
+        return N;
+      }
+      return node->numPrimitives();
+    }
+
+    void create_instanced_scene()
+    {
+      scene = new VerifyScene(device,sflags);
+
+      RandomSampler sampler;
+      RandomSampler_init(sampler,0x4A3B2C1D);
+      for (size_t i=0; i<numMeshes; i++)
+      {
+        const Vec3fa axis = normalize(RandomSampler_get3D(sampler)+Vec3fa(0.01f));
+        const Vec3fa pos = 100.0f*RandomSampler_get3D(sampler);
+        const AffineSpace3fa xfm = AffineSpace3fa::translate(pos)*AffineSpace3fa::rotate(axis,2.0f*float(pi)*RandomSampler_getFloat(sampler));
+
+        RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(geom,*exemplar);
+        rtcSetGeometryBuildQuality(geom,quality);
+        rtcSetGeometryTransform(geom,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(*scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      AssertNoError(device);
+      numPrimitives = numMeshes;
+    }
+
     void create_scene()
     {
+      if (instanced) {
+        create_instanced_scene();
+        return;
+      }
+
       scene = new VerifyScene(device,sflags);
 
       numPrimitives = 0;
       for (size_t i=0; i<numMeshes; i++)
       {
-        numPrimitives += geometries[i]->numPrimitives();
+        numPrimitives += numBuildPrimitives(geometries[i]);
 
         switch (gtype) { 
         case TRIANGLE_MESH:    
         case QUAD_MESH:        
+        case GRID_MESH:
+        case SPHERE_GEOMETRY:
         case SUBDIV_MESH:      
         case BEZIER_GEOMETRY:
         case BSPLINE_GEOMETRY:
@@ -5930,11 +7178,13 @@ namespace embree
         case LINE_GEOMETRY:
         case TRIANGLE_MESH_MB: 
         case QUAD_MESH_MB:     
+        case GRID_MESH_MB:
         case SUBDIV_MESH_MB:   
         case BEZIER_GEOMETRY_MB:
         case BSPLINE_GEOMETRY_MB:
         case CATMULL_GEOMETRY_MB:
         case LINE_GEOMETRY_MB:
+        case SPHERE_GEOMETRY_MB:
           scene->addGeometry(quality,geometries[i]); 
           break;
         default: 
@@ -5957,13 +7207,18 @@ namespace embree
       rtcSetDeviceErrorFunction(device,errorHandler,nullptr);
       if (!dobenchmark) rtcSetDeviceMemoryMonitorFunction(device,memoryMonitor,nullptr);
 
-      for (unsigned int i=0; i<numMeshes; i++)
+      const size_t numGeometries = instanced ? 1 : numMeshes;
+      for (unsigned int i=0; i<numGeometries; i++)
       {
         switch (gtype) {
         case TRIANGLE_MESH:    
         case TRIANGLE_MESH_MB: geometries.push_back(SceneGraph::createTriangleSphere(zero,float(i+1),numPhi)); break;
         case QUAD_MESH:        
         case QUAD_MESH_MB:     geometries.push_back(SceneGraph::createQuadSphere(zero,float(i+1),numPhi)); break;
+        case GRID_MESH:
+        case GRID_MESH_MB:     geometries.push_back(SceneGraph::createGridSphere(zero,float(i+1),max(size_t(1),size_t(0.8165f*numPhi)))); break; // 6*N*N quads
+        case SPHERE_GEOMETRY:
+        case SPHERE_GEOMETRY_MB: geometries.push_back(SceneGraph::createPointSphere(zero,float(i+1),float(i+1)/100.0f,size_t(1.4142f*numPhi),SceneGraph::SPHERE)); break; // 4*numPhi*numPhi points
         case SUBDIV_MESH:      
         case SUBDIV_MESH_MB:   geometries.push_back(SceneGraph::createSubdivSphere(zero,float(i+1),8,float(numPhi)/8.0f)); break;
         case BEZIER_GEOMETRY:    
@@ -5986,15 +7241,25 @@ namespace embree
         switch (gtype) {
         case TRIANGLE_MESH_MB: 
         case QUAD_MESH_MB:     
+        case GRID_MESH_MB:
         case SUBDIV_MESH_MB:   
         case BEZIER_GEOMETRY_MB:
         case BSPLINE_GEOMETRY_MB:
         case CATMULL_GEOMETRY_MB:
-        case LINE_GEOMETRY_MB: geometries.back() = geometries.back()->set_motion_vector(random_motion_vector2(0.0001f)); break;
+        case LINE_GEOMETRY_MB:
+        case SPHERE_GEOMETRY_MB: geometries.back() = geometries.back()->set_motion_vector(random_motion_vector2(0.0001f)); break;
         default: break;
         }
       }
 
+      /* the instanced mesh is built once, only the top-level build is measured */
+      if (instanced) {
+        exemplar = new VerifyScene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+        exemplar->addGeometry(RTC_BUILD_QUALITY_MEDIUM,geometries[0]);
+        rtcCommitScene(*exemplar);
+        AssertNoError(device);
+      }
+
       if (update)
         create_scene();
 
@@ -6026,6 +7291,7 @@ namespace embree
     virtual void cleanup(VerifyApplication* state) 
     {
       scene = nullptr;
+      exemplar = nullptr;
       device = nullptr;
       geometries.clear();
     }
@@ -6043,7 +7309,7 @@ namespace embree
       tests(new TestGroup("",false,false)), 
       device(nullptr),
       user_specified_tests(false), flatten(true), parallel(true), cdash(false), 
-      database(""), update_database(false), benchmark_tolerance(0.05f),
+      database(""), update_database(false), benchmark_tolerance(0.05f), plot_range(0,0),
       usecolors(true)
   {
     rtcore = ""; // do not start threads nor set affinity for normal tests
@@ -6199,6 +7465,10 @@ namespace embree
       for (auto sflags : sceneFlagsDynamic) 
         groups.top()->add(new EnableDisableGeometryTest(to_string(sflags),isa,sflags));
       groups.pop();
+
+      groups.top()->add(new TessellationViewTest("tessellation_view",isa));
+      groups.top()->add(new DisplacementBoundTest("displacement_bound",isa));
+      groups.top()->add(new CurveSubsegmentsTest("curve_subsegments",isa));
       
       push(new TestGroup("disable_detach_geometry",true,true));
       for (auto sflags : sceneFlagsDynamic)
@@ -6260,6 +7530,8 @@ namespace embree
       push(new TestGroup("subdiv",true,true));
       for (auto s : interpolateTests)
         groups.top()->add(new InterpolateSubdivTest(std::to_string((long long)(s)),isa,s));
+      groups.top()->add(new TessellationCacheStatsTest("tessellation_cache_stats",isa));
+      groups.top()->add(new InterpolateNSubdivTest("interpolateN",isa));
       groups.pop();
         
       push(new TestGroup("hair",true,true));
@@ -6312,6 +7584,15 @@ namespace embree
         groups.pop();
       }
 
+      push(new TestGroup("backface_culling_flag",true,true));
+      for (auto gtype : { TRIANGLE_MESH, QUAD_MESH })
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new BackfaceCullingFlagTest(to_string(gtype,sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,gtype,imode,ivariant));
+      groups.pop();
+
       if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED))
       {
         push(new TestGroup("intersection_filter",true,true));
@@ -6333,6 +7614,58 @@ namespace embree
         groups.pop();
       }
 
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED) &&
+          rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_RAY_MASK_SUPPORTED))
+      {
+        push(new TestGroup("feature_mask",true,true));
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new FeatureMaskTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+        groups.pop();
+      }
+
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED))
+      {
+        push(new TestGroup("scene_statistics",true,true));
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new SceneStatisticsTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+        groups.pop();
+      }
+
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED))
+      {
+        push(new TestGroup("ignore_primitive",true,true));
+        for (auto gtype : { TRIANGLE_MESH, QUAD_MESH, GRID_MESH })
+          for (bool instanced : { false, true })
+            for (auto imode : intersectModes)
+              groups.top()->add(new IgnorePrimitiveTest(to_string(gtype)+(instanced ? ".instanced." : ".")+to_string(imode),isa,gtype,instanced,imode));
+        groups.pop();
+      }
+
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED))
+      {
+        push(new TestGroup("multi_hit",true,true));
+        for (auto quality : { RTC_BUILD_QUALITY_MEDIUM, RTC_BUILD_QUALITY_HIGH })
+          for (unsigned int maxHits : { 1, 4, 16 })
+            groups.top()->add(new MultiHitTest(to_string(quality)+".max"+std::to_string(maxHits),isa,quality,maxHits));
+        groups.pop();
+      }
+
+      push(new TestGroup("deferred_scene",true,true));
+      groups.top()->add(new DeferredSceneTest("serial",isa,false));
+      groups.top()->add(new DeferredSceneTest("parallel",isa,true));
+      groups.pop();
+
+      push(new TestGroup("scene_build_statistics",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new SceneBuildStatisticsTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
       push(new TestGroup("instancing",true,true));
         for (auto& sflags : sceneFlags) 
           for (auto imode : intersectModes) 
@@ -6344,6 +7677,11 @@ namespace embree
             for (auto ivariant : intersectVariants)
               if (has_variant(imode,ivariant)) 
                 groups.top()->add(new InstancingTest("instancing."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,true,imode,ivariant));
+        for (auto imode : intersectModes)
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+              for (unsigned int numTimeSteps : {1,2,3})
+                groups.top()->add(new InstanceOriginTest("instance_origin."+to_string(SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),imode,ivariant)+(numTimeSteps > 1 ? "_mb"+std::to_string(numTimeSteps) : ""),isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),numTimeSteps,imode,ivariant));
       groups.pop();
 
   #if defined(EMBREE_GEOMETRY_INSTANCE_ARRAY)
@@ -6477,6 +7815,38 @@ namespace embree
         groups.pop();
       }
       
+      push(new TestGroup("quantized_node_intersect",true,true));
+      {
+        std::vector<std::string> accels = { "qbvh4.triangle4", "qbvh4.triangle4i" };
+        if (stringOfISA(isa) == "AVX" || stringOfISA(isa) == "AVX2")
+          accels = { "qbvh8.triangle4", "qbvh8.triangle4i" };
+        const SceneFlags sflags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+        for (auto& accel : accels)
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new QuantizedNodeIntersectTest(accel+"."+to_string(sflags,imode,ivariant),isa,sflags,accel,imode,ivariant));
+      }
+      groups.pop();
+
+      push(new TestGroup("triangle_pairs",true,true));
+      {
+        const SceneFlags sflags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+        for (std::string accel : { "bvh4.triangle_pairs4v", "qbvh4.triangle_pairs4v" })
+        {
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new TrianglePairIntersectTest(accel+"."+to_string(sflags,imode,ivariant),isa,sflags,accel,imode,ivariant));
+
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new BackfaceCullingFlagTest(accel+".cull."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,TRIANGLE_MESH,imode,ivariant,accel));
+        }
+      }
+      groups.pop();
+
       /**************************************************************************/
       /*                      Point Query Tests                                */
       /**************************************************************************/
@@ -6487,7 +7857,9 @@ namespace embree
         if (stringOfISA(isa) == "SSE4.1" || stringOfISA(isa) == "SSE4.2") {
           groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"bvh4.triangle4v"));
           groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"bvh4.triangle4i"));
+          groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"qbvh4.triangle4"));
           groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"qbvh4.triangle4i"));
+          groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"bvh4.triangle_pairs4v"));
         }
         if (stringOfISA(isa) == "AVX" || stringOfISA(isa) == "AVX2") {
           groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"bvh8.triangle4v"));
@@ -6591,12 +7963,15 @@ namespace embree
       std::vector<std::pair<SceneFlags,RTCBuildQuality>> benchmark_create_sflags_quality;
       benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
       benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_LOW));
+      benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_HIGH),RTC_BUILD_QUALITY_HIGH));
 
       GeometryType benchmark_create_gtypes[] = { 
         TRIANGLE_MESH, 
         TRIANGLE_MESH_MB, 
         QUAD_MESH, 
         QUAD_MESH_MB, 
+        GRID_MESH,
+        GRID_MESH_MB,
         BEZIER_GEOMETRY,
         BEZIER_GEOMETRY_MB,
         BSPLINE_GEOMETRY,
@@ -6604,7 +7979,9 @@ namespace embree
         CATMULL_GEOMETRY,
         CATMULL_GEOMETRY_MB,
         LINE_GEOMETRY,
-        LINE_GEOMETRY_MB
+        LINE_GEOMETRY_MB,
+        SPHERE_GEOMETRY,
+        SPHERE_GEOMETRY_MB
       };
 
       std::vector<std::tuple<const char*,int,int>> num_primitives;
@@ -6613,16 +7990,24 @@ namespace embree
       num_primitives.push_back(std::make_tuple("10k",51,1));
       num_primitives.push_back(std::make_tuple("100k",159,1));
       num_primitives.push_back(std::make_tuple("10000k_1",801,1));
+      num_primitives.push_back(std::make_tuple("100000k_1",5001,1));
       num_primitives.push_back(std::make_tuple("1000k_1",501,1));
       num_primitives.push_back(std::make_tuple("100k_10",159,10));
       num_primitives.push_back(std::make_tuple("10k_100",51,100));
       num_primitives.push_back(std::make_tuple("1k_1000",17,1000));
 
+      /* the 100M primitive mesh is only built for triangles and quads at medium quality, to bound time and memory of the benchmarks */
+      auto benchmark_num_prims = [] (GeometryType gtype, const std::pair<SceneFlags,RTCBuildQuality>& sflags, const std::tuple<const char*,int,int>& num_prims) {
+        if (std::get<1>(num_prims) <= 1000) return true;
+        return (gtype == TRIANGLE_MESH || gtype == QUAD_MESH) && sflags.second == RTC_BUILD_QUALITY_MEDIUM;
+      };
+
       for (auto gtype : benchmark_create_gtypes)
         for (auto sflags : benchmark_create_sflags_quality)
           for (auto num_prims : num_primitives)
-            groups.top()->add(new CreateGeometryBenchmark("create."+to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(sflags.first,sflags.second),
-                                                          isa,gtype,sflags.first,sflags.second,std::get<1>(num_prims),std::get<2>(num_prims),false,true));
+            if (benchmark_num_prims(gtype,sflags,num_prims))
+              groups.top()->add(new CreateGeometryBenchmark("create."+to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(sflags.first,sflags.second),
+                                                            isa,gtype,sflags.first,sflags.second,std::get<1>(num_prims),std::get<2>(num_prims),false,true));
 
       std::vector<std::pair<SceneFlags,RTCBuildQuality>> benchmark_update_sflags_quality;
       benchmark_update_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_MEDIUM));
@@ -6632,8 +8017,26 @@ namespace embree
       for (auto gtype : benchmark_create_gtypes)
         for (auto sflags : benchmark_update_sflags_quality)
           for (auto& num_prims : num_primitives)
-            groups.top()->add(new CreateGeometryBenchmark("update."+to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(sflags.first,sflags.second),
-                                                          isa,gtype,sflags.first,sflags.second,std::get<1>(num_prims),std::get<2>(num_prims),true,true));
+            if (benchmark_num_prims(gtype,sflags,num_prims))
+              groups.top()->add(new CreateGeometryBenchmark("update."+to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(sflags.first,sflags.second),
+                                                            isa,gtype,sflags.first,sflags.second,std::get<1>(num_prims),std::get<2>(num_prims),true,true));
+
+      /* two-level builds over many instances of a 1k triangle mesh */
+      std::vector<std::pair<const char*,int>> num_instances;
+      num_instances.push_back(std::make_pair("1k",1000));
+      num_instances.push_back(std::make_pair("10k",10000));
+      num_instances.push_back(std::make_pair("100k",100000));
+      num_instances.push_back(std::make_pair("1000k",1000000));
+
+      for (auto sflags : benchmark_create_sflags_quality)
+        for (auto& num_inst : num_instances)
+          groups.top()->add(new CreateGeometryBenchmark("create.instances_"+std::string(num_inst.first)+"."+to_string(sflags.first,sflags.second),
+                                                        isa,TRIANGLE_MESH,sflags.first,sflags.second,17,num_inst.second,false,true,true));
+
+      for (auto sflags : benchmark_update_sflags_quality)
+        for (auto& num_inst : num_instances)
+          groups.top()->add(new CreateGeometryBenchmark("update.instances_"+std::string(num_inst.first)+"."+to_string(sflags.first,sflags.second),
+                                                        isa,TRIANGLE_MESH,sflags.first,sflags.second,17,num_inst.second,true,true,true));
 
       groups.pop(); // benchmarks
 
@@ -6646,8 +8049,9 @@ namespace embree
       for (auto gtype : benchmark_create_gtypes)
         for (auto sflags : benchmark_create_sflags_quality)
           for (auto& num_prims : num_primitives)
-            groups.top()->add(new CreateGeometryBenchmark(to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(sflags.first,sflags.second),
-                                                          isa,gtype,sflags.first,sflags.second,std::get<1>(num_prims),std::get<2>(num_prims),false,false));
+            if (benchmark_num_prims(gtype,sflags,num_prims))
+              groups.top()->add(new CreateGeometryBenchmark(to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(sflags.first,sflags.second),
+                                                            isa,gtype,sflags.first,sflags.second,std::get<1>(num_prims),std::get<2>(num_prims),false,false));
 
       groups.pop(); // embree_reported_memory
 
@@ -6739,6 +8143,16 @@ namespace embree
       }, "--benchmark-tolerance: maximum relative slowdown to let a test pass");
     registerOptionAlias("benchmark-tolerance","tolerance");
 
+    registerOption("benchmark-json", [this] (Ref<ParseStream> cin, const FileName& path) {
+        benchmark_json = cin->getFileName();
+      }, "--benchmark-json <filename>: writes the samples and statistics of all benchmarks to a JSON file");
+
+    registerOption("benchmark-compare", [this] (Ref<ParseStream> cin, const FileName& path) {
+        FileName baseFileName = cin->getFileName();
+        FileName newFileName = cin->getFileName();
+        exit(BenchResults::compare(baseFileName,newFileName,benchmark_tolerance,0.05f) ? 1 : 0);
+      }, "--benchmark-compare <base.json> <new.json>: reports statistically significant regressions of more than the benchmark tolerance between two JSON files");
+
     registerOption("print-tests", [this] (Ref<ParseStream> cin, const FileName& path) {
         print_tests(tests,0);
         exit(1);
@@ -6754,10 +8168,17 @@ namespace embree
         intensity = cin->getFloat();
       }, "--intensity <float>: intensity of testing to perform");
 
+    registerOption("plot-range", [this] (Ref<ParseStream> cin, const FileName& path) {
+        plot_range.first = cin->getInt();
+        plot_range.second = cin->getInt();
+      }, "--plot-range <start> <end>: range of primitive or thread counts of the following --plot-over-primitives or --plot-over-threads option");
+
     registerOption("plot-over-primitives", [this] (Ref<ParseStream> cin, const FileName& path) {
         std::vector<Ref<Benchmark>> benchmarks;
         FileName outFileName = parse_benchmark_list(cin,benchmarks);
-        plot(benchmarks,outFileName,"#primitives",1000,1100000,1.2f,0,[&] (Ref<Benchmark> benchmark, size_t& N) {
+        const size_t startN = plot_range.first  ? plot_range.first  : 1000;
+        const size_t endN   = plot_range.second ? plot_range.second : 1100000;
+        plot(benchmarks,outFileName,"#primitives",startN,endN,1.2f,0,[&] (Ref<Benchmark> benchmark, size_t& N) {
             N = benchmark->setNumPrimitives(N);
             benchmark->setup(this);
             Statistics stat = benchmark->benchmark_loop(this);
@@ -6770,7 +8191,9 @@ namespace embree
     registerOption("plot-over-threads", [this] (Ref<ParseStream> cin, const FileName& path) {
         std::vector<Ref<Benchmark>> benchmarks;
         FileName outFileName = parse_benchmark_list(cin,benchmarks);
-        plot(benchmarks,outFileName,"#threads",2,getNumberOfLogicalThreads(),1.0f,2,[&] (Ref<Benchmark> benchmark, size_t N) {
+        const size_t startN = plot_range.first  ? plot_range.first  : 2;
+        const size_t endN   = plot_range.second ? plot_range.second : getNumberOfLogicalThreads();
+        plot(benchmarks,outFileName,"#threads",startN,endN,1.0f,startN == 1 ? 1 : 2,[&] (Ref<Benchmark> benchmark, size_t N) {
             benchmark->setNumThreads(N);
             benchmark->setup(this);
             Statistics stat = benchmark->benchmark_loop(this);
@@ -6778,7 +8201,7 @@ namespace embree
             return stat;
           });
         exit(1);
-      }, "--plot-over-primitives <benchmark0> <benchmark1> ... <outfile>: Plots performance over number of primitives to outfile for the specified benchmarks.");
+      }, "--plot-over-threads <benchmark0> <benchmark1> ... <outfile>: Plots performance over number of threads to outfile for the specified benchmarks.");
 
     /* the internal tasking system need the device to be present to allow parallel test execution */
 #if !defined(TASKING_INTERNAL)
@@ -6936,6 +8359,12 @@ namespace embree
     /* run all enabled tests */
     tests->execute(this,false);
 
+    if (benchmark_json.str() != "") {
+      std::string commandLine;
+      for (int i=0; i<argc; i++) commandLine += std::string(i ? " " : "") + argv[i];
+      BenchResults::write(benchmark_json,commandLine);
+    }
+
     /* print result */
     std::cout << std::endl;
     std::cout << std::setw(TEXT_ALIGN) << "Tests passed" << ": " << numPassedTests << std::endl; 
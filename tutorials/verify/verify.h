@@ -14,6 +14,7 @@ RTC_NAMESPACE_USE
 #include "../common/tutorial/application.h"
 #include "../common/math/random_sampler.h"
 #include "../common/tutorial/statistics.h"
+#include "../common/tutorial/benchmark.h"
 
 namespace embree
 {
@@ -83,7 +84,7 @@ namespace embree
       }
       virtual bool setup(VerifyApplication* state) { return true; }
       virtual float benchmark(VerifyApplication* state) = 0;
-      Statistics benchmark_loop(VerifyApplication* state);
+      Statistics benchmark_loop(VerifyApplication* state, SampleStatistics* samples = nullptr);
       virtual void cleanup(VerifyApplication* state) {}
       virtual TestReturnValue execute(VerifyApplication* state, bool silent);
       double readDatabase(VerifyApplication* state);
@@ -171,6 +172,8 @@ namespace embree
     FileName database;
     bool update_database;
     float benchmark_tolerance;
+    FileName benchmark_json;
+    std::pair<size_t,size_t> plot_range;
 
     /* sets terminal colors */
   public:
@@ -5,6 +5,8 @@
 #include "../common/tutorial/tutorial_device.h"
 #include "../common/tutorial/benchmark_render.h"
 
+#include <fstream>
+
 #if defined(EMBREE_SYCL_TUTORIAL)
 #  define NAME "viewer_sycl"
 #  define FEATURES FEATURE_RTCORE | FEATURE_SYCL
@@ -22,6 +24,8 @@ namespace embree
   extern "C" float scale;
   extern "C" bool g_changed;
   extern "C" Shader shader = SHADER_DEFAULT;
+  extern "C" RTCSceneStatistics* g_cost_map = nullptr;
+  extern "C" unsigned int g_cost_map_width = 0;
 
   typedef void (* renderFrameFunc)(int* pixels, const unsigned int width, const unsigned int height, const float time, const ISPCCamera& camera);
   extern renderFrameFunc renderFrame;
@@ -55,6 +59,7 @@ namespace embree
         else if (mode == "geomID"  ) shader = SHADER_GEOMID;
         else if (mode == "primID"  ) shader = SHADER_GEOMID_PRIMID;
         else if (mode == "ao" ) shader = SHADER_AO;
+        else if (mode == "cost"    ) { shader = SHADER_COST; scale = cin->getFloat(); }
         else throw std::runtime_error("invalid shader:" +mode);
       },
       "--shader <string>: sets shader to use at startup\n"
@@ -67,9 +72,15 @@ namespace embree
       "  Ng: visualization of shading normal\n"
       "  cycles <float>: CPU cycle visualization\n"
       "  ao: ambient occlusion\n"      
+      "  cost <float>: heat map of traversed nodes and leaves per ray, scaled by the float\n"
       "  geomID: visualization of geometry ID\n"
       "  primID: visualization of geometry and primitive ID");
 
+      registerOption("cost-map", [this] (Ref<ParseStream> cin, const FileName& path) {
+          cost_map_filename = cin->getFileName();
+          if (shader == SHADER_DEFAULT) shader = SHADER_COST;
+        }, "--cost-map <filename>: stores the traversed nodes, leaves, and filter calls per pixel of the first rendered frame to a .csv file or a float image (e.g. .exr or .pfm), implies the cost shader if no other debug shader is selected");
+
 #if defined(EMBREE_SYCL_TUTORIAL) && !defined(EMBREE_SYCL_RT_SIMULATION)
       registerOption("features", [] (Ref<ParseStream> cin, const FileName& path) {
           g_use_scene_features = false;
@@ -184,6 +195,53 @@ namespace embree
     }
 #endif
     
+    void render(unsigned* pixels, const unsigned width, const unsigned height, const float time, const ISPCCamera& camera) override
+    {
+      if (cost_map_filename.str() == "") {
+        TutorialApplication::render(pixels,width,height,time,camera);
+        return;
+      }
+
+      /* record the traversal statistics of each pixel for this frame */
+      std::vector<RTCSceneStatistics> cost_map(size_t(width)*size_t(height));
+      g_cost_map = cost_map.data();
+      g_cost_map_width = width;
+      TutorialApplication::render(pixels,width,height,time,camera);
+      g_cost_map = nullptr;
+      g_cost_map_width = 0;
+
+      storeCostMap(cost_map,width,height);
+      cost_map_filename = "";
+    }
+
+    void storeCostMap(const std::vector<RTCSceneStatistics>& cost_map, const unsigned width, const unsigned height)
+    {
+      if (cost_map_filename.ext() == "csv" || cost_map_filename.ext() == "CSV")
+      {
+        std::ofstream file(cost_map_filename.str());
+        if (!file.is_open()) throw std::runtime_error("cannot open file " + cost_map_filename.str());
+        file << "x,y,rays,nodes,leaves,filter_calls" << std::endl;
+        for (unsigned y=0; y<height; y++) {
+          for (unsigned x=0; x<width; x++) {
+            const RTCSceneStatistics& c = cost_map[y*width+x];
+            file << x << "," << y << "," << c.numRays << "," << c.numNodes << "," << c.numLeaves << "," << c.numFilterCalls << std::endl;
+          }
+        }
+      }
+      else
+      {
+        /* nodes, leaves, and filter calls go into the color channels, rays into alpha */
+        Ref<Image> image = new Image4f(width,height);
+        for (unsigned y=0; y<height; y++) {
+          for (unsigned x=0; x<width; x++) {
+            const RTCSceneStatistics& c = cost_map[y*width+x];
+            image->set(x,y,Color4(float(c.numNodes),float(c.numLeaves),float(c.numFilterCalls),float(c.numRays)));
+          }
+        }
+        storeImage(image,cost_map_filename);
+      }
+    }
+
     void postParseCommandLine() override
     {
       /* set shader mode */
@@ -199,6 +257,7 @@ namespace embree
       case SHADER_GEOMID   : renderFrame = renderFrameDebugShader; break;
       case SHADER_GEOMID_PRIMID: renderFrame = renderFrameDebugShader; break;
       case SHADER_AO: renderFrame = renderFrameAOShader; break;      
+      case SHADER_COST     : renderFrame = renderFrameDebugShader; break;
       };
       
       /* load default scene if none specified */
@@ -207,6 +266,9 @@ namespace embree
         parseCommandLine(new ParseStream(new LineCommentFilter(file, "#")), file.path());
       }
     }
+
+  private:
+    FileName cost_map_filename;
   };
 }
 
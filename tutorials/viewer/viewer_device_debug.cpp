@@ -24,6 +24,10 @@ static const sycl::specialization_id<RTCFeatureFlags> spec_feature_mask;
 
 extern "C" RTCFeatureFlags g_feature_mask;
 
+/* per pixel traversal statistics of the cost shader, optional */
+extern "C" RTCSceneStatistics* g_cost_map;
+extern "C" unsigned int g_cost_map_width;
+
 struct DebugShaderData
 {
   RTCScene scene;
@@ -35,6 +39,10 @@ struct DebugShaderData
   float debug;
 
   Shader shader;
+
+  /* per pixel traversal statistics of the cost shader */
+  RTCSceneStatistics* cost_map;
+  unsigned int cost_map_width;
 };
 
 void DebugShaderData_Constructor(DebugShaderData* This)
@@ -44,6 +52,12 @@ void DebugShaderData_Constructor(DebugShaderData* This)
   This->scale = scale;
   This->debug = g_debug;
   This->shader = shader;
+#if defined(EMBREE_SYCL_TUTORIAL) && !defined(EMBREE_SYCL_RT_SIMULATION)
+  This->cost_map = nullptr;
+#else
+  This->cost_map = g_cost_map;
+#endif
+  This->cost_map_width = g_cost_map_width;
 }
 
 #define RENDER_FRAME_FUNCTION_ISPC(Name)                             \
@@ -208,6 +222,14 @@ Vec3fa randomColor(const int ID)
   return Vec3fa(r*oneOver255f,g*oneOver255f,b*oneOver255f);
 }
 
+/* maps a cost in the range [0,1] to a blue-green-red heat map */
+Vec3fa heatMapColor(float t)
+{
+  t = clamp(t,0.0f,1.0f);
+  if (t < 0.5f) return Vec3fa(0.0f,2.0f*t,1.0f-2.0f*t);
+  else          return Vec3fa(2.0f*t-1.0f,2.0f-2.0f*t,0.0f);
+}
+
 /* renders a single pixel with eyelight shading */
 Vec3fa renderPixelDebugShader(const DebugShaderData& data, float x, float y, const ISPCCamera& camera, RayStats& stats, const RTCFeatureFlags feature_mask)
 {
@@ -222,6 +244,10 @@ Vec3fa renderPixelDebugShader(const DebugShaderData& data, float x, float y, con
   ray.mask = -1;
   ray.time() = data.debug;
 
+  /* traversal statistics of this ray for the cost shader */
+  RTCSceneStatistics cost = { 0, 0, 0, 0 };
+  RTCSceneStatistics* query_stats = (data.shader == SHADER_COST || data.cost_map) ? &cost : nullptr;
+
   /* intersect ray with scene */
   int64_t c0 = get_tsc();
   if (data.shader == SHADER_OCCLUSION)
@@ -229,6 +255,7 @@ Vec3fa renderPixelDebugShader(const DebugShaderData& data, float x, float y, con
     RTCOccludedArguments args;
     rtcInitOccludedArguments(&args);
     args.feature_mask = feature_mask;
+    args.stats = query_stats;
     rtcOccluded1(data.scene,RTCRay_(ray),&args);
   }
   else
@@ -236,12 +263,16 @@ Vec3fa renderPixelDebugShader(const DebugShaderData& data, float x, float y, con
     RTCIntersectArguments args;
     rtcInitIntersectArguments(&args);
     args.feature_mask = feature_mask;
+    args.stats = query_stats;
     rtcIntersect1(data.scene,RTCRayHit_(ray),&args);
   }
   
   int64_t c1 = get_tsc();
   RayStats_addRay(stats);
 
+  if (data.cost_map)
+    data.cost_map[(unsigned int)y*data.cost_map_width+(unsigned int)x] = cost;
+
   /* shade pixel */
   switch (data.shader)
   {
@@ -305,6 +336,9 @@ Vec3fa renderPixelDebugShader(const DebugShaderData& data, float x, float y, con
   case SHADER_CYCLES:
     return Vec3fa((float)(c1-c0)*data.scale,0.0f,0.0f);
     
+  case SHADER_COST:
+    return heatMapColor((float)(cost.numNodes+cost.numLeaves)*data.scale);
+    
   case SHADER_AO:
     return Vec3fa(0,0,0);
 